@@ -32,7 +32,7 @@ ExportResult TypeBinaryExporter::Export(std::ostream &write, std::shared_ptr<IPa
 
 }
 
-std::optional<std::shared_ptr<IParsedData>> TypeFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> TypeFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto [root, segment] = Decompressor::AutoDecode(node, buffer, 0x1000);
     LUS::BinaryReader reader(segment.data, segment.size);
     reader.SetEndianness(Torch::Endianness::Big);
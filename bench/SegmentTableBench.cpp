@@ -0,0 +1,88 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "Companion.h"
+
+// Times GetFileOffsetFromSegmentedAddr through the per context SegmentTable against probing the
+// temporal, local and global segment maps on every call like it used to. The churn run marks the
+// table stale every few lookups, the way a display list setting temporal segments would.
+
+#define LOOKUPS (1 << 22)
+#define CHURN_INTERVAL 64
+
+static uint32_t sSeed = 0x64;
+
+static uint32_t NextRandom() {
+    sSeed = sSeed * 1103515245 + 12345;
+    return sSeed >> 16;
+}
+
+static std::optional<uint32_t> MapLookup(FileContext& ctx, const SegmentConfig& config, const uint8_t segment) {
+    if(ctx.temporalSegments.contains(segment)) {
+        return ctx.temporalSegments[segment];
+    }
+
+    if(ctx.localSegments.contains(segment)) {
+        return ctx.localSegments[segment];
+    }
+
+    if(config.global.contains(segment)) {
+        return config.global.at(segment);
+    }
+
+    return std::nullopt;
+}
+
+template<typename F>
+static double Time(const std::vector<uint8_t>& segments, const size_t churn, F&& lookup, uint64_t& sum) {
+    auto& ctx = Companion::GetCurrentContext();
+    sum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < segments.size(); i++) {
+        if(churn != 0 && i % churn == 0) {
+            ctx.segmentTable.generation = 0;
+        }
+        const auto offset = lookup(segments[i]);
+        sum += offset.has_value() ? offset.value() : 1;
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool Compare(const char* name, const std::vector<uint8_t>& segments, const size_t churn) {
+    auto& ctx = Companion::GetCurrentContext();
+    const auto& config = Companion::Instance->GetConfig().segment;
+
+    uint64_t expected;
+    uint64_t actual;
+    const auto mapTime = Time(segments, churn, [&](uint8_t segment) { return MapLookup(ctx, config, segment); }, expected);
+    const auto tableTime = Time(segments, churn, [&](uint8_t segment) { return Companion::Instance->GetFileOffsetFromSegmentedAddr(segment); }, actual);
+    const auto same = expected == actual;
+    printf("%-8s maps %8.2f ms  table %8.2f ms  %5.2fx  %s\n", name, mapTime, tableTime, mapTime / tableTime, same ? "same" : "DIFFERENT");
+    return same;
+}
+
+int main() {
+    Companion::Instance = new Companion(std::vector<uint8_t>(), ArchiveType::None, false, false);
+
+    auto& config = Companion::Instance->GetConfig().segment;
+    for(uint32_t id = 1; id <= 0xE; id++) {
+        config.global[id] = id * 0x100000;
+    }
+    config.generation++;
+
+    auto& ctx = Companion::GetCurrentContext();
+    ctx.localSegments[0x4] = 0x123450;
+    ctx.localSegments[0x7] = 0x234560;
+    ctx.temporalSegments[0x8] = 0x345670;
+
+    // Mostly mapped segments, 0x0 and 0xF are left unset
+    std::vector<uint8_t> segments(LOOKUPS);
+    for(auto& segment : segments) {
+        segment = NextRandom() & 0xF;
+    }
+
+    bool same = true;
+    same &= Compare("steady", segments, 0);
+    same &= Compare("churn", segments, CHURN_INTERVAL);
+    return same ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include "utils/TextWriter.h"
+
+// Times the exporter formatting through Torch::TextWriter against the iostream code it replaced,
+// both sides write the same text so a mismatch means the writer changed the generated output.
+
+#define DATA_SIZE (1024 * 1024)
+#define VTX_COUNT (64 * 1024)
+#define ROUNDS 10
+
+struct Vtx {
+    int16_t ob[3];
+    uint16_t flag;
+    int16_t tc[2];
+    uint8_t cn[4];
+};
+
+static uint32_t sSeed = 0x64;
+
+static uint8_t NextByte() {
+    sSeed = sSeed * 1103515245 + 12345;
+    return sSeed >> 16;
+}
+
+template<typename F>
+static double Time(F&& run, std::string& output) {
+    const auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < ROUNDS; i++) {
+        output = run();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / ROUNDS;
+}
+
+template<typename A, typename B>
+static bool Compare(const char* name, A&& stream, B&& writer) {
+    std::string expected;
+    std::string actual;
+    const auto streamTime = Time(stream, expected);
+    const auto writerTime = Time(writer, actual);
+    const auto same = expected == actual;
+    printf("%-10s ostream %8.2f ms  TextWriter %8.2f ms  %5.2fx  %s\n", name, streamTime, writerTime, streamTime / writerTime, same ? "same" : "DIFFERENT");
+    return same;
+}
+
+// TextureCodeExporter, 16 bit texels
+static std::string TextureStream(const std::vector<uint8_t>& data) {
+    std::ostringstream out;
+    for(size_t i = 0; i < data.size(); i += 2) {
+        if(i % 16 == 0 && i != 0) {
+            out << std::endl;
+        }
+        out << "0x";
+        for(size_t j = 0; j < 2; j++) {
+            out << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(data[i + j]);
+        }
+        out << ", ";
+    }
+    out << std::endl;
+    return out.str();
+}
+
+static std::string TextureWriter(const std::vector<uint8_t>& data) {
+    Torch::TextWriter text;
+    text.HexArray(data, 2, 16, "\n") << '\n';
+    return text.str();
+}
+
+// BlobCodeExporter
+static std::string BlobStream(const std::vector<uint8_t>& data) {
+    std::ostringstream out;
+    for(size_t i = 0; i < data.size(); i++) {
+        if(i % 15 == 0 && i != 0) {
+            out << "\n    ";
+        }
+        out << "0x" << std::hex << std::setw(2) << std::setfill('0') << (int) data[i] << ", ";
+    }
+    out << "\n};\n";
+    return out.str();
+}
+
+static std::string BlobWriter(const std::vector<uint8_t>& data) {
+    Torch::TextWriter text;
+    text.HexArray(data, 1, 15, "\n    ") << "\n};\n";
+    return text.str();
+}
+
+#define NUM(x) std::dec << std::setfill(' ') << std::setw(6) << x
+#define COL(c) std::dec << std::setfill(' ') << std::setw(3) << c
+
+// VtxCodeExporter
+static std::string VtxStream(const std::vector<Vtx>& vtxs) {
+    std::ostringstream out;
+    for(const auto& v : vtxs) {
+        out << "{{{" << NUM(v.ob[0]) << ", " << NUM(v.ob[1]) << ", " << NUM(v.ob[2]) << "}, " << std::dec << v.flag << ", {";
+        out << NUM(v.tc[0]) << ", " << NUM(v.tc[1]) << "}, {";
+        out << COL((uint16_t) v.cn[0]) << ", " << COL((uint16_t) v.cn[1]) << ", " << COL((uint16_t) v.cn[2]) << ", " << COL((uint16_t) v.cn[3]) << "}}},\n";
+    }
+    return out.str();
+}
+
+static std::string VtxWriter(const std::vector<Vtx>& vtxs) {
+    Torch::TextWriter text;
+    for(const auto& v : vtxs) {
+        text << "{{{";
+        text.Dec(v.ob[0], 6) << ", ";
+        text.Dec(v.ob[1], 6) << ", ";
+        text.Dec(v.ob[2], 6) << "}, ";
+        text.Dec(v.flag) << ", {";
+        text.Dec(v.tc[0], 6) << ", ";
+        text.Dec(v.tc[1], 6) << "}, {";
+        text.Dec(v.cn[0], 3) << ", ";
+        text.Dec(v.cn[1], 3) << ", ";
+        text.Dec(v.cn[2], 3) << ", ";
+        text.Dec(v.cn[3], 3) << "}}},\n";
+    }
+    return text.str();
+}
+
+int main() {
+    std::vector<uint8_t> data(DATA_SIZE);
+    for(auto& byte : data) {
+        byte = NextByte();
+    }
+
+    std::vector<Vtx> vtxs(VTX_COUNT);
+    for(auto& v : vtxs) {
+        auto bytes = reinterpret_cast<uint8_t*>(&v);
+        for(size_t i = 0; i < sizeof(Vtx); i++) {
+            bytes[i] = NextByte();
+        }
+    }
+
+    bool same = true;
+    same &= Compare("texture", [&] { return TextureStream(data); }, [&] { return TextureWriter(data); });
+    same &= Compare("blob", [&] { return BlobStream(data); }, [&] { return BlobWriter(data); });
+    same &= Compare("vtx", [&] { return VtxStream(vtxs); }, [&] { return VtxWriter(vtxs); });
+    return same ? 0 : 1;
+}
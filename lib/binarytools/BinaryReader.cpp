@@ -1,15 +1,15 @@
 #include "./BinaryReader.h"
-#include "./MemoryStream.h"
+#include "./ConstMemoryView.h"
 #include <cmath>
 #include <stdexcept>
 #include <locale>
 
-LUS::BinaryReader::BinaryReader(char* nBuffer, size_t nBufferSize) {
-    mStream = std::make_shared<MemoryStream>(nBuffer, nBufferSize);
+LUS::BinaryReader::BinaryReader(const char* nBuffer, size_t nBufferSize) {
+    mStream = std::make_shared<ConstMemoryView>(nBuffer, nBufferSize);
 }
 
-LUS::BinaryReader::BinaryReader(uint8_t* nBuffer, size_t nBufferSize) {
-    mStream = std::make_shared<MemoryStream>((char*) nBuffer, nBufferSize);
+LUS::BinaryReader::BinaryReader(const uint8_t* nBuffer, size_t nBufferSize) {
+    mStream = std::make_shared<ConstMemoryView>((const char*) nBuffer, nBufferSize);
 }
 
 LUS::BinaryReader::BinaryReader(Stream* nStream) {
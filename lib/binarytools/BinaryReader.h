@@ -12,8 +12,9 @@ namespace LUS {
 
 class BinaryReader {
   public:
-    BinaryReader(char* nBuffer, size_t nBufferSize);
-    BinaryReader(uint8_t* nBuffer, size_t nBufferSize);
+    // Reads straight from the given memory without copying it, the buffer must outlive the reader
+    BinaryReader(const char* nBuffer, size_t nBufferSize);
+    BinaryReader(const uint8_t* nBuffer, size_t nBufferSize);
     BinaryReader(Stream* nStream);
     BinaryReader(std::shared_ptr<Stream> nStream);
 
@@ -1,5 +1,6 @@
 #include "./BinaryWriter.h"
 #include "./MemoryStream.h"
+#include "./VectorOutputStream.h"
 #include <iostream>
 
 LUS::BinaryWriter::BinaryWriter() {
@@ -155,7 +156,22 @@ std::vector<char> LUS::BinaryWriter::ToVector() {
     return mStream->ToVector();
 }
 
+std::vector<char> LUS::BinaryWriter::Release() {
+    return mStream->Release();
+}
+
 void LUS::BinaryWriter::Finish(std::ostream& output) {
+    if (auto vector = dynamic_cast<VectorOutputStream*>(&output)) {
+        vector->Append(mStream->Release());
+        return;
+    }
+
+    if (auto memory = std::dynamic_pointer_cast<MemoryStream>(mStream)) {
+        const auto& data = memory->GetBuffer();
+        output.write(data.data(), data.size());
+        return;
+    }
+
     auto data = mStream->ToVector();
     output.write(data.data(), data.size());
 }
\ No newline at end of file
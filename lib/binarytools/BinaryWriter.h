@@ -38,7 +38,10 @@ class BinaryWriter {
     void WriteByte(char value);
 
     std::vector<char> ToVector();
+    // Moves the written data out, leaving the writer empty
+    std::vector<char> Release();
 
+    // Writes the data to output without copying it, a VectorOutputStream takes the buffer itself
     void Finish(std::ostream &output);
 
 protected:
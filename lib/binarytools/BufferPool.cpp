@@ -0,0 +1,37 @@
+#include "BufferPool.h"
+#include <mutex>
+
+// Bounds what the pool can hold on to, 32 buffers of at most 1 MiB each
+#define MAX_POOLED_BUFFERS 32
+#define MAX_POOLED_CAPACITY (1024 * 1024)
+#define MIN_BUFFER_CAPACITY (1024 * 16)
+
+static std::mutex sPoolMutex;
+static std::vector<std::vector<char>> sPool;
+
+std::vector<char> LUS::BufferPool::Acquire() {
+    {
+        std::lock_guard<std::mutex> lock(sPoolMutex);
+        if (!sPool.empty()) {
+            auto buffer = std::move(sPool.back());
+            sPool.pop_back();
+            return buffer;
+        }
+    }
+
+    std::vector<char> buffer;
+    buffer.reserve(MIN_BUFFER_CAPACITY);
+    return buffer;
+}
+
+void LUS::BufferPool::Recycle(std::vector<char> buffer) {
+    if (buffer.capacity() < MIN_BUFFER_CAPACITY || buffer.capacity() > MAX_POOLED_CAPACITY) {
+        return;
+    }
+
+    buffer.clear();
+    std::lock_guard<std::mutex> lock(sPoolMutex);
+    if (sPool.size() < MAX_POOLED_BUFFERS) {
+        sPool.push_back(std::move(buffer));
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <vector>
+
+namespace LUS {
+// Process wide free list of byte buffers, so the memory streams behind every exported
+// resource reuse the capacity of the ones before them instead of growing from scratch
+class BufferPool {
+  public:
+    // Empty buffer, with the capacity of a recycled one when there is any
+    static std::vector<char> Acquire();
+    // Keeps the capacity of the buffer around, oversized buffers are freed instead
+    static void Recycle(std::vector<char> buffer);
+};
+} // namespace LUS
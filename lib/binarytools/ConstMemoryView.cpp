@@ -0,0 +1,73 @@
+#include "ConstMemoryView.h"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+LUS::ConstMemoryView::ConstMemoryView(const char* nBuffer, size_t nBufferSize) {
+    mBuffer = nBuffer;
+    mBufferSize = nBufferSize;
+    mBaseAddress = 0;
+}
+
+LUS::ConstMemoryView::~ConstMemoryView() {
+}
+
+uint64_t LUS::ConstMemoryView::GetLength() {
+    return mBufferSize;
+}
+
+void LUS::ConstMemoryView::Seek(int32_t offset, SeekOffsetType seekType) {
+    if (seekType == SeekOffsetType::Start) {
+        mBaseAddress = offset;
+    } else if (seekType == SeekOffsetType::Current) {
+        mBaseAddress += offset;
+    } else if (seekType == SeekOffsetType::End) {
+        mBaseAddress = mBufferSize - 1 - offset;
+    }
+}
+
+void LUS::ConstMemoryView::CheckBounds(size_t length) const {
+    if (mBaseAddress > mBufferSize || length > mBufferSize - mBaseAddress) {
+        throw std::out_of_range("Read of " + std::to_string(length) + " bytes at offset " + std::to_string(mBaseAddress) +
+                                " is out of bounds (size " + std::to_string(mBufferSize) + ")");
+    }
+}
+
+std::unique_ptr<char[]> LUS::ConstMemoryView::Read(size_t length) {
+    CheckBounds(length);
+    std::unique_ptr<char[]> result = std::make_unique<char[]>(length);
+
+    memcpy(result.get(), mBuffer + mBaseAddress, length);
+    mBaseAddress += length;
+
+    return result;
+}
+
+void LUS::ConstMemoryView::Read(const char* dest, size_t length) {
+    CheckBounds(length);
+    memcpy((void*)dest, mBuffer + mBaseAddress, length);
+    mBaseAddress += length;
+}
+
+int8_t LUS::ConstMemoryView::ReadByte() {
+    CheckBounds(1);
+    return mBuffer[mBaseAddress++];
+}
+
+void LUS::ConstMemoryView::Write(char* srcBuffer, size_t length) {
+    throw std::runtime_error("ConstMemoryView is read-only");
+}
+
+void LUS::ConstMemoryView::WriteByte(int8_t value) {
+    throw std::runtime_error("ConstMemoryView is read-only");
+}
+
+std::vector<char> LUS::ConstMemoryView::ToVector() {
+    return std::vector<char>(mBuffer, mBuffer + mBufferSize);
+}
+
+void LUS::ConstMemoryView::Flush() {
+}
+
+void LUS::ConstMemoryView::Close() {
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "Stream.h"
+
+namespace LUS {
+// Read-only stream over memory owned by someone else, the buffer must outlive the view
+class ConstMemoryView : public Stream {
+  public:
+    ConstMemoryView(const char* nBuffer, size_t nBufferSize);
+    ~ConstMemoryView();
+
+    uint64_t GetLength() override;
+
+    void Seek(int32_t offset, SeekOffsetType seekType) override;
+
+    std::unique_ptr<char[]> Read(size_t length) override;
+    void Read(const char* dest, size_t length) override;
+    int8_t ReadByte() override;
+
+    void Write(char* srcBuffer, size_t length) override;
+    void WriteByte(int8_t value) override;
+
+    std::vector<char> ToVector() override;
+
+    void Flush() override;
+    void Close() override;
+
+  protected:
+    const char* mBuffer;
+    std::size_t mBufferSize;
+
+    void CheckBounds(size_t length) const;
+};
+} // namespace LUS
@@ -1,24 +1,27 @@
 #include "MemoryStream.h"
+#include "BufferPool.h"
 #include <cstring>
+#include <utility>
+#include <algorithm>
 
 #ifndef _MSC_VER
 #define memcpy_s(dest, destSize, source, sourceSize) memcpy(dest, source, destSize)
 #endif
 
 LUS::MemoryStream::MemoryStream() {
-    mBuffer = std::vector<char>();
-    // mBuffer.reserve(1024 * 16);
+    mBuffer = BufferPool::Acquire();
     mBufferSize = 0;
     mBaseAddress = 0;
 }
 
 LUS::MemoryStream::MemoryStream(char* nBuffer, size_t nBufferSize) : MemoryStream() {
-    mBuffer = std::vector<char>(nBuffer, nBuffer + nBufferSize);
+    mBuffer.assign(nBuffer, nBuffer + nBufferSize);
     mBufferSize = nBufferSize;
     mBaseAddress = 0;
 }
 
 LUS::MemoryStream::~MemoryStream() {
+    BufferPool::Recycle(std::move(mBuffer));
 }
 
 uint64_t LUS::MemoryStream::GetLength() {
@@ -55,6 +58,7 @@ int8_t LUS::MemoryStream::ReadByte() {
 
 void LUS::MemoryStream::Write(char* srcBuffer, size_t length) {
     if (mBaseAddress + length >= mBuffer.size()) {
+        Reserve(mBaseAddress + length);
         mBuffer.resize(mBaseAddress + length);
         mBufferSize += length;
     }
@@ -65,6 +69,7 @@ void LUS::MemoryStream::Write(char* srcBuffer, size_t length) {
 
 void LUS::MemoryStream::WriteByte(int8_t value) {
     if (mBaseAddress >= mBuffer.size()) {
+        Reserve(mBaseAddress + 1);
         mBuffer.resize(mBaseAddress + 1);
         mBufferSize = mBaseAddress;
     }
@@ -76,6 +81,19 @@ std::vector<char> LUS::MemoryStream::ToVector() {
     return mBuffer;
 }
 
+std::vector<char> LUS::MemoryStream::Release() {
+    mBufferSize = 0;
+    mBaseAddress = 0;
+    return std::exchange(mBuffer, {});
+}
+
+// Grows geometrically so a resource written a few bytes at a time is not reallocated on every write
+void LUS::MemoryStream::Reserve(size_t size) {
+    if (size > mBuffer.capacity()) {
+        mBuffer.reserve(std::max(size, mBuffer.capacity() * 2));
+    }
+}
+
 void LUS::MemoryStream::Flush() {
 }
 
@@ -23,11 +23,15 @@ class MemoryStream : public Stream {
     void WriteByte(int8_t value) override;
 
     std::vector<char> ToVector() override;
+    std::vector<char> Release() override;
+    const std::vector<char>& GetBuffer() const { return mBuffer; }
 
     void Flush() override;
     void Close() override;
 
   protected:
+    void Reserve(size_t size);
+
     std::vector<char> mBuffer;
     std::size_t mBufferSize;
 };
@@ -23,6 +23,8 @@ class Stream {
     virtual void WriteByte(int8_t value) = 0;
 
     virtual std::vector<char> ToVector() = 0;
+    // Gives up the contents, streams that own their buffer move it out instead of copying
+    virtual std::vector<char> Release() { return ToVector(); }
 
     virtual void Flush() = 0;
     virtual void Close() = 0;
@@ -0,0 +1,33 @@
+#include "VectorOutputStream.h"
+#include "BufferPool.h"
+#include <utility>
+
+LUS::VectorOutputStream::VectorOutputStream() : std::ostream(nullptr) {
+    this->rdbuf(&mBuffer);
+}
+
+void LUS::VectorOutputStream::Append(std::vector<char>&& data) {
+    if (mBuffer.mData.empty()) {
+        BufferPool::Recycle(std::exchange(mBuffer.mData, std::move(data)));
+        return;
+    }
+
+    mBuffer.mData.insert(mBuffer.mData.end(), data.begin(), data.end());
+    BufferPool::Recycle(std::move(data));
+}
+
+std::vector<char> LUS::VectorOutputStream::Release() {
+    return std::exchange(mBuffer.mData, {});
+}
+
+LUS::VectorOutputStream::Buffer::int_type LUS::VectorOutputStream::Buffer::overflow(int_type c) {
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        mData.push_back(traits_type::to_char_type(c));
+    }
+    return traits_type::not_eof(c);
+}
+
+std::streamsize LUS::VectorOutputStream::Buffer::xsputn(const char* s, std::streamsize n) {
+    mData.insert(mData.end(), s, s + n);
+    return n;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <ostream>
+#include <vector>
+
+namespace LUS {
+// std::ostream that collects everything written to it in a std::vector<char> the caller can take,
+// BinaryWriter::Finish hands its buffer over instead of copying when writing into an empty one
+class VectorOutputStream : public std::ostream {
+  public:
+    VectorOutputStream();
+
+    // Appends data, taking ownership of it when nothing was written yet
+    void Append(std::vector<char>&& data);
+    std::vector<char> Release();
+
+  private:
+    class Buffer : public std::streambuf {
+      public:
+        std::vector<char> mData;
+
+      protected:
+        int_type overflow(int_type c) override;
+        std::streamsize xsputn(const char* s, std::streamsize n) override;
+    };
+
+    Buffer mBuffer;
+};
+} // namespace LUS
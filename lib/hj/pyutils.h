@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <vector>
 #include <unordered_map>
 
@@ -13,6 +14,14 @@ std::vector<T> slice(std::vector<T> const &v, uint32_t m, uint32_t n = -1) {
     return vec;
 }
 
+template<typename T>
+std::vector<T> slice(std::span<T> const &v, uint32_t m, uint32_t n = -1) {
+    auto first = v.begin() + m;
+    auto last = n == -1 ? v.end() : v.begin() + n;
+
+    return std::vector<T>(first, last);
+}
+
 std::vector<uint32_t> range(uint32_t start, uint32_t end);
 
 template<typename T>
@@ -0,0 +1,126 @@
+#ifndef MATCHFINDER_H_
+#define MATCHFINDER_H_
+
+#include <stdlib.h>
+
+#include "utils.h"
+
+// Hash chain match finder shared by the MIO0, Yay0 and Yay1 encoders.
+// Every position is linked to the previous one starting with the same 3 bytes,
+// so a search only visits candidates that can produce a usable match instead
+// of every earlier occurrence of the first byte.
+
+#define MATCHFINDER_HASH_BITS 15
+#define MATCHFINDER_HASH_SIZE (1 << MATCHFINDER_HASH_BITS)
+#define MATCHFINDER_WINDOW 4096
+#define MATCHFINDER_MIN_MATCH 3
+
+// types
+typedef struct
+{
+   const unsigned char *buf;
+   int length;
+   int *head;
+   int *prev;
+} matchfinder;
+
+// functions
+static inline unsigned int matchfinder_hash(const unsigned char *p)
+{
+   unsigned int v = ((unsigned int)p[0] << 16) | ((unsigned int)p[1] << 8) | p[2];
+   return (v * 2654435761u) >> (32 - MATCHFINDER_HASH_BITS);
+}
+
+static inline void matchfinder_init(matchfinder *mf, const unsigned char *buf, int length)
+{
+   mf->buf = buf;
+   mf->length = length;
+   mf->head = malloc(MATCHFINDER_HASH_SIZE * sizeof(*mf->head));
+   mf->prev = malloc(MAX(length, 1) * sizeof(*mf->prev));
+   for (int i = 0; i < MATCHFINDER_HASH_SIZE; i++) {
+      mf->head[i] = -1;
+   }
+}
+
+static inline void matchfinder_free(matchfinder *mf)
+{
+   free(mf->head);
+   free(mf->prev);
+}
+
+// positions must be pushed in increasing order
+static inline void matchfinder_push(matchfinder *mf, int index)
+{
+   if (index + MATCHFINDER_MIN_MATCH > mf->length) {
+      return;
+   }
+   unsigned int h = matchfinder_hash(&mf->buf[index]);
+   mf->prev[index] = mf->head[h];
+   mf->head[h] = index;
+}
+
+// used to find longest matching stream in buffer
+// start_offset: offset in buf to look back from
+// max_search: max number of bytes to find
+// found_offset: returned offset found (0 if none found)
+// returns max length of matching stream, matches shorter than 3 bytes are reported as 0
+// ties go to the farthest candidate, matching the original linear search byte for byte
+static inline int matchfinder_find(matchfinder *mf, int start_offset, int max_search, int *found_offset)
+{
+   const unsigned char *buf = mf->buf;
+   int best_length = 0;
+   int best_offset = 0;
+   int cur_length;
+   int search_len;
+   int farthest, off, i;
+
+   *found_offset = 0;
+   if (max_search < MATCHFINDER_MIN_MATCH) {
+      return 0;
+   }
+
+   // buf
+   //  |    off        start                  max
+   //  V     |+i->       |+i->                 |
+   //  |--------------raw-data-----------------|
+   //        |+i->       |      |+i->
+   //                       +cur_length
+
+   // check at most the past 4096 values
+   farthest = MAX(start_offset - MATCHFINDER_WINDOW, 0);
+   // chains run from the newest position to the oldest
+   for (off = mf->head[matchfinder_hash(&buf[start_offset])]; off >= farthest; off = mf->prev[off]) {
+      if (off >= start_offset) {
+         continue;
+      }
+      // check at most requested max or up until start
+      search_len = MIN(max_search, start_offset - off);
+      for (i = 0; i < search_len; i++) {
+         if (buf[start_offset + i] != buf[off + i]) {
+            break;
+         }
+      }
+      cur_length = i;
+      // if matched up until start, continue matching in already matched parts
+      if (cur_length == search_len) {
+         // check at most requested max less current length
+         search_len = max_search - cur_length;
+         for (i = 0; i < search_len; i++) {
+            if (buf[start_offset + cur_length + i] != buf[off + i]) {
+               break;
+            }
+         }
+         cur_length += i;
+      }
+      if (cur_length >= MATCHFINDER_MIN_MATCH && cur_length >= best_length) {
+         best_offset = start_offset - off;
+         best_length = cur_length;
+      }
+   }
+
+   // return best reverse offset and length (may be 0)
+   *found_offset = best_offset;
+   return best_length;
+}
+
+#endif // MATCHFINDER_H_
@@ -1,5 +1,6 @@
 #include "yay1.h"
 #include "libmio0/utils.h"
+#include "libmio0/matchfinder.h"
 #include <string.h>
 #include <stdlib.h>
 
@@ -7,48 +8,7 @@
 
 #define GET_BIT(buf, bit) ((buf)[(bit) / 8] & (1 << (7 - ((bit) % 8))))
 
-// types
-typedef struct
-{
-   int *indexes;
-   int allocated;
-   int count;
-   int start;
-} lookback;
-
 // functions
-#define LOOKBACK_COUNT 256
-#define LOOKBACK_INIT_SIZE 128
-static lookback *lookback_init(void)
-{
-   lookback *lb = malloc(LOOKBACK_COUNT * sizeof(*lb));
-   for (int i = 0; i < LOOKBACK_COUNT; i++) {
-      lb[i].allocated = LOOKBACK_INIT_SIZE;
-      lb[i].indexes = malloc(lb[i].allocated * sizeof(*lb[i].indexes));
-      lb[i].count = 0;
-      lb[i].start = 0;
-   }
-   return lb;
-}
-
-static void lookback_free(lookback *lb)
-{
-   for (int i = 0; i < LOOKBACK_COUNT; i++) {
-      free(lb[i].indexes);
-   }
-   free(lb);
-}
-
-static inline void lookback_push(lookback *lkbk, unsigned char val, int index)
-{
-   lookback *lb = &lkbk[val];
-   if (lb->count == lb->allocated) {
-      lb->allocated *= 4;
-      lb->indexes = realloc(lb->indexes, lb->allocated * sizeof(*lb->indexes));
-   }
-   lb->indexes[lb->count++] = index;
-}
-
 static void PUT_BIT(unsigned char *buf, int bit, int val)
 {
    unsigned char mask = 1 << (7 - (bit % 8));
@@ -56,67 +16,6 @@ static void PUT_BIT(unsigned char *buf, int bit, int val)
    buf[offset] = (buf[offset] & ~(mask)) | (val ? mask : 0);
 }
 
-// used to find longest matching stream in buffer
-// buf: buffer
-// start_offset: offset in buf to look back from
-// max_search: max number of bytes to find
-// found_offset: returned offset found (0 if none found)
-// returns max length of matching stream (0 if none found)
-static int find_longest(const unsigned char *buf, int start_offset, int max_search, int *found_offset, lookback *lkbk)
-{
-   int best_length = 0;
-   int best_offset = 0;
-   int cur_length;
-   int search_len;
-   int farthest, off, i;
-   int lb_idx;
-   const unsigned char first = buf[start_offset];
-   lookback *lb = &lkbk[first];
-
-   // buf
-   //  |    off        start                  max
-   //  V     |+i->       |+i->                 |
-   //  |--------------raw-data-----------------|
-   //        |+i->       |      |+i->
-   //                       +cur_length
-
-   // check at most the past 4096 values
-   farthest = MAX(start_offset - 4096, 0);
-   // find starting index
-   for (lb_idx = lb->start; lb_idx < lb->count && lb->indexes[lb_idx] < farthest; lb_idx++) {}
-   lb->start = lb_idx;
-   for ( ; lb_idx < lb->count && lb->indexes[lb_idx] < start_offset; lb_idx++) {
-      off = lb->indexes[lb_idx];
-      // check at most requested max or up until start
-      search_len = MIN(max_search, start_offset - off);
-      for (i = 0; i < search_len; i++) {
-         if (buf[start_offset + i] != buf[off + i]) {
-            break;
-         }
-      }
-      cur_length = i;
-      // if matched up until start, continue matching in already matched parts
-      if (cur_length == search_len) {
-         // check at most requested max less current length
-         search_len = max_search - cur_length;
-         for (i = 0; i < search_len; i++) {
-            if (buf[start_offset + cur_length + i] != buf[off + i]) {
-               break;
-            }
-         }
-         cur_length += i;
-      }
-      if (cur_length > best_length) {
-         best_offset = start_offset - off;
-         best_length = cur_length;
-      }
-   }
-
-   // return best reverse offset and length (may be 0)
-   *found_offset = best_offset;
-   return best_length;
-}
-
 int32_t yay1_encode(const uint8_t *in_buf, uint32_t length, uint8_t* out_buf) {
     unsigned char *bit_buf;
     unsigned char *comp_buf;
@@ -129,10 +28,10 @@ int32_t yay1_encode(const uint8_t *in_buf, uint32_t length, uint8_t* out_buf) {
     int bit_idx = 0;
     int comp_idx = 0;
     int uncomp_idx = 0;
-    lookback *lookbacks;
+    matchfinder finder;
  
-    // initialize lookback buffer
-    lookbacks = lookback_init();
+    // initialize match finder
+    matchfinder_init(&finder, in_buf, length);
  
     // allocate some temporary buffers worst case size
     bit_buf = malloc((length + 7) / 8); // 1-bit/byte
@@ -142,7 +41,7 @@ int32_t yay1_encode(const uint8_t *in_buf, uint32_t length, uint8_t* out_buf) {
  
     // encode data
     // special case for first byte
-    lookback_push(lookbacks, in_buf[0], 0);
+    matchfinder_push(&finder, 0);
     uncomp_buf[uncomp_idx] = in_buf[0];
     uncomp_idx += 1;
     bytes_proc += 1;
@@ -150,14 +49,14 @@ int32_t yay1_encode(const uint8_t *in_buf, uint32_t length, uint8_t* out_buf) {
     while (bytes_proc < length) {
        int offset;
        int max_length = MIN(length - bytes_proc, 0x111);
-       int longest_match = find_longest(in_buf, bytes_proc, max_length, &offset, lookbacks);
+       int longest_match = matchfinder_find(&finder, bytes_proc, max_length, &offset);
        // push current byte before checking next longer match
-       lookback_push(lookbacks, in_buf[bytes_proc], bytes_proc);
+       matchfinder_push(&finder, bytes_proc);
        if (longest_match > 2) {
           int lookahead_offset;
           // lookahead to next byte to see if longer match
           int lookahead_length = MIN(length - bytes_proc - 1, 0x111);
-          int lookahead_match = find_longest(in_buf, bytes_proc + 1, lookahead_length, &lookahead_offset, lookbacks);
+          int lookahead_match = matchfinder_find(&finder, bytes_proc + 1, lookahead_length, &lookahead_offset);
           // better match found, use uncompressed + lookahead compressed
           if ((longest_match + 1) < lookahead_match) {
              // uncompressed byte
@@ -168,15 +67,21 @@ int32_t yay1_encode(const uint8_t *in_buf, uint32_t length, uint8_t* out_buf) {
              longest_match = lookahead_match;
              offset = lookahead_offset;
              bit_idx++;
-             lookback_push(lookbacks, in_buf[bytes_proc], bytes_proc);
+             matchfinder_push(&finder, bytes_proc);
           }
           // first byte already pushed above
           for (int i = 1; i < longest_match; i++) {
-             lookback_push(lookbacks, in_buf[bytes_proc + i], bytes_proc + i);
+             matchfinder_push(&finder, bytes_proc + i);
+          }
+          // compressed block, matches over 17 bytes keep a zero count and store the rest with the raw bytes
+          if (longest_match > 17) {
+             comp_buf[comp_idx] = ((offset - 1) >> 8) & 0x0F;
+             uncomp_buf[uncomp_idx] = longest_match - 18;
+             uncomp_idx++;
+          } else {
+             comp_buf[comp_idx] = (((longest_match - 2) & 0x0F) << 4) |
+                                  (((offset - 1) >> 8) & 0x0F);
           }
-          // compressed block
-          comp_buf[comp_idx] = (((longest_match - 3) & 0x0F) << 4) |
-                               (((offset - 1) >> 8) & 0x0F);
           comp_buf[comp_idx + 1] = (offset - 1) & 0xFF;
           comp_idx += 2;
           PUT_BIT(bit_buf, bit_idx, 0);
@@ -213,7 +118,7 @@ int32_t yay1_encode(const uint8_t *in_buf, uint32_t length, uint8_t* out_buf) {
     free(bit_buf);
     free(comp_buf);
     free(uncomp_buf);
-    lookback_free(lookbacks);
+    matchfinder_free(&finder);
  
     return bytes_written;
 }
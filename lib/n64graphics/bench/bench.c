@@ -0,0 +1,110 @@
+// Times the pixel conversions on one large image per format. Build it once as is and once with
+// N64GRAPHICS_NO_SIMD (the n64graphics_bench_scalar target) to compare, matching checksums mean
+// the SIMD kernels produced the same bytes as the scalar loops.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "n64graphics.h"
+
+#define WIDTH 1024
+#define HEIGHT 1024
+#define ROUNDS 20
+
+static double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// FNV-1a
+static uint32_t checksum(const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static void report(const char* name, double elapsed, uint32_t hash) {
+    const double pixels = (double) WIDTH * HEIGHT * ROUNDS;
+    printf("%-10s %8.2f ms %9.1f Mpx/s  %08x\n", name, elapsed * 1000 / ROUNDS, pixels / elapsed / 1e6, hash);
+}
+
+#define BENCH_RAW2(NAME, FUNC, DEPTH, SIZE)                                        \
+    do {                                                                           \
+        void* img = NULL;                                                          \
+        const double start = now();                                                \
+        for (int r = 0; r < ROUNDS; r++) {                                         \
+            free(img);                                                             \
+            img = FUNC(raw, WIDTH, HEIGHT, DEPTH);                                 \
+        }                                                                          \
+        report(NAME, now() - start, checksum(img, (size_t) WIDTH * HEIGHT * SIZE)); \
+        free(img);                                                                 \
+    } while (0)
+
+#define BENCH_2RAW(NAME, FUNC, IMG, DEPTH)                                         \
+    do {                                                                           \
+        int size = 0;                                                              \
+        const double start = now();                                                \
+        for (int r = 0; r < ROUNDS; r++) {                                         \
+            size = FUNC(out, IMG, WIDTH, HEIGHT, DEPTH);                           \
+        }                                                                          \
+        report(NAME, now() - start, checksum(out, size));                          \
+    } while (0)
+
+int main(void) {
+    const size_t pixels = (size_t) WIDTH * HEIGHT;
+    uint8_t* raw = malloc(pixels * 4);
+    uint8_t* out = malloc(pixels * 4);
+    rgba* rgbaImg = malloc(pixels * sizeof(rgba));
+    ia* iaImg = malloc(pixels * sizeof(ia));
+    ci* ciImg = malloc(pixels * sizeof(ci));
+    if (!raw || !out || !rgbaImg || !iaImg || !ciImg) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    // Fixed seed so both builds see the same pixels
+    srand(0x64);
+    for (size_t i = 0; i < pixels * 4; i++) {
+        raw[i] = rand() & 0xFF;
+    }
+    memcpy(rgbaImg, raw, pixels * sizeof(rgba));
+    memcpy(iaImg, raw, pixels * sizeof(ia));
+    for (size_t i = 0; i < pixels; i++) {
+        ciImg[i].index = raw[i] & 0x0F;
+    }
+
+#if defined(N64GRAPHICS_NO_SIMD)
+    printf("n64graphics scalar, %dx%d, %d rounds\n", WIDTH, HEIGHT, ROUNDS);
+#else
+    printf("n64graphics simd, %dx%d, %d rounds\n", WIDTH, HEIGHT, ROUNDS);
+#endif
+
+    BENCH_RAW2("raw2rgba16", raw2rgba, 16, sizeof(rgba));
+    BENCH_RAW2("raw2ia8", raw2ia, 8, sizeof(ia));
+    BENCH_RAW2("raw2ia4", raw2ia, 4, sizeof(ia));
+    BENCH_RAW2("raw2ia1", raw2ia, 1, sizeof(ia));
+    BENCH_RAW2("raw2i8", raw2i, 8, sizeof(ia));
+    BENCH_RAW2("raw2i4", raw2i, 4, sizeof(ia));
+    BENCH_RAW2("raw2ci4", raw2ci_torch, 4, sizeof(ci));
+
+    BENCH_2RAW("rgba2raw16", rgba2raw, rgbaImg, 16);
+    BENCH_2RAW("ia2raw8", ia2raw, iaImg, 8);
+    BENCH_2RAW("ia2raw4", ia2raw, iaImg, 4);
+    BENCH_2RAW("ia2raw1", ia2raw, iaImg, 1);
+    BENCH_2RAW("i2raw8", i2raw, iaImg, 8);
+    BENCH_2RAW("i2raw4", i2raw, iaImg, 4);
+    BENCH_2RAW("ci2raw4", ci2raw_torch, ciImg, 4);
+
+    free(raw);
+    free(out);
+    free(rgbaImg);
+    free(iaImg);
+    free(ciImg);
+    return 0;
+}
@@ -35,6 +35,450 @@ typedef struct {
     int depth;
 } img_format;
 
+// Define N64GRAPHICS_NO_SIMD to build the scalar loops only, the benchmark uses it as its baseline
+#ifndef N64GRAPHICS_NO_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define N64GRAPHICS_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define N64GRAPHICS_NEON
+#endif
+#endif
+
+//---------------------------------------------------------
+// SIMD pixel kernels
+// Each kernel converts as many whole vectors as it can and returns the number of
+// pixels it handled, the caller finishes the remaining pixels with the scalar loop.
+// Results match the SCALE_M_N macros bit for bit.
+//---------------------------------------------------------
+
+#ifdef N64GRAPHICS_SSE2
+// N64 data is big endian
+static inline __m128i bswap16_sse2(__m128i v) {
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+// SCALE_5_8 on 16 bit lanes, x * 0xFF / 0x1F done as a multiply high
+static inline __m128i scale_5_8_sse2(__m128i v) {
+    const __m128i scaled = _mm_mullo_epi16(v, _mm_set1_epi16(0xFF));
+    return _mm_srli_epi16(_mm_mulhi_epu16(scaled, _mm_set1_epi16(8457)), 2);
+}
+
+// SCALE_8_5 on 16 bit lanes, the division by 0xFF is exact for every 8 bit input
+static inline __m128i scale_8_5_sse2(__m128i v) {
+    const __m128i x = _mm_mullo_epi16(_mm_add_epi16(v, _mm_set1_epi16(4)), _mm_set1_epi16(0x1F));
+    const __m128i sum = _mm_add_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), _mm_set1_epi16(1));
+    return _mm_srli_epi16(sum, 8);
+}
+
+// SCALE_8_4 on 16 bit lanes
+static inline __m128i scale_8_4_sse2(__m128i v) {
+    return _mm_mulhi_epu16(v, _mm_set1_epi16(3856));
+}
+
+// SCALE_8_3 on 16 bit lanes
+static inline __m128i scale_8_3_sse2(__m128i v) {
+    return _mm_mulhi_epu16(v, _mm_set1_epi16(1821));
+}
+
+// Splits 8 bytes into 16 nibbles in pixel order, high nibble first
+static inline __m128i unpack_nibbles_sse2(const uint8_t* raw) {
+    const __m128i x = _mm_loadl_epi64((const __m128i*) raw);
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    const __m128i hi = _mm_and_si128(_mm_srli_epi16(x, 4), mask);
+    const __m128i lo = _mm_and_si128(x, mask);
+    return _mm_unpacklo_epi8(hi, lo);
+}
+
+// Joins 16 nibbles held in 16 bit lanes of a and b into 8 bytes, even pixels in the high nibble
+static inline void pack_nibbles_sse2(uint8_t* raw, __m128i a, __m128i b) {
+    const __m128i low = _mm_set1_epi32(0xFFFF);
+    const __m128i pa = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(a, low), 4), _mm_srli_epi32(a, 16));
+    const __m128i pb = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(b, low), 4), _mm_srli_epi32(b, 16));
+    const __m128i words = _mm_packs_epi32(pa, pb);
+    _mm_storel_epi64((__m128i*) raw, _mm_packus_epi16(words, words));
+}
+
+// Intensity of 8 IA pixels, zero extended to 16 bit lanes
+static inline __m128i ia_intensity_sse2(__m128i v) {
+    return _mm_and_si128(v, _mm_set1_epi16(0xFF));
+}
+
+static inline __m128i ia_alpha_sse2(__m128i v) {
+    return _mm_srli_epi16(v, 8);
+}
+
+// 1 in every lane that is not zero
+static inline __m128i nonzero_sse2(__m128i v) {
+    const __m128i zero = _mm_cmpeq_epi16(v, _mm_setzero_si128());
+    return _mm_andnot_si128(zero, _mm_set1_epi16(1));
+}
+#endif
+
+#ifdef N64GRAPHICS_NEON
+static const uint8_t scale_5_8_table[32] = {
+    SCALE_5_8(0), SCALE_5_8(1), SCALE_5_8(2), SCALE_5_8(3), SCALE_5_8(4), SCALE_5_8(5), SCALE_5_8(6), SCALE_5_8(7),
+    SCALE_5_8(8), SCALE_5_8(9), SCALE_5_8(10), SCALE_5_8(11), SCALE_5_8(12), SCALE_5_8(13), SCALE_5_8(14), SCALE_5_8(15),
+    SCALE_5_8(16), SCALE_5_8(17), SCALE_5_8(18), SCALE_5_8(19), SCALE_5_8(20), SCALE_5_8(21), SCALE_5_8(22), SCALE_5_8(23),
+    SCALE_5_8(24), SCALE_5_8(25), SCALE_5_8(26), SCALE_5_8(27), SCALE_5_8(28), SCALE_5_8(29), SCALE_5_8(30), SCALE_5_8(31),
+};
+
+// SCALE_5_8 as a 32 entry table lookup, v must be below 32
+static inline uint8x8_t scale_5_8_neon(uint8x8_t v) {
+    uint8x8x4_t table;
+    table.val[0] = vld1_u8(scale_5_8_table);
+    table.val[1] = vld1_u8(scale_5_8_table + 8);
+    table.val[2] = vld1_u8(scale_5_8_table + 16);
+    table.val[3] = vld1_u8(scale_5_8_table + 24);
+    return vtbl4_u8(table, v);
+}
+
+// SCALE_8_5 widened to 16 bit lanes, same exact division by 0xFF as the SSE2 path
+static inline uint16x8_t scale_8_5_neon(uint8x8_t v) {
+    const uint16x8_t x = vmulq_n_u16(vaddw_u8(vdupq_n_u16(4), v), 0x1F);
+    const uint16x8_t sum = vaddq_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), vdupq_n_u16(1));
+    return vshrq_n_u16(sum, 8);
+}
+
+// SCALE_8_4 is x * 241 >> 12 for every 8 bit input
+static inline uint8x16_t scale_8_4_neon(uint8x16_t v) {
+    const uint8x8_t m = vdup_n_u8(241);
+    const uint16x8_t lo = vshrq_n_u16(vmull_u8(vget_low_u8(v), m), 12);
+    const uint16x8_t hi = vshrq_n_u16(vmull_u8(vget_high_u8(v), m), 12);
+    return vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+}
+
+// SCALE_8_3 is x * 228 >> 13 for every 8 bit input
+static inline uint8x16_t scale_8_3_neon(uint8x16_t v) {
+    const uint8x8_t m = vdup_n_u8(228);
+    const uint16x8_t lo = vshrq_n_u16(vmull_u8(vget_low_u8(v), m), 13);
+    const uint16x8_t hi = vshrq_n_u16(vmull_u8(vget_high_u8(v), m), 13);
+    return vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+}
+
+// Splits 8 bytes into 16 nibbles in pixel order, high nibble first
+static inline uint8x16_t unpack_nibbles_neon(const uint8_t* raw) {
+    const uint8x8_t x = vld1_u8(raw);
+    const uint8x8x2_t n = vzip_u8(vshr_n_u8(x, 4), vand_u8(x, vdup_n_u8(0x0F)));
+    return vcombine_u8(n.val[0], n.val[1]);
+}
+
+// Joins 16 nibbles into 8 bytes, even pixels in the high nibble kept to the low byte like the scalar loops
+static inline void pack_nibbles_neon(uint8_t* raw, uint8x16_t n) {
+    const uint16x8_t pairs = vreinterpretq_u16_u8(n);
+    const uint8x8_t even = vmovn_u16(pairs);
+    const uint8x8_t odd = vshrn_n_u16(pairs, 8);
+    vst1_u8(raw, vorr_u8(vshl_n_u8(even, 4), odd));
+}
+#endif
+
+static int unpack_rgba16(rgba* img, const uint8_t* raw, int count) {
+    int i = 0;
+#ifdef N64GRAPHICS_SSE2
+    const __m128i mask = _mm_set1_epi16(0x1F);
+    for (; i + 8 <= count; i += 8) {
+        const __m128i v = bswap16_sse2(_mm_loadu_si128((const __m128i*) (raw + i * 2)));
+        const __m128i r = scale_5_8_sse2(_mm_srli_epi16(v, 11));
+        const __m128i g = scale_5_8_sse2(_mm_and_si128(_mm_srli_epi16(v, 6), mask));
+        const __m128i b = scale_5_8_sse2(_mm_and_si128(_mm_srli_epi16(v, 1), mask));
+        const __m128i a = _mm_sub_epi16(_mm_setzero_si128(), _mm_and_si128(v, _mm_set1_epi16(1)));
+        const __m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+        const __m128i ba = _mm_or_si128(b, _mm_slli_epi16(a, 8));
+        _mm_storeu_si128((__m128i*) (img + i), _mm_unpacklo_epi16(rg, ba));
+        _mm_storeu_si128((__m128i*) (img + i + 4), _mm_unpackhi_epi16(rg, ba));
+    }
+#elif defined(N64GRAPHICS_NEON)
+    const uint16x8_t mask = vdupq_n_u16(0x1F);
+    for (; i + 8 <= count; i += 8) {
+        const uint16x8_t v = vreinterpretq_u16_u8(vrev16q_u8(vld1q_u8(raw + i * 2)));
+        uint8x8x4_t px;
+        px.val[0] = scale_5_8_neon(vmovn_u16(vshrq_n_u16(v, 11)));
+        px.val[1] = scale_5_8_neon(vmovn_u16(vandq_u16(vshrq_n_u16(v, 6), mask)));
+        px.val[2] = scale_5_8_neon(vmovn_u16(vandq_u16(vshrq_n_u16(v, 1), mask)));
+        px.val[3] = vmovn_u16(vtstq_u16(v, vdupq_n_u16(1)));
+        vst4_u8((uint8_t*) (img + i), px);
+    }
+#endif
+    return i;
+}
+
+static int pack_rgba16(uint8_t* raw, const rgba* img, int count) {
+    int i = 0;
+#ifdef N64GRAPHICS_SSE2
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    for (; i + 8 <= count; i += 8) {
+        const __m128i p0 = _mm_loadu_si128((const __m128i*) (img + i));
+        const __m128i p1 = _mm_loadu_si128((const __m128i*) (img + i + 4));
+        const __m128i r = _mm_packs_epi32(_mm_and_si128(p0, mask), _mm_and_si128(p1, mask));
+        const __m128i g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 8), mask), _mm_and_si128(_mm_srli_epi32(p1, 8), mask));
+        const __m128i b = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 16), mask), _mm_and_si128(_mm_srli_epi32(p1, 16), mask));
+        const __m128i a = _mm_packs_epi32(_mm_srli_epi32(p0, 24), _mm_srli_epi32(p1, 24));
+        __m128i v = _mm_slli_epi16(scale_8_5_sse2(r), 11);
+        v = _mm_or_si128(v, _mm_slli_epi16(scale_8_5_sse2(g), 6));
+        v = _mm_or_si128(v, _mm_slli_epi16(scale_8_5_sse2(b), 1));
+        v = _mm_or_si128(v, nonzero_sse2(a));
+        _mm_storeu_si128((__m128i*) (raw + i * 2), bswap16_sse2(v));
+    }
+#elif defined(N64GRAPHICS_NEON)
+    for (; i + 8 <= count; i += 8) {
+        const uint8x8x4_t px = vld4_u8((const uint8_t*) (img + i));
+        uint16x8_t v = vshlq_n_u16(scale_8_5_neon(px.val[0]), 11);
+        v = vorrq_u16(v, vshlq_n_u16(scale_8_5_neon(px.val[1]), 6));
+        v = vorrq_u16(v, vshlq_n_u16(scale_8_5_neon(px.val[2]), 1));
+        v = vorrq_u16(v, vmovl_u8(vmin_u8(px.val[3], vdup_n_u8(1))));
+        vst1q_u8(raw + i * 2, vrev16q_u8(vreinterpretq_u8_u16(v)));
+    }
+#endif
+    return i;
+}
+
+static int unpack_ia8(ia* img, const uint8_t* raw, int count) {
+    int i = 0;
+#ifdef N64GRAPHICS_SSE2
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    for (; i + 16 <= count; i += 16) {
+        const __m128i x = _mm_loadu_si128((const __m128i*) (raw + i));
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(x, 4), mask);
+        const __m128i lo = _mm_and_si128(x, mask);
+        const __m128i intensity = _mm_or_si128(_mm_slli_epi16(hi, 4), hi);
+        const __m128i alpha = _mm_or_si128(_mm_slli_epi16(lo, 4), lo);
+        _mm_storeu_si128((__m128i*) (img + i), _mm_unpacklo_epi8(intensity, alpha));
+        _mm_storeu_si128((__m128i*) (img + i + 8), _mm_unpackhi_epi8(intensity, alpha));
+    }
+#elif defined(N64GRAPHICS_NEON)
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16_t x = vld1q_u8(raw + i);
+        const uint8x16_t hi = vshrq_n_u8(x, 4);
+        const uint8x16_t lo = vandq_u8(x, vdupq_n_u8(0x0F));
+        uint8x16x2_t px;
+        px.val[0] = vorrq_u8(vshlq_n_u8(hi, 4), hi);
+        px.val[1] = vorrq_u8(vshlq_n_u8(lo, 4), lo);
+        vst2q_u8((uint8_t*) (img + i), px);
+    }
+#endif
+    return i;
+}
+
+static int pack_ia8(uint8_t* raw, const ia* img, int count) {
+    int i = 0;
+#ifdef N64GRAPHICS_SSE2
+    for (; i + 16 <= count; i += 16) {
+        const __m128i p0 = _mm_loadu_si128((const __m128i*) (img + i));
+        const __m128i p1 = _mm_loadu_si128((const __m128i*) (img + i + 8));
+        const __m128i v0 = _mm_or_si128(_mm_slli_epi16(scale_8_4_sse2(ia_intensity_sse2(p0)), 4), scale_8_4_sse2(ia_alpha_sse2(p0)));
+        const __m128i v1 = _mm_or_si128(_mm_slli_epi16(scale_8_4_sse2(ia_intensity_sse2(p1)), 4), scale_8_4_sse2(ia_alpha_sse2(p1)));
+        _mm_storeu_si128((__m128i*) (raw + i), _mm_packus_epi16(v0, v1));
+    }
+#elif defined(N64GRAPHICS_NEON)
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16x2_t px = vld2q_u8((const uint8_t*) (img + i));
+        vst1q_u8(raw + i, vorrq_u8(vshlq_n_u8(scale_8_4_neon(px.val[0]), 4), scale_8_4_neon(px.val[1])));
+    }
+#endif
+    return i;
+}
+
+static int unpack_ia4(ia* img, const uint8_t* raw, int count) {
+    int i = 0;
+#ifdef N64GRAPHICS_SSE2
+    for (; i + 16 <= count; i += 16) {
+        const __m128i n = unpack_nibbles_sse2(raw + i / 2);
+        const __m128i level = _mm_and_si128(_mm_srli_epi16(n, 1), _mm_set1_epi8(0x07));
+        // SCALE_3_8 is level * 36, split into shifts that stay inside each byte
+        const __m128i intensity = _mm_add_epi8(_mm_slli_epi16(level, 5), _mm_slli_epi16(level, 2));
+        const __m128i one = _mm_set1_epi8(1);
+        const __m128i alpha = _mm_cmpeq_epi8(_mm_and_si128(n, one), one);
+        _mm_storeu_si128((__m128i*) (img + i), _mm_unpacklo_epi8(intensity, alpha));
+        _mm_storeu_si128((__m128i*) (img + i + 8), _mm_unpackhi_epi8(intensity, alpha));
+    }
+#elif defined(N64GRAPHICS_NEON)
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16_t n = unpack_nibbles_neon(raw + i / 2);
+        uint8x16x2_t px;
+        px.val[0] = vmulq_u8(vshrq_n_u8(n, 1), vdupq_n_u8(0x24));
+        px.val[1] = vtstq_u8(n, vdupq_n_u8(1));
+        vst2q_u8((uint8_t*) (img + i), px);
+    }
+#endif
+    return i;
+}
+
+static int pack_ia4(uint8_t* raw, const ia* img, int count) {
+    int i = 0;
+#ifdef N64GRAPHICS_SSE2
+    for (; i + 16 <= count; i += 16) {
+        const __m128i p0 = _mm_loadu_si128((const __m128i*) (img + i));
+        const __m128i p1 = _mm_loadu_si128((const __m128i*) (img + i + 8));
+        const __m128i n0 = _mm_or_si128(_mm_slli_epi16(scale_8_3_sse2(ia_intensity_sse2(p0)), 1), nonzero_sse2(ia_alpha_sse2(p0)));
+        const __m128i n1 = _mm_or_si128(_mm_slli_epi16(scale_8_3_sse2(ia_intensity_sse2(p1)), 1), nonzero_sse2(ia_alpha_sse2(p1)));
+        pack_nibbles_sse2(raw + i / 2, n0, n1);
+    }
+#elif defined(N64GRAPHICS_NEON)
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16x2_t px = vld2q_u8((const uint8_t*) (img + i));
+        const uint8x16_t alpha = vminq_u8(px.val[1], vdupq_n_u8(1));
+        pack_nibbles_neon(raw + i / 2, vorrq_u8(vshlq_n_u8(scale_8_3_neon(px.val[0]), 1), alpha));
+    }
+#endif
+    return i;
+}
+
+static int unpack_ia1(ia* img, const uint8_t* raw, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint8_t bits = raw[i / 8];
+        for (int j = 0; j < 8; j++) {
+            const uint8_t value = -((bits >> (7 - j)) & 1);
+            img[i + j].intensity = value;
+            img[i + j].alpha = value;
+        }
+    }
+    return i;
+}
+
+static int pack_ia1(uint8_t* raw, const ia* img, int count) {
+    int i = 0;
+#ifdef N64GRAPHICS_SSE2
+    for (; i + 16 <= count; i += 16) {
+        const __m128i p0 = _mm_loadu_si128((const __m128i*) (img + i));
+        const __m128i p1 = _mm_loadu_si128((const __m128i*) (img + i + 8));
+        const __m128i intensity = _mm_packus_epi16(ia_intensity_sse2(p0), ia_intensity_sse2(p1));
+        const int set = ~_mm_movemask_epi8(_mm_cmpeq_epi8(intensity, _mm_setzero_si128()));
+        // movemask puts pixel 0 in bit 0, the N64 stores it in the MSb
+        for (int j = 0; j < 2; j++) {
+            uint8_t b = set >> (j * 8);
+            b = ((b & 0xF0) >> 4) | ((b & 0x0F) << 4);
+            b = ((b & 0xCC) >> 2) | ((b & 0x33) << 2);
+            b = ((b & 0xAA) >> 1) | ((b & 0x55) << 1);
+            raw[i / 8 + j] = b;
+        }
+    }
+#elif defined(N64GRAPHICS_NEON)
+    static const uint8_t weights[16] = { 0x80, 0x40, 0x20, 0x10, 8, 4, 2, 1, 0x80, 0x40, 0x20, 0x10, 8, 4, 2, 1 };
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16_t intensity = vld2q_u8((const uint8_t*) (img + i)).val[0];
+        const uint8x16_t bits = vandq_u8(vtstq_u8(intensity, intensity), vld1q_u8(weights));
+        // Three pairwise adds sum each half into one byte, lane 0 and 1 hold the result
+        uint8x8_t sum = vpadd_u8(vget_low_u8(bits), vget_high_u8(bits));
+        sum = vpadd_u8(sum, sum);
+        sum = vpadd_u8(sum, sum);
+        raw[i / 8] = vget_lane_u8(sum, 0);
+        raw[i / 8 + 1] = vget_lane_u8(sum, 1);
+    }
+#endif
+    return i;
+}
+
+static int unpack_i8(ia* img, const uint8_t* raw, int count) {
+    int i = 0;
+#ifdef N64GRAPHICS_SSE2
+    const __m128i alpha = _mm_set1_epi8((char) 0xFF);
+    for (; i + 16 <= count; i += 16) {
+        const __m128i x = _mm_loadu_si128((const __m128i*) (raw + i));
+        _mm_storeu_si128((__m128i*) (img + i), _mm_unpacklo_epi8(x, alpha));
+        _mm_storeu_si128((__m128i*) (img + i + 8), _mm_unpackhi_epi8(x, alpha));
+    }
+#elif defined(N64GRAPHICS_NEON)
+    for (; i + 16 <= count; i += 16) {
+        uint8x16x2_t px;
+        px.val[0] = vld1q_u8(raw + i);
+        px.val[1] = vdupq_n_u8(0xFF);
+        vst2q_u8((uint8_t*) (img + i), px);
+    }
+#endif
+    return i;
+}
+
+static int pack_i8(uint8_t* raw, const ia* img, int count) {
+    int i = 0;
+#ifdef N64GRAPHICS_SSE2
+    for (; i + 16 <= count; i += 16) {
+        const __m128i p0 = _mm_loadu_si128((const __m128i*) (img + i));
+        const __m128i p1 = _mm_loadu_si128((const __m128i*) (img + i + 8));
+        _mm_storeu_si128((__m128i*) (raw + i), _mm_packus_epi16(ia_intensity_sse2(p0), ia_intensity_sse2(p1)));
+    }
+#elif defined(N64GRAPHICS_NEON)
+    for (; i + 16 <= count; i += 16) {
+        vst1q_u8(raw + i, vld2q_u8((const uint8_t*) (img + i)).val[0]);
+    }
+#endif
+    return i;
+}
+
+static int unpack_i4(ia* img, const uint8_t* raw, int count) {
+    int i = 0;
+#ifdef N64GRAPHICS_SSE2
+    const __m128i alpha = _mm_set1_epi8((char) 0xFF);
+    for (; i + 16 <= count; i += 16) {
+        const __m128i n = unpack_nibbles_sse2(raw + i / 2);
+        const __m128i intensity = _mm_or_si128(_mm_slli_epi16(n, 4), n);
+        _mm_storeu_si128((__m128i*) (img + i), _mm_unpacklo_epi8(intensity, alpha));
+        _mm_storeu_si128((__m128i*) (img + i + 8), _mm_unpackhi_epi8(intensity, alpha));
+    }
+#elif defined(N64GRAPHICS_NEON)
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16_t n = unpack_nibbles_neon(raw + i / 2);
+        uint8x16x2_t px;
+        px.val[0] = vorrq_u8(vshlq_n_u8(n, 4), n);
+        px.val[1] = vdupq_n_u8(0xFF);
+        vst2q_u8((uint8_t*) (img + i), px);
+    }
+#endif
+    return i;
+}
+
+static int pack_i4(uint8_t* raw, const ia* img, int count) {
+    int i = 0;
+#ifdef N64GRAPHICS_SSE2
+    for (; i + 16 <= count; i += 16) {
+        const __m128i p0 = _mm_loadu_si128((const __m128i*) (img + i));
+        const __m128i p1 = _mm_loadu_si128((const __m128i*) (img + i + 8));
+        pack_nibbles_sse2(raw + i / 2, scale_8_4_sse2(ia_intensity_sse2(p0)), scale_8_4_sse2(ia_intensity_sse2(p1)));
+    }
+#elif defined(N64GRAPHICS_NEON)
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16x2_t px = vld2q_u8((const uint8_t*) (img + i));
+        pack_nibbles_neon(raw + i / 2, scale_8_4_neon(px.val[0]));
+    }
+#endif
+    return i;
+}
+
+static int unpack_ci4(ci* img, const uint8_t* raw, int count) {
+    int i = 0;
+#ifdef N64GRAPHICS_SSE2
+    for (; i + 16 <= count; i += 16) {
+        _mm_storeu_si128((__m128i*) (img + i), unpack_nibbles_sse2(raw + i / 2));
+    }
+#elif defined(N64GRAPHICS_NEON)
+    for (; i + 16 <= count; i += 16) {
+        vst1q_u8((uint8_t*) (img + i), unpack_nibbles_neon(raw + i / 2));
+    }
+#endif
+    return i;
+}
+
+static int pack_ci4(uint8_t* raw, const ci* img, int count) {
+    int i = 0;
+#ifdef N64GRAPHICS_SSE2
+    const __m128i mask = _mm_set1_epi16(0xFF);
+    for (; i + 16 <= count; i += 16) {
+        // Indices are not masked to 4 bits, so keep the low byte of index << 4 like the scalar loop does
+        const __m128i x = _mm_loadu_si128((const __m128i*) (img + i));
+        const __m128i even = _mm_and_si128(_mm_slli_epi16(x, 4), mask);
+        const __m128i odd = _mm_srli_epi16(x, 8);
+        const __m128i v = _mm_or_si128(even, odd);
+        _mm_storel_epi64((__m128i*) (raw + i / 2), _mm_packus_epi16(v, v));
+    }
+#elif defined(N64GRAPHICS_NEON)
+    for (; i + 16 <= count; i += 16) {
+        pack_nibbles_neon(raw + i / 2, vld1q_u8((const uint8_t*) (img + i)));
+    }
+#endif
+    return i;
+}
+
 //---------------------------------------------------------
 // N64 RGBA/IA/I/CI -> internal RGBA/IA
 //---------------------------------------------------------
@@ -51,19 +495,15 @@ rgba* raw2rgba(const uint8_t* raw, int width, int height, int depth) {
     }
 
     if (depth == 16) {
-        for (int i = 0; i < width * height; i++) {
+        for (int i = unpack_rgba16(img, raw, width * height); i < width * height; i++) {
             img[i].red = SCALE_5_8((raw[i * 2] & 0xF8) >> 3);
             img[i].green = SCALE_5_8(((raw[i * 2] & 0x07) << 2) | ((raw[i * 2 + 1] & 0xC0) >> 6));
             img[i].blue = SCALE_5_8((raw[i * 2 + 1] & 0x3E) >> 1);
             img[i].alpha = (raw[i * 2 + 1] & 0x01) ? 0xFF : 0x00;
         }
     } else if (depth == 32) {
-        for (int i = 0; i < width * height; i++) {
-            img[i].red = raw[i * 4];
-            img[i].green = raw[i * 4 + 1];
-            img[i].blue = raw[i * 4 + 2];
-            img[i].alpha = raw[i * 4 + 3];
-        }
+        // RGBA32 is already laid out like rgba
+        memcpy(img, raw, img_size);
     }
 
     return img;
@@ -82,19 +522,17 @@ ia* raw2ia(const uint8_t* raw, int width, int height, int depth) {
 
     switch (depth) {
         case 16:
-            for (int i = 0; i < width * height; i++) {
-                img[i].intensity = raw[i * 2];
-                img[i].alpha = raw[i * 2 + 1];
-            }
+            // IA16 is already laid out like ia
+            memcpy(img, raw, img_size);
             break;
         case 8:
-            for (int i = 0; i < width * height; i++) {
+            for (int i = unpack_ia8(img, raw, width * height); i < width * height; i++) {
                 img[i].intensity = SCALE_4_8((raw[i] & 0xF0) >> 4);
                 img[i].alpha = SCALE_4_8(raw[i] & 0x0F);
             }
             break;
         case 4:
-            for (int i = 0; i < width * height; i++) {
+            for (int i = unpack_ia4(img, raw, width * height); i < width * height; i++) {
                 uint8_t bits;
                 bits = raw[i / 2];
                 if (i % 2) {
@@ -107,7 +545,7 @@ ia* raw2ia(const uint8_t* raw, int width, int height, int depth) {
             }
             break;
         case 1:
-            for (int i = 0; i < width * height; i++) {
+            for (int i = unpack_ia1(img, raw, width * height); i < width * height; i++) {
                 uint8_t bits;
                 uint8_t mask;
                 bits = raw[i / 8];
@@ -138,12 +576,10 @@ ci *raw2ci_torch(const uint8_t* raw, int width, int height, int depth) {
 
     switch (depth) {
         case 8:
-            for (int i = 0; i < width * height; i++) {
-                img[i].index = raw[i];
-            }
+            memcpy(img, raw, img_size);
         break;
         case 4:
-            for (int i = 0; i < width * height; i++) {
+            for (int i = unpack_ci4(img, raw, width * height); i < width * height; i++) {
                 int pos = i / 2;
                 img[i].index = i % 2 ? raw[pos] & 0xF : raw[pos] >> 4;
             }
@@ -169,13 +605,13 @@ ia* raw2i(const uint8_t* raw, int width, int height, int depth) {
 
     switch (depth) {
         case 8:
-            for (int i = 0; i < width * height; i++) {
+            for (int i = unpack_i8(img, raw, width * height); i < width * height; i++) {
                 img[i].intensity = raw[i];
                 img[i].alpha = 0xFF;
             }
             break;
         case 4:
-            for (int i = 0; i < width * height; i++) {
+            for (int i = unpack_i4(img, raw, width * height); i < width * height; i++) {
                 uint8_t bits;
                 bits = raw[i / 2];
                 if (i % 2) {
@@ -233,7 +669,7 @@ int rgba2raw(uint8_t* raw, const rgba* img, int width, int height, int depth) {
     INFO("Converting RGBA%d %dx%d to raw\n", depth, width, height);
 
     if (depth == 16) {
-        for (int i = 0; i < width * height; i++) {
+        for (int i = pack_rgba16(raw, img, width * height); i < width * height; i++) {
             uint8_t r, g, b, a;
             r = SCALE_8_5(img[i].red);
             g = SCALE_8_5(img[i].green);
@@ -243,12 +679,7 @@ int rgba2raw(uint8_t* raw, const rgba* img, int width, int height, int depth) {
             raw[i * 2 + 1] = ((g & 0x3) << 6) | (b << 1) | a;
         }
     } else if (depth == 32) {
-        for (int i = 0; i < width * height; i++) {
-            raw[i * 4] = img[i].red;
-            raw[i * 4 + 1] = img[i].green;
-            raw[i * 4 + 2] = img[i].blue;
-            raw[i * 4 + 3] = img[i].alpha;
-        }
+        memcpy(raw, img, size);
     } else {
         ERROR("Error invalid depth %d\n", depth);
         size = -1;
@@ -263,20 +694,17 @@ int ia2raw(uint8_t* raw, const ia* img, int width, int height, int depth) {
 
     switch (depth) {
         case 16:
-            for (int i = 0; i < width * height; i++) {
-                raw[i * 2] = img[i].intensity;
-                raw[i * 2 + 1] = img[i].alpha;
-            }
+            memcpy(raw, img, size);
             break;
         case 8:
-            for (int i = 0; i < width * height; i++) {
+            for (int i = pack_ia8(raw, img, width * height); i < width * height; i++) {
                 uint8_t val = SCALE_8_4(img[i].intensity);
                 uint8_t alpha = SCALE_8_4(img[i].alpha);
                 raw[i] = (val << 4) | alpha;
             }
             break;
         case 4:
-            for (int i = 0; i < width * height; i++) {
+            for (int i = pack_ia4(raw, img, width * height); i < width * height; i++) {
                 uint8_t val = SCALE_8_3(img[i].intensity);
                 uint8_t alpha = img[i].alpha ? 0x01 : 0x00;
                 uint8_t old = raw[i / 2];
@@ -288,7 +716,7 @@ int ia2raw(uint8_t* raw, const ia* img, int width, int height, int depth) {
             }
             break;
         case 1:
-            for (int i = 0; i < width * height; i++) {
+            for (int i = pack_ia1(raw, img, width * height); i < width * height; i++) {
                 uint8_t val = img[i].intensity;
                 uint8_t old = raw[i / 8];
                 uint8_t bit = 1 << (7 - (i % 8));
@@ -310,35 +738,128 @@ int ia2raw(uint8_t* raw, const ia* img, int width, int height, int depth) {
 
 
 /**
- * Check 2 rgba structs for equality. 0 if unequal, 1 if equal
+ * Open addressed table from a packed RGBA color to the first palette index holding it.
+ * Built once per palette so matching an image is linear in its pixel count.
 **/
-int comp_rgba(const rgba left, const rgba right) {
-   if ((left.red != right.red) || (left.green != right.green) || (left.blue != right.blue) || (left.alpha != right.alpha)) {
+typedef struct {
+   uint32_t *colors;
+   int16_t *indexes;
+   int capacity; // always a power of two
+   int used;
+} color_table;
+
+static inline uint32_t pack_rgba(const rgba color) {
+   return ((uint32_t) color.red << 24) | ((uint32_t) color.green << 16) | ((uint32_t) color.blue << 8) | color.alpha;
+}
+
+static inline int color_table_slot(const color_table *table, uint32_t color) {
+   int slot = (color * 2654435761u) >> 8 & (table->capacity - 1);
+   while (table->indexes[slot] != -1 && table->colors[slot] != color) {
+      slot = (slot + 1) & (table->capacity - 1);
+   }
+   return slot;
+}
+
+static int color_table_init(color_table *table, int capacity) {
+   table->capacity = capacity;
+   table->used = 0;
+   table->colors = malloc(capacity * sizeof(*table->colors));
+   table->indexes = malloc(capacity * sizeof(*table->indexes));
+   if (!table->colors || !table->indexes) {
+      ERROR("Error allocating color table\n");
+      free(table->colors);
+      free(table->indexes);
       return 0;
-   } else {
+   }
+   memset(table->indexes, 0xFF, capacity * sizeof(*table->indexes));
+   return 1;
+}
+
+static void color_table_free(color_table *table) {
+   free(table->colors);
+   free(table->indexes);
+}
+
+// returns the palette index of color or -1 if it is not in the table
+static int color_table_find(const color_table *table, const rgba color) {
+   return table->indexes[color_table_slot(table, pack_rgba(color))];
+}
+
+// keeps the first index stored for a color, grows once the table is half full
+static int color_table_insert(color_table *table, const rgba color, int index) {
+   uint32_t packed = pack_rgba(color);
+   int slot = color_table_slot(table, packed);
+   if (table->indexes[slot] != -1) {
       return 1;
    }
+   table->colors[slot] = packed;
+   table->indexes[slot] = index;
+   table->used++;
+
+   if (table->used * 2 > table->capacity) {
+      color_table grown;
+      if (!color_table_init(&grown, table->capacity * 2)) {
+         return 0;
+      }
+      for (int i = 0; i < table->capacity; i++) {
+         if (table->indexes[i] != -1) {
+            int dest = color_table_slot(&grown, table->colors[i]);
+            grown.colors[dest] = table->colors[i];
+            grown.indexes[dest] = table->indexes[i];
+         }
+      }
+      grown.used = table->used;
+      color_table_free(table);
+      *table = grown;
+   }
+   return 1;
 }
 
-/**
- * Check if a given rgba (comp) is in a given palette (pal, represented as an array of rgba structs)
- * If found, return the index in pal it was found out
- * Otherwise, return -1
-**/
-int get_color_index(const rgba comp, const rgba *pal, int mask_value, int pal_size) {
-   int pal_idx;
-   // The starting values used here are super specific to MK64, they're not really portable to anything else
-   if (mask_value == 0) {
-      pal_idx = 0;
-   } else {
-      pal_idx = 0xC0;
+static int color_table_build(color_table *table, const rgba *pal, int start, int pal_size) {
+   if (!color_table_init(table, 512)) {
+      return 0;
    }
-   for (; pal_idx < pal_size; pal_idx++) {
-      if (comp_rgba(comp, pal[pal_idx]) == 1) return pal_idx;
+   for (int pal_idx = start; pal_idx < pal_size; pal_idx++) {
+      if (!color_table_insert(table, pal[pal_idx], pal_idx)) {
+         color_table_free(table);
+         return 0;
+      }
+   }
+   return 1;
+}
+
+// first palette entry with the smallest squared RGBA distance to color
+static int nearest_color_index(const rgba color, const rgba *pal, int pal_size) {
+   int best = 0;
+   int best_dist = -1;
+   for (int pal_idx = 0; pal_idx < pal_size; pal_idx++) {
+      int dr = color.red - pal[pal_idx].red;
+      int dg = color.green - pal[pal_idx].green;
+      int db = color.blue - pal[pal_idx].blue;
+      int da = color.alpha - pal[pal_idx].alpha;
+      int dist = dr * dr + dg * dg + db * db + da * da;
+      if (best_dist < 0 || dist < best_dist) {
+         best = pal_idx;
+         best_dist = dist;
+      }
+   }
+   return best;
+}
+
+static inline void put_ci(uint8_t *rawci, int img_idx, int pal_idx, int ci_depth) {
+   switch (ci_depth) {
+      case 8:
+         rawci[img_idx] = pal_idx;
+         break;
+      case 4:
+      {
+         int byte_idx = img_idx / 2;
+         int nibble = 1 - (img_idx % 2);
+         uint8_t mask = 0xF << (4 * (1 - nibble));
+         rawci[byte_idx] = (rawci[byte_idx] & mask) | (pal_idx << (4 * nibble));
+         break;
+      }
    }
-   ERROR("Could not find a color in the palette\n");
-   ERROR("comp: %x%x%x%x\n", comp.red, comp.green, comp.blue, comp.alpha);
-   return -1;
 }
 
 /**
@@ -348,37 +869,82 @@ int get_color_index(const rgba comp, const rgba *pal, int mask_value, int pal_si
  * Returns 1 if all values in img are found somewhere in pal
 **/
 int imgpal2rawci(uint8_t *rawci, const rgba *img, const rgba *pal, const uint8_t *wheel_mask, int raw_size, int ci_depth, int img_size, int pal_size) {
+   // The starting values used for masked pixels are super specific to MK64, they're not really portable to anything else
+   color_table tables[2];
    int img_idx;
    int pal_idx;
-   int mask_value;
+   int ret = 1;
    memset(rawci, 0, raw_size);
 
+   if (!color_table_build(&tables[0], pal, 0, pal_size)) {
+      return 0;
+   }
+   if (wheel_mask != NULL && !color_table_build(&tables[1], pal, 0xC0, pal_size)) {
+      color_table_free(&tables[0]);
+      return 0;
+   }
+
    for (img_idx = 0; img_idx < img_size; img_idx++) {
-      if (wheel_mask != NULL) {
-         mask_value = wheel_mask[img_idx];
-      } else {
-         mask_value = 0;
+      int masked = wheel_mask != NULL && wheel_mask[img_idx];
+      pal_idx = color_table_find(&tables[masked], img[img_idx]);
+      if (pal_idx == -1) {
+         const rgba comp = img[img_idx];
+         ERROR("Could not find a color in the palette\n");
+         ERROR("comp: %x%x%x%x\n", comp.red, comp.green, comp.blue, comp.alpha);
+         ret = 0;
+         break;
       }
-      pal_idx = get_color_index(img[img_idx], pal, mask_value, pal_size);
-      if (pal_idx != -1) {
-         switch (ci_depth) {
-            case 8:
-                  rawci[img_idx] = pal_idx;
-               break;
-            case 4:
-            {
-               int byte_idx = img_idx / 2;
-               int nibble = 1 - (img_idx % 2);
-               uint8_t mask = 0xF << (4 * (1 - nibble));
-               rawci[byte_idx] = (rawci[byte_idx] & mask) | (pal_idx << (4 * nibble));
-               break;
-            }
+      put_ci(rawci, img_idx, pal_idx, ci_depth);
+   }
+
+   color_table_free(&tables[0]);
+   if (wheel_mask != NULL) {
+      color_table_free(&tables[1]);
+   }
+   return ret;
+}
+
+int rgba2rawci(uint8_t *rawci, const rgba *img, const rgba *pal, int img_size, int pal_size, int ci_depth, int quantize) {
+   color_table table;
+   int size = (img_size * ci_depth + 7) / 8;
+
+   if (ci_depth != 4 && ci_depth != 8) {
+      ERROR("Error invalid depth %d\n", ci_depth);
+      return -1;
+   }
+   if (pal_size <= 0) {
+      ERROR("Error empty palette\n");
+      return -1;
+   }
+   // entries past what the index can address are unreachable
+   pal_size = MIN(pal_size, 1 << ci_depth);
+
+   memset(rawci, 0, size);
+   if (!color_table_build(&table, pal, 0, pal_size)) {
+      return -1;
+   }
+
+   for (int img_idx = 0; img_idx < img_size; img_idx++) {
+      int pal_idx = color_table_find(&table, img[img_idx]);
+      if (pal_idx == -1) {
+         const rgba comp = img[img_idx];
+         if (!quantize) {
+            ERROR("Color %02X%02X%02X%02X at pixel %d is not in the palette\n", comp.red, comp.green, comp.blue, comp.alpha, img_idx);
+            size = -1;
+            break;
+         }
+         // remember the match so every later pixel of this color is a single lookup
+         pal_idx = nearest_color_index(comp, pal, pal_size);
+         if (!color_table_insert(&table, comp, pal_idx)) {
+            size = -1;
+            break;
          }
-      } else {
-         return 0;
       }
+      put_ci(rawci, img_idx, pal_idx, ci_depth);
    }
-   return 1;
+
+   color_table_free(&table);
+   return size;
 }
 
 int i2raw(uint8_t* raw, const ia* img, int width, int height, int depth) {
@@ -387,12 +953,12 @@ int i2raw(uint8_t* raw, const ia* img, int width, int height, int depth) {
 
     switch (depth) {
         case 8:
-            for (int i = 0; i < width * height; i++) {
+            for (int i = pack_i8(raw, img, width * height); i < width * height; i++) {
                 raw[i] = img[i].intensity;
             }
             break;
         case 4:
-            for (int i = 0; i < width * height; i++) {
+            for (int i = pack_i4(raw, img, width * height); i < width * height; i++) {
                 uint8_t val = SCALE_8_4(img[i].intensity);
                 uint8_t old = raw[i / 2];
                 if (i % 2) {
@@ -417,11 +983,17 @@ int ci2raw_torch(uint8_t *raw, const ci *img, int width, int height, int depth)
 
     switch (depth) {
         case 8:
-            for (int i = 0; i < width * height; i++) {
-                raw[i] = img[i].index;
-            }
+            memcpy(raw, img, size);
         break;
         case 4:
+            // Rows only run into each other when the width is odd
+            if (width % 2 == 0) {
+                int i = pack_ci4(raw, img, width * height);
+                for (; i < width * height; i += 2) {
+                    raw[i / 2] = img[i].index << 4 | img[i + 1].index;
+                }
+                break;
+            }
             for(int y = 0; y < height; y++) {
                 for(int x = 0; x < width; x += 2) {
                     const size_t pos = (y * width + x) / 2;
@@ -446,72 +1018,25 @@ int ci2raw_torch(uint8_t *raw, const ci *img, int width, int height, int depth)
 // internal RGBA/IA -> PNG
 //---------------------------------------------------------
 
-int rgba2png(unsigned char** png_output, int* size_output, const rgba* img, int width, int height) {
-    int ret = 0;
-
-    // convert to format stb_image_write expects
-    uint8_t* data = malloc(4 * width * height);
-    if (data) {
-        for (int j = 0; j < height; j++) {
-            for (int i = 0; i < width; i++) {
-                int idx = j * width + i;
-                data[4 * idx] = img[idx].red;
-                data[4 * idx + 1] = img[idx].green;
-                data[4 * idx + 2] = img[idx].blue;
-                data[4 * idx + 3] = img[idx].alpha;
-            }
-        }
-
+// The intermediate formats already match the pixel layout stb_image_write expects,
+// so images are handed to the encoder as they are
+_Static_assert(sizeof(rgba) == 4, "rgba must be 4 packed bytes");
+_Static_assert(sizeof(ia) == 2, "ia must be 2 packed bytes");
+_Static_assert(sizeof(ci) == 1, "ci must be 1 byte");
 
-        *png_output = stbi_write_png_to_mem(data, 0, width, height, 4, size_output);
-
-        free(data);
-    }
-
-    return ret;
+int rgba2png(unsigned char** png_output, int* size_output, const rgba* img, int width, int height) {
+    *png_output = stbi_write_png_to_mem((const unsigned char*) img, 0, width, height, 4, size_output);
+    return 0;
 }
 
 int ia2png(unsigned char** png_output, int* size_output, const ia* img, int width, int height) {
-    int ret = 0;
-
-    // convert to format stb_image_write expects
-    uint8_t* data = malloc(2 * width * height);
-    if (data) {
-        for (int j = 0; j < height; j++) {
-            for (int i = 0; i < width; i++) {
-                int idx = j * width + i;
-                data[2 * idx] = img[idx].intensity;
-                data[2 * idx + 1] = img[idx].alpha;
-            }
-        }
-
-        (*png_output) = stbi_write_png_to_mem(data, 0, width, height, 2, size_output);
-
-        free(data);
-    }
-
-    return ret;
+    (*png_output) = stbi_write_png_to_mem((const unsigned char*) img, 0, width, height, 2, size_output);
+    return 0;
 }
 
 int ci2png(unsigned char **png_output, int *size_output, const ci *img, int width, int height) {
-    int ret = 0;
-
-    // convert to format stb_image_write expects
-    uint8_t* data = malloc(width * height);
-    if (data) {
-        for (int j = 0; j < height; j++) {
-            for (int i = 0; i < width; i++) {
-                int idx = j * width + i;
-                data[idx] = img[idx].index;
-            }
-        }
-
-        (*png_output) = stbi_write_plte_png_to_mem(data, 0, width, height, 1, NULL, 0, size_output);
-
-        free(data);
-    }
-
-    return ret;
+    (*png_output) = stbi_write_plte_png_to_mem((const unsigned char*) img, 0, width, height, 1, NULL, 0, size_output);
+    return 0;
 }
 
 //---------------------------------------------------------
@@ -540,19 +1065,17 @@ rgba* png2rgba(unsigned char* png_input, int size_input, int* width, int* height
     }
 
     switch (channels) {
-        case 3: // red, green, blue
         case 4: // red, green, blue, alpha
+            memcpy(img, data, img_size);
+            break;
+        case 3: // red, green, blue
             for (int j = 0; j < h; j++) {
                 for (int i = 0; i < w; i++) {
                     int idx = j * w + i;
                     img[idx].red = data[channels * idx];
                     img[idx].green = data[channels * idx + 1];
                     img[idx].blue = data[channels * idx + 2];
-                    if (channels == 4) {
-                        img[idx].alpha = data[channels * idx + 3];
-                    } else {
-                        img[idx].alpha = 0xFF;
-                    }
+                    img[idx].alpha = 0xFF;
                 }
             }
             break;
@@ -676,13 +1199,7 @@ ia* png2ia(unsigned char* png_input, int size_input, int* width, int* height) {
             }
             break;
         case 2: // grey, alpha
-            for (int j = 0; j < h; j++) {
-                for (int i = 0; i < w; i++) {
-                    int idx = j * w + i;
-                    img[idx].intensity = data[2 * idx];
-                    img[idx].alpha = data[2 * idx + 1];
-                }
-            }
+            memcpy(img, data, img_size);
             break;
         default:
             ERROR("Don't know how to read channels: %d\n", channels);
@@ -61,6 +61,11 @@ int convert_raw_to_ci8(unsigned char **png_output, int *size_output, uint8_t *te
 
 int imgpal2rawci(uint8_t *rawci, const rgba *img, const rgba *pal, const uint8_t *wheel_mask, int raw_size, int ci_depth, int img_size, int pal_size);
 
+// intermediate RGBA + palette -> N64 raw CI4/CI8, colors missing from the palette fail
+// unless quantize is set, in which case they map to the nearest entry
+// returns length written to 'rawci' or -1 on error
+int rgba2rawci(uint8_t *rawci, const rgba *img, const rgba *pal, int img_size, int pal_size, int ci_depth, int quantize);
+
 //---------------------------------------------------------
 // intermediate RGBA/IA -> N64 RGBA/IA/I/CI
 // returns length written to 'raw' used or -1 on error
@@ -2,12 +2,19 @@
 
 #include "utils/Decompressor.h"
 #include "utils/TorchUtils.h"
+#include "utils/TextWriter.h"
+#include "utils/Logging.h"
 #include "archive/SWrapper.h"
 #include "archive/ZWrapper.h"
+#include "archive/DeferredWrapper.h"
+#include "utils/ThreadPool.h"
+#include "lib/binarytools/VectorOutputStream.h"
 #include "spdlog/spdlog.h"
 #include "hj/sha1.h"
 
 #include <regex>
+#include <set>
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <filesystem>
@@ -107,9 +114,6 @@
 using namespace std::chrono;
 namespace fs = std::filesystem;
 
-static const std::string regular = "[%Y-%m-%d %H:%M:%S.%e] [%l] %v";
-static const std::string line    = "[%Y-%m-%d %H:%M:%S.%e] [%l] > %v";
-
 static std::string ConvertType(std::string type) {
     int index = type.find(':');
 
@@ -128,10 +132,22 @@ static std::string GetTypeNode(YAML::Node& node) {
 
 Companion* Companion::Instance;
 
+static std::string NormalizePath(const std::string& path) {
+    return fs::path(path).lexically_normal().generic_string();
+}
+
+static thread_local FileContext sRootContext;
+// Files this thread is in the middle of, external_files that loop back to one of them can't wait for it
+static thread_local std::unordered_set<std::string> sActiveFiles;
+static thread_local FileContext* sCurrentContext = &sRootContext;
+
+FileContext& Companion::GetCurrentContext() {
+    return *sCurrentContext;
+}
+
 void Companion::Init(const ExportType type) {
 
-    spdlog::set_level(spdlog::level::debug);
-    spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] %v");
+    Torch::Logging::Init();
 
     this->gConfig.exporterType = type;
     this->RegisterFactory("BLOB", std::make_shared<BlobFactory>());
@@ -278,14 +294,12 @@ void Companion::ParseEnums(std::string& header) {
 std::optional<ParseResultData> Companion::ParseNode(YAML::Node& node, std::string& name) {
     auto type = GetTypeNode(node);
 
-    spdlog::set_pattern(regular);
     if(node["offset"]) {
         auto offset = node["offset"].as<uint32_t>();
-        SPDLOG_INFO("- [{}] Processing {} at 0x{:X}", type, name, offset);
+        SPDLOG_LOGGER_INFO(Torch::Logging::Plain(), "- [{}] Processing {} at 0x{:X}", type, name, offset);
     } else {
-        SPDLOG_INFO("- [{}] Processing {}", type, name);
+        SPDLOG_LOGGER_INFO(Torch::Logging::Plain(), "- [{}] Processing {}", type, name);
     }
-    spdlog::set_pattern(line);
     node["vpath"] = name;
 
     auto factory = this->GetFactory(type);
@@ -303,10 +317,18 @@ std::optional<ParseResultData> Companion::ParseNode(YAML::Node& node, std::strin
 
     bool executeDef = true;
     std::optional<std::shared_ptr<IParsedData>> result;
-    if(this->gConfig.modding && impl->SupportModdedAssets() && this->gModdedAssetPaths.contains(name)) {
-        auto path = fs::path(this->gConfig.moddingPath) / this->gModdedAssetPaths[name];
+    std::optional<std::string> moddedPath;
+    if(this->gConfig.modding && impl->SupportModdedAssets()) {
+        std::lock_guard<std::mutex> lock(this->gModdingMutex);
+        if(this->gModdedAssetPaths.contains(name)) {
+            moddedPath = this->gModdedAssetPaths[name];
+        }
+    }
+
+    if(moddedPath.has_value()) {
+        auto path = fs::path(this->gConfig.moddingPath) / moddedPath.value();
         if(!exists(path)) {
-            SPDLOG_ERROR("Modded asset {} not found", this->gModdedAssetPaths[name]);
+            SPDLOG_ERROR("Modded asset {} not found", moddedPath.value());
         } else {
             std::ifstream input(path, std::ios::binary);
             std::vector<uint8_t> data = std::vector<uint8_t>( std::istreambuf_iterator( input ), {});
@@ -318,7 +340,7 @@ std::optional<ParseResultData> Companion::ParseNode(YAML::Node& node, std::strin
     }
 
     if(executeDef && this->gConfig.parseMode == ParseMode::Default) {
-        result = impl->parse(this->gRomData, node);
+        result = impl->parse(this->GetRomData(), node);
     }
 
     if(executeDef && this->gConfig.parseMode == ParseMode::Directory) {
@@ -337,7 +359,7 @@ std::optional<ParseResultData> Companion::ParseNode(YAML::Node& node, std::strin
     SPDLOG_INFO("Processed {}", name);
 
     return ParseResultData {
-        name, type, node, result
+        name, type, node, result, this->CompileAsset(name, node)
     };
 }
 
@@ -356,13 +378,15 @@ void Companion::ParseModdingConfig() {
 
 
 void Companion::ParseCurrentFileConfig(YAML::Node node) {
+    auto& ctx = GetCurrentContext();
+
     if (node["external_files"]) {
         auto externalFiles = node["external_files"];
         if (externalFiles.IsSequence() && externalFiles.size()) {
             for(size_t i = 0; i < externalFiles.size(); i++) {
                 auto externalFile = externalFiles[i];
                 if (externalFile.size() == 0) {
-                    this->gCurrentExternalFiles.push_back((this->gSourceDirectory / externalFile.as<std::string>()).string());
+                    ctx.externalFiles.push_back(NormalizePath((this->gSourceDirectory / externalFile.as<std::string>()).string()));
                 } else {
                     SPDLOG_INFO("External File size {}", externalFile.size());
                     throw std::runtime_error("Incorrect yaml syntax for external files.\n\nThe yaml expects:\n:config:\n  external_files:\n  - <external_files>\n\ne.g.:\nexternal_files:\n  - actors/actor1.yaml");
@@ -375,29 +399,19 @@ void Companion::ParseCurrentFileConfig(YAML::Node node) {
                     throw std::runtime_error("External File " + externalFileName + " Not In Asset Directory " + this->gAssetPath);
                 }
 
-                if (!this->gAddrMap.contains(externalFileName)) {
+                if (this->MarkFileProcessed(externalFileName)) {
                     SPDLOG_INFO("Dependency on external file {}. Now processing {}", externalFileName, externalFileName);
-                    auto currentFile = this->gCurrentFile;
-                    auto currentDirectory = this->gCurrentDirectory;
-                    auto currentExternalFiles = this->gCurrentExternalFiles;
 
-                    this->gCurrentFile = externalFileName;
-                    this->gCurrentDirectory = std::filesystem::relative(externalFileName, this->gAssetPath).replace_extension("");
+                    YAML::Node root = this->gDocuments.Get(externalFileName).root;
+                    auto directory = std::filesystem::relative(externalFileName, this->gAssetPath).replace_extension("");
+                    this->ProcessFileInContext(externalFileName, directory, root, ctx.output);
 
-                    YAML::Node root = YAML::LoadFile(externalFileName);
-
-                    if (!this->gProcessedFiles.contains(this->gCurrentFile)) {
-                        ProcessFile(root);
-                        this->gProcessedFiles.insert(this->gCurrentFile);
-                    }
-
-                    SPDLOG_INFO("Finishing processing of file: {}", currentFile);
-
-                    this->gCurrentFile = currentFile;
-                    this->gCurrentDirectory = currentDirectory;
-                    this->gCurrentExternalFiles = currentExternalFiles;
-                    this->gFileHeader.clear();
+                    SPDLOG_INFO("Finishing processing of file: {}", ctx.file);
+                } else if (sActiveFiles.contains(NormalizePath(externalFileName))) {
+                    SPDLOG_INFO("Skipping external file {} as it is still being processed", externalFileName);
                 } else {
+                    // Another worker may still be on it, its assets are only complete once it is done
+                    this->WaitForFile(externalFileName);
                     SPDLOG_INFO("Skipping external file {} as it has already been processed", externalFileName);
                 }
             }
@@ -412,7 +426,7 @@ void Companion::ParseCurrentFileConfig(YAML::Node node) {
                 if (segment.IsSequence() && segment.size() == 2) {
                     const auto id = segment[0].as<uint32_t>();
                     const auto replacement = segment[1].as<std::string>();
-                    this->gManualSegments[id] = replacement;
+                    ctx.manualSegments[id] = replacement;
                     SPDLOG_DEBUG("Manual Segment {} replaced with {}", id, replacement);
                 } else {
                     throw std::runtime_error("Incorrect yaml syntax for manual segments.\n\nThe yaml expects:\n:config:\n  manual_segments:\n  - [<addr>, <replacement>]\n\nLike so:\nmanual_segments:\n  - [0x05000000, \"textures/other_textures/texture_6447C4\"]");
@@ -427,11 +441,11 @@ void Companion::ParseCurrentFileConfig(YAML::Node node) {
         // Set global variables for segmented data
         if (segments.IsSequence() && segments.size()) {
             if (segments[0].IsSequence() && segments[0].size() == 2) {
-                gCurrentSegmentNumber = segments[0][0].as<uint32_t>();
-                gCurrentFileOffset = segments[0][1].as<uint32_t>();
-                gCurrentCompressionType = Decompressor::GetCompressionType(this->gRomData, gCurrentFileOffset);
+                ctx.segmentNumber = segments[0][0].as<uint32_t>();
+                ctx.fileOffset = segments[0][1].as<uint32_t>();
+                ctx.compressionType = Decompressor::GetCompressionType(this->GetRomData(), ctx.fileOffset);
                 if(node["no_compression"]) {
-                    gCurrentCompressionType = CompressionType::None;
+                    ctx.compressionType = CompressionType::None;
                 }
             } else {
                 throw std::runtime_error("Incorrect yaml syntax for segments.\n\nThe yaml expects:\n:config:\n  segments:\n  - [<segment>, <file_offset>]\n\nLike so:\nsegments:\n  - [0x06, 0x821D10]");
@@ -444,7 +458,8 @@ void Companion::ParseCurrentFileConfig(YAML::Node node) {
             if (segment.IsSequence() && segment.size() == 2) {
                 const auto id = segment[0].as<uint32_t>();
                 const auto replacement = segment[1].as<uint32_t>();
-                this->gConfig.segment.local[id] = replacement;
+                ctx.localSegments[id] = replacement;
+                ctx.segmentTable.generation = 0;
                 SPDLOG_DEBUG("Segment {} replaced with 0x{:X}", id, replacement);
             } else {
                 throw std::runtime_error("Incorrect yaml syntax for segments.\n\nThe yaml expects:\n:config:\n  segments:\n  - [<segment>, <file_offset>]\n\nLike so:\nsegments:\n  - [0x06, 0x821D10]");
@@ -454,7 +469,7 @@ void Companion::ParseCurrentFileConfig(YAML::Node node) {
 
     if (node["virtual"]) {
         auto virtualAddrMap = node["virtual"];
-        gVirtualAddrMap[gCurrentFile] = std::make_tuple<uint32_t, uint32_t>(virtualAddrMap[0].as<uint32_t>(), virtualAddrMap[1].as<uint32_t>());
+        ctx.virtualAddr = std::make_tuple<uint32_t, uint32_t>(virtualAddrMap[0].as<uint32_t>(), virtualAddrMap[1].as<uint32_t>());
     }
 
     if(node["header"]) {
@@ -463,7 +478,7 @@ void Companion::ParseCurrentFileConfig(YAML::Node node) {
             case ExportType::Header: {
                 if(header["header"].IsSequence()) {
                     for(auto line = header["header"].begin(); line != header["header"].end(); ++line) {
-                        this->gFileHeader += line->as<std::string>() + "\n";
+                        ctx.header += line->as<std::string>() + "\n";
                     }
                 }
                 break;
@@ -471,7 +486,7 @@ void Companion::ParseCurrentFileConfig(YAML::Node node) {
             case ExportType::Code: {
                 if(header["code"].IsSequence()) {
                     for(auto line = header["code"].begin(); line != header["code"].end(); ++line) {
-                        this->gFileHeader += line->as<std::string>() + "\n";
+                        ctx.header += line->as<std::string>() + "\n";
                     }
                 }
                 break;
@@ -484,12 +499,12 @@ void Companion::ParseCurrentFileConfig(YAML::Node node) {
         for(auto table = node["tables"].begin(); table != node["tables"].end(); ++table){
             auto name = table->first.as<std::string>();
             auto range = table->second["range"].as<std::vector<uint32_t>>();
-            auto start = gCurrentSegmentNumber ? gCurrentSegmentNumber << 24 | range[0] : range[0];
-            auto end = gCurrentSegmentNumber ? gCurrentSegmentNumber << 24 | range[1] : range[1];
+            auto start = ctx.segmentNumber ? ctx.segmentNumber << 24 | range[0] : range[0];
+            auto end = ctx.segmentNumber ? ctx.segmentNumber << 24 | range[1] : range[1];
             auto mode = GetSafeNode<std::string>(table->second, "mode", "APPEND");
             TableMode tMode = mode == "REFERENCE" ? TableMode::Reference : TableMode::Append;
             auto index_size = GetSafeNode<int32_t>(table->second, "index_size", -1);
-            this->gTables.push_back({name, start, end, tMode, index_size});
+            ctx.tables.push_back({name, start, end, tMode, index_size});
         }
     }
 
@@ -497,13 +512,13 @@ void Companion::ParseCurrentFileConfig(YAML::Node node) {
         auto vram = node["vram"];
         const auto addr = GetSafeNode<uint32_t>(vram, "addr");
         const auto offset = GetSafeNode<uint32_t>(vram, "offset");
-        this->gCurrentVram = { addr, offset };
+        ctx.vram = { addr, offset };
     }
 
-    this->gEnablePadGen = GetSafeNode<bool>(node, "autopads", true);
-    this->gNodeForceProcessing = GetSafeNode<bool>(node, "force", false);
-    this->gIndividualIncludes = GetSafeNode<bool>(node, "individual_data_incs", false);
-    this->gCurrentVirtualPath = GetSafeNode<std::string>(node, "path", "");
+    ctx.enablePadGen = GetSafeNode<bool>(node, "autopads", true);
+    ctx.forceProcessing = GetSafeNode<bool>(node, "force", false);
+    ctx.individualIncludes = GetSafeNode<bool>(node, "individual_data_incs", false);
+    ctx.virtualPath = GetSafeNode<std::string>(node, "path", "");
 }
 
 void Companion::ParseHash() {
@@ -514,6 +529,10 @@ void Companion::ParseHash() {
     } else {
         this->gHashNode = YAML::Node();
     }
+
+    if(this->gConfig.exporterType == ExportType::Code || this->gConfig.exporterType == ExportType::Header) {
+        this->gManifest.Load(this->gDestinationDirectory / "torch.manifest.bin");
+    }
 }
 
 std::string ExportTypeToString(ExportType type) {
@@ -534,35 +553,47 @@ bool Companion::NodeHasChanges(const std::string& path) {
         return true;
     }
 
-    std::ifstream yaml(path);
-    const std::vector<uint8_t> data = std::vector<uint8_t>(std::istreambuf_iterator( yaml ), {});
-    this->gCurrentHash = CalculateHash(data);
-    bool needsInit = true;
+    auto& ctx = GetCurrentContext();
+    ctx.hash = this->gDocuments.Get(path).hash;
     auto srcRelativePath = RelativePathToSrcDir(path);
 
+    // Changes to the rom, config.yml or any external file also invalidate the yaml
+    std::string context = this->gContextHash;
+    for(auto& file : ctx.externalFiles) {
+        context += this->gDocuments.Get(file).hash;
+    }
+    context = CalculateHash(std::span(reinterpret_cast<const uint8_t*>(context.data()), context.size()));
+
+    std::unique_lock<std::mutex> lock(this->gHashMutex);
     if(this->gHashNode[srcRelativePath]) {
-        auto entry = GetSafeNode<YAML::Node>(this->gHashNode, srcRelativePath);
+        auto entry = YAML::Clone(GetSafeNode<YAML::Node>(this->gHashNode, srcRelativePath));
+        lock.unlock();
+
         const auto hash = GetSafeNode<std::string>(entry, "hash", "no-hash");
+        const auto dependencies = GetSafeNode<std::string>(entry, "context", "no-hash");
         auto modes = GetSafeNode<YAML::Node>(entry, "extracted");
         auto extracted = GetSafeNode<bool>(modes, ExportTypeToString(this->gConfig.exporterType));
 
-        if(hash == this->gCurrentHash) {
-            needsInit = false;
+        if(hash == ctx.hash && dependencies == context) {
+            ctx.hashEntry = entry;
             if(extracted) {
                 SPDLOG_INFO("Skipping {} as it has not changed", srcRelativePath);
                 return false;
             }
+            return true;
         }
+    } else {
+        lock.unlock();
     }
 
-    if(needsInit) {
-        this->gHashNode[srcRelativePath] = YAML::Node();
-        this->gHashNode[srcRelativePath]["hash"] = this->gCurrentHash;
-        this->gHashNode[srcRelativePath]["extracted"] = YAML::Node();
-        for(size_t m = 0; m <= static_cast<size_t>(ExportType::Modding); m++) {
-            this->gHashNode[srcRelativePath]["extracted"][ExportTypeToString(static_cast<ExportType>(m))] = false;
-        }
+    YAML::Node entry;
+    entry["hash"] = ctx.hash;
+    entry["context"] = context;
+    entry["extracted"] = YAML::Node();
+    for(size_t m = 0; m <= static_cast<size_t>(ExportType::Modding); m++) {
+        entry["extracted"][ExportTypeToString(static_cast<ExportType>(m))] = false;
     }
+    ctx.hashEntry = entry;
 
     return true;
 }
@@ -579,7 +610,7 @@ void Companion::LoadYAMLRecursively(const std::string &dirPath, std::vector<YAML
             LoadYAMLRecursively(entry.path().generic_string(), result, false);
         } else if (entry.path().extension() == ".yaml" || entry.path().extension() == ".yml") {
             // Load YAML file and add it to the result vector
-            result.push_back(YAML::LoadFile(entry.path().generic_string()));
+            result.push_back(this->gDocuments.Get(entry.path()).root);
         }
     }
 }
@@ -609,15 +640,17 @@ void Companion::ProcessTables(YAML::Node& rom) {
 }
 
 void Companion::ProcessFile(YAML::Node root) {
+    auto& ctx = GetCurrentContext();
+
     // Set compressed file offsets and compression type
     if (auto segments = root[":config"]["segments"]) {
         if (segments.IsSequence() && segments.size() > 0) {
             if (segments[0].IsSequence() && segments[0].size() == 2) {
-                gCurrentSegmentNumber = segments[0][0].as<uint32_t>();
-                gCurrentFileOffset = segments[0][1].as<uint32_t>();
-                gCurrentCompressionType = Decompressor::GetCompressionType(this->gRomData, gCurrentFileOffset);
+                ctx.segmentNumber = segments[0][0].as<uint32_t>();
+                ctx.fileOffset = segments[0][1].as<uint32_t>();
+                ctx.compressionType = Decompressor::GetCompressionType(this->GetRomData(), ctx.fileOffset);
                 if(root[":config"]["no_compression"]) {
-                    gCurrentCompressionType = CompressionType::None;
+                    ctx.compressionType = CompressionType::None;
                 }
             } else {
                 throw std::runtime_error("Incorrect yaml syntax for segments.\n\nThe yaml expects:\n:config:\n  segments:\n  - [<segment>, <file_offset>]\n\nLike so:\nsegments:\n  - [0x06, 0x821D10]");
@@ -625,10 +658,11 @@ void Companion::ProcessFile(YAML::Node root) {
         }
     }
 
+    auto& addrMap = *this->GetAddrMap(ctx.key, true);
     for(auto asset = root.begin(); asset != root.end(); ++asset){
         auto node = asset->second;
         auto entryName = asset->first.as<std::string>();
-        auto output = (this->gCurrentDirectory / entryName).string();
+        auto output = (ctx.directory / entryName).string();
         std::replace(output.begin(), output.end(), '\\', '/');
 
         if(node["type"]){
@@ -642,45 +676,44 @@ void Companion::ProcessFile(YAML::Node root) {
             continue;
         }
 
-        if(gCurrentSegmentNumber) {
+        if(ctx.segmentNumber) {
             if (IS_SEGMENTED(node["offset"].as<uint32_t>()) == false) {
-                node["offset"] = (gCurrentSegmentNumber << 24) | node["offset"].as<uint32_t>();
+                node["offset"] = (ctx.segmentNumber << 24) | node["offset"].as<uint32_t>();
             }
         }
 
-        if(!gCurrentVirtualPath.empty()) {
-            node["path"] = gCurrentVirtualPath;
+        if(!ctx.virtualPath.empty()) {
+            node["path"] = ctx.virtualPath;
         }
 
-        this->gAddrMap[this->gCurrentFile][node["offset"].as<uint32_t>()] = std::make_tuple(output, node);
-    }
-
-    // Stupid hack because the iteration broke the assets
-    root = YAML::LoadFile(this->gCurrentFile);
-    this->gConfig.segment.local.clear();
-    this->gFileHeader.clear();
-    this->gCurrentPad = 0;
-    this->gCurrentVram = std::nullopt;
-    this->gCurrentVirtualPath = "";
-    this->gCurrentSegmentNumber = 0;
-    this->gCurrentCompressionType = CompressionType::None;
-    this->gCurrentFileOffset = 0;
-    this->gTables.clear();
-    this->gCurrentExternalFiles.clear();
-    this->gManualSegments.clear();
+        const auto compiled = this->CompileAsset(output, node);
+        addrMap[compiled->offset.value()] = compiled;
+        this->IndexAssetRange(ctx.key, compiled);
+    }
+
+    ctx.localSegments.clear();
+    ctx.segmentTable.generation = 0;
+    ctx.header.clear();
+    ctx.pad = 0;
+    ctx.vram = std::nullopt;
+    ctx.virtualPath = "";
+    ctx.segmentNumber = 0;
+    ctx.compressionType = CompressionType::None;
+    ctx.fileOffset = 0;
+    ctx.tables.clear();
+    ctx.externalFiles.clear();
+    ctx.manualSegments.clear();
     GFXDOverride::ClearVtx();
 
     if(root[":config"]) {
         this->ParseCurrentFileConfig(root[":config"]);
     }
 
-    if(!this->NodeHasChanges(this->gCurrentFile) && !this->gNodeForceProcessing) {
+    if(!this->NodeHasChanges(ctx.file) && !ctx.forceProcessing) {
         return;
     }
 
-    spdlog::set_pattern(regular);
-    SPDLOG_INFO("------------------------------------------------");
-    spdlog::set_pattern(line);
+    SPDLOG_LOGGER_INFO(Torch::Logging::Plain(), "------------------------------------------------");
 
     for(auto asset = root.begin(); asset != root.end(); ++asset){
 
@@ -691,37 +724,46 @@ void Companion::ProcessFile(YAML::Node root) {
             continue;
         }
 
-        if(gCurrentFileOffset && assetNode["offset"]) {
+        if(ctx.fileOffset && assetNode["offset"]) {
             const auto offset = assetNode["offset"].as<uint32_t>();
             if (!IS_SEGMENTED(offset)) {
-                assetNode["offset"] = (gCurrentSegmentNumber << 24) | offset;
+                assetNode["offset"] = (ctx.segmentNumber << 24) | offset;
             }
         }
 
-        if(!gCurrentVirtualPath.empty()) {
-            assetNode["path"] = gCurrentVirtualPath;
+        if(!ctx.virtualPath.empty()) {
+            assetNode["path"] = ctx.virtualPath;
         }
 
-        std::string output = (this->gCurrentDirectory / entryName).string();
+        std::string output = (ctx.directory / entryName).string();
         std::replace(output.begin(), output.end(), '\\', '/');
-        this->gConfig.segment.temporal.clear();
+        if(!ctx.temporalSegments.empty()) {
+            ctx.temporalSegments.clear();
+            ctx.segmentTable.generation = 0;
+        }
         auto result = this->ParseNode(assetNode, output);
         if(result.has_value()) {
-            this->gParseResults[this->gCurrentFile].push_back(result.value());
+            this->GetParseResults(ctx.key, true)->Add(result.value());
         }
 
-        spdlog::set_pattern(regular);
-        SPDLOG_INFO("------------------------------------------------");
-        spdlog::set_pattern(line);
+        SPDLOG_LOGGER_INFO(Torch::Logging::Plain(), "------------------------------------------------");
     }
 
-    for(auto& result : this->gParseResults[this->gCurrentFile]){
+    // Modded assets come from files the fingerprint doesn't cover
+    const auto incremental = (this->gConfig.exporterType == ExportType::Code || this->gConfig.exporterType == ExportType::Header) && !this->gConfig.modding;
+    const auto symbols = incremental ? this->GetSymbolTableHash(root[":config"] ? root[":config"] : YAML::Node()) : "";
+    // Manifest entries of the assets in this file, completed with their output range once it is written
+    std::unordered_map<std::string, std::tuple<std::string, AssetManifest::Entry, bool>> pending;
+    std::unordered_map<std::string, std::vector<uint8_t>> previousOutputs;
+
+    for(auto& result : this->GetParseResults(ctx.key, true)->entries){
         std::ostringstream stream;
         ExportResult endptr = std::nullopt;
         WriteEntry wEntry;
 
         auto data = result.data.value();
         const auto impl = this->GetFactory(result.type)->get();
+        ctx.asset = result.asset;
         const auto exporter = impl->GetExporter(this->gConfig.exporterType);
 
         if(!exporter.has_value()) {
@@ -730,16 +772,17 @@ void Companion::ProcessFile(YAML::Node root) {
 
         switch (this->gConfig.exporterType) {
             case ExportType::Binary: {
-                stream.str("");
-                stream.clear();
-                exporter->get()->Export(stream, data, result.name, result.node, &result.name);
-                auto data = stream.str();
-                this->gCurrentWrapper->AddFile(result.name, std::vector(data.begin(), data.end()));
-
-                for(auto& entry : this->gCompanionFiles){
-                    auto output = (this->gCurrentDirectory / entry.first).string();
+                // Binary writers hand their buffer straight to the output, which is then moved into the archive
+                LUS::VectorOutputStream output;
+                exporter->get()->Export(output, data, result.name, result.node, &result.name);
+                auto wrapper = this->GetCurrentWrapper();
+                wrapper->AddFile(result.name, output.Release());
+
+                // Companion files are cleared after each asset, so they can be handed over to the archive
+                for(auto& entry : ctx.companionFiles){
+                    auto output = (ctx.directory / entry.first).string();
                     std::replace(output.begin(), output.end(), '\\', '/');
-                    this->gCurrentWrapper->AddFile(output, entry.second);
+                    wrapper->AddFile(output, std::move(entry.second));
                 }
 
                 break;
@@ -761,14 +804,17 @@ void Companion::ProcessFile(YAML::Node root) {
                     create_directories(fs::path(dpath).parent_path());
                 }
 
-                this->gModdedAssetPaths[ogname] = result.name;
+                {
+                    std::lock_guard<std::mutex> lock(this->gModdingMutex);
+                    this->gModdedAssetPaths[ogname] = result.name;
+                }
 
                 std::ofstream file(dpath, std::ios::binary);
                 file.write(data.c_str(), data.size());
                 file.close();
 
-                for(auto& entry : this->gCompanionFiles){
-                    auto cpath = (Instance->GetOutputPath() / this->gCurrentDirectory / entry.first).string();
+                for(auto& entry : ctx.companionFiles){
+                    auto cpath = (Instance->GetOutputPath() / ctx.directory / entry.first).string();
                     std::replace(cpath.begin(), cpath.end(), '\\', '/');
                     if(!exists(fs::path(cpath).parent_path())){
                         create_directories(fs::path(cpath).parent_path());
@@ -782,22 +828,50 @@ void Companion::ProcessFile(YAML::Node root) {
                 break;
             }
             default: {
+                if(!incremental || !exporter->get()->IsCacheable()) {
+                    endptr = exporter->get()->Export(stream, data, result.name, result.node, &result.name);
+                    break;
+                }
+
+                // Everything the exported text of an asset can depend on
+                const auto key = ExportTypeToString(this->gConfig.exporterType) + ":" + result.name;
+                const auto source = fmt::format("{}\n{}\n{}\n{}\n{}", symbols, result.type, impl->GetVersion(), key, YAML::Dump(result.node));
+                const auto fingerprint = CalculateHash(std::span(reinterpret_cast<const uint8_t*>(source.data()), source.size()));
+
+                if(auto cached = this->gManifest.Find(key, fingerprint)) {
+                    if(auto text = AssetManifest::ReadOutput(cached.value(), previousOutputs)) {
+                        SPDLOG_INFO("Reusing {} as it has not changed", result.name);
+                        stream << text.value();
+                        endptr = cached->endptr;
+                        result.name = cached->name;
+                        pending[result.name] = { key, cached.value(), false };
+                        break;
+                    }
+                }
+
                 endptr = exporter->get()->Export(stream, data, result.name, result.node, &result.name);
+                const auto text = stream.str();
+                AssetManifest::Entry entry;
+                entry.fingerprint = fingerprint;
+                entry.name = result.name;
+                entry.endptr = endptr;
+                entry.hash = CalculateHash(std::span(reinterpret_cast<const uint8_t*>(text.data()), text.size()));
+                pending[result.name] = { key, entry, false };
                 break;
             }
         }
 
-        this->gCompanionFiles.clear();
+        ctx.companionFiles.clear();
 
-        if(result.node["offset"]) {
-            auto alignment = GetSafeNode<uint32_t>(result.node, "alignment", impl->GetAlignment());
+        if(result.asset->offset.has_value()) {
+            const auto alignment = result.asset->alignment;
             if(!endptr.has_value()) {
                 wEntry = {
                     result.name,
-                    result.node["offset"].as<uint32_t>(),
+                    result.asset->offset.value(),
                     alignment,
                     stream.str(),
-                    GetNode<std::string>(result.node, "comment"),
+                    result.asset->comment,
                     std::nullopt
                 };
             } else {
@@ -805,10 +879,10 @@ void Companion::ProcessFile(YAML::Node root) {
                     case 0:
                         wEntry = {
                             result.name,
-                            result.node["offset"].as<uint32_t>(),
+                            result.asset->offset.value(),
                             alignment,
                             stream.str(),
-                            GetNode<std::string>(result.node, "comment"),
+                            result.asset->comment,
                             std::get<size_t>(endptr.value())
                         };
                         break;
@@ -819,7 +893,7 @@ void Companion::ProcessFile(YAML::Node root) {
                             oentry.start,
                             alignment,
                             stream.str(),
-                            GetNode<std::string>(result.node, "comment"),
+                            result.asset->comment,
                             oentry.end
                         };
                         break;
@@ -832,8 +906,9 @@ void Companion::ProcessFile(YAML::Node root) {
             }
         }
 
-        this->gWriteMap[this->gCurrentFile][result.type].push_back(wEntry);
+        ctx.writeMap[result.type].push_back(wEntry);
     }
+    ctx.asset = nullptr;
 
     auto fsout = fs::path(this->gConfig.outputPath);
 
@@ -841,6 +916,7 @@ void Companion::ProcessFile(YAML::Node root) {
         fsout /= "modding.yml";
         YAML::Node modding;
 
+        std::lock_guard<std::mutex> lock(this->gModdingMutex);
         for (const auto& [key, value] : this->gModdedAssetPaths) {
             modding["assets"][key] = value;
         }
@@ -849,15 +925,15 @@ void Companion::ProcessFile(YAML::Node root) {
         file << modding;
         file.close();
     } else if(this->gConfig.exporterType != ExportType::Binary){
-        std::string filename = this->gCurrentDirectory.filename().string();
+        std::string filename = ctx.directory.filename().string();
 
         switch (this->gConfig.exporterType) {
             case ExportType::Header: {
-                fsout /= this->gCurrentDirectory.parent_path() / (filename + ".h");
+                fsout /= ctx.directory.parent_path() / (filename + ".h");
                 break;
             }
             case ExportType::Code: {
-                fsout /= this->gCurrentDirectory / (filename + ".c");
+                fsout /= ctx.directory / (filename + ".c");
                 break;
             }
             default: break;
@@ -869,7 +945,7 @@ void Companion::ProcessFile(YAML::Node root) {
 
         if(std::holds_alternative<std::string>(this->gWriteOrder)) {
             auto sort = std::get<std::string>(this->gWriteOrder);
-            for (const auto& [type, raw] : this->gWriteMap[this->gCurrentFile]) {
+            for (const auto& [type, raw] : ctx.writeMap) {
                 entries.insert(entries.end(), raw.begin(), raw.end());
             }
 
@@ -886,7 +962,7 @@ void Companion::ProcessFile(YAML::Node root) {
             }
         } else {
             for (const auto& type : std::get<std::vector<std::string>>(this->gWriteOrder)) {
-                entries = this->gWriteMap[this->gCurrentFile][type];
+                entries = ctx.writeMap[type];
 
                 std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
                     return a.addr > b.addr;
@@ -906,13 +982,20 @@ void Companion::ProcessFile(YAML::Node root) {
                 stream << "// 0x" << std::hex << std::uppercase << ASSET_PTR(result.addr) << "\n";
             }
 
+            if(auto entry = pending.find(result.name); entry != pending.end()) {
+                auto& [key, manifest, written] = entry->second;
+                manifest.start = static_cast<uint64_t>(stream.tellp());
+                manifest.size = result.buffer.size();
+                written = true;
+            }
+
             stream << result.buffer;
 
             if (hasSize && this->IsDebug()) {
                 stream << "// 0x" << std::hex << std::uppercase << ASSET_PTR(result.endptr.value()) << "\n\n";
             }
 
-            if(hasSize && i < entries.size() - 1 && this->gConfig.exporterType == ExportType::Code && !this->gIndividualIncludes){
+            if(hasSize && i < entries.size() - 1 && this->gConfig.exporterType == ExportType::Code && !ctx.individualIncludes){
                 int32_t startptr = ASSET_PTR(result.endptr.value());
                 int32_t end = ASSET_PTR(entries[i + 1].addr);
 
@@ -921,19 +1004,18 @@ void Companion::ProcessFile(YAML::Node root) {
 
                 if(gap < 0) {
                     stream << "// WARNING: Overlap detected between 0x" << std::hex << startptr << " and 0x" << end << " with size 0x" << std::abs(gap) << "\n";
-                    SPDLOG_WARN("Overlap detected between 0x{:X} and 0x{:X} with size 0x{:X} on file {}", startptr, end, gap, this->gCurrentFile);
-                } else if(gap < 0x10 && gap >= alignment && end % alignment == 0 && this->gEnablePadGen) {
-                    SPDLOG_WARN("Gap detected between 0x{:X} and 0x{:X} with size 0x{:X} on file {}", startptr, end, gap, this->gCurrentFile);
+                    SPDLOG_WARN("Overlap detected between 0x{:X} and 0x{:X} with size 0x{:X} on file {}", startptr, end, gap, ctx.file);
+                } else if(gap < 0x10 && gap >= alignment && end % alignment == 0 && ctx.enablePadGen) {
+                    SPDLOG_WARN("Gap detected between 0x{:X} and 0x{:X} with size 0x{:X} on file {}", startptr, end, gap, ctx.file);
                     SPDLOG_WARN("Creating pad of 0x{:X} bytes", gap);
-                    const auto padfile = this->gCurrentDirectory.filename().string();
+                    const auto padfile = ctx.directory.filename().string();
                     if(this->IsDebug()){
                         stream << "// 0x" << std::hex << std::uppercase << startptr << "\n";
                     }
-                    stream << "char pad_" << padfile << "_" << std::to_string(gCurrentPad++) << "[] = {\n" << tab_t;
+                    stream << "char pad_" << padfile << "_" << std::to_string(ctx.pad++) << "[] = {\n" << tab_t;
                     auto gapSize = gap & ~3;
-                    for(size_t j = 0; j < gapSize; j++){
-                        stream << "0x00, ";
-                    }
+                    Torch::TextWriter pad;
+                    pad.Repeat("0x00, ", gapSize).Flush(stream);
                     stream << "\n};\n";
                     if(this->IsDebug()){
                         stream << "// 0x" << std::hex << std::uppercase << end << "\n\n";
@@ -945,9 +1027,9 @@ void Companion::ProcessFile(YAML::Node root) {
                 }
             }
 
-            if (this->gConfig.exporterType == ExportType::Code && this->gIndividualIncludes) {
-                fs::path outinc = fs::path(this->gConfig.outputPath) / this->gCurrentDirectory.parent_path() /
-                    fs::relative(fs::path(result.name + ".inc.c"), this->gCurrentDirectory.parent_path());
+            if (this->gConfig.exporterType == ExportType::Code && ctx.individualIncludes) {
+                fs::path outinc = fs::path(this->gConfig.outputPath) / ctx.directory.parent_path() /
+                    fs::relative(fs::path(result.name + ".inc.c"), ctx.directory.parent_path());
 
                 if(!exists(outinc.parent_path())){
                     create_directories(outinc.parent_path());
@@ -955,8 +1037,14 @@ void Companion::ProcessFile(YAML::Node root) {
 
                 std::ofstream file(outinc, std::ios::binary);
 
-                if(!this->gFileHeader.empty()) {
-                    file << this->gFileHeader << std::endl;
+                if(!ctx.header.empty()) {
+                    file << ctx.header << std::endl;
+                }
+                if(auto entry = pending.find(result.name); entry != pending.end()) {
+                    auto& [key, manifest, written] = entry->second;
+                    manifest.output = outinc.string();
+                    manifest.start += ctx.header.empty() ? 0 : ctx.header.size() + 1;
+                    this->gManifest.Store(key, manifest);
                 }
                 file << stream.str();
                 stream.str("");
@@ -965,13 +1053,13 @@ void Companion::ProcessFile(YAML::Node root) {
             }
         }
 
-        this->gWriteMap.clear();
+        ctx.writeMap.clear();
 
-        if (this->gConfig.exporterType != ExportType::Code || !this->gIndividualIncludes) {
+        if (this->gConfig.exporterType != ExportType::Code || !ctx.individualIncludes) {
             std::string buffer = stream.str();
 
             if(buffer.empty()) {
-                SPDLOG_WARN("No data to write for {}", this->gCurrentFile);
+                SPDLOG_WARN("No data to write for {}", ctx.file);
                 return;
             }
 
@@ -982,39 +1070,549 @@ void Companion::ProcessFile(YAML::Node root) {
             }
 
             std::ofstream file(output, std::ios::binary);
-            SPDLOG_INFO("Writing {} to {}", this->gCurrentFile, output);
+            SPDLOG_INFO("Writing {} to {}", ctx.file, output);
 
+            std::ostringstream prefix;
             if(this->gConfig.exporterType == ExportType::Header) {
-                fs::path entryPath = this->gCurrentFile;
+                fs::path entryPath = ctx.file;
                 std::string symbol = entryPath.stem().string();
                 std::transform(symbol.begin(), symbol.end(), symbol.begin(), toupper);
                 if(this->IsOTRMode()){
-                    file << "#pragma once\n\n";
+                    prefix << "#pragma once\n\n";
                 } else {
-                    file << "#ifndef " << symbol << "_H" << std::endl;
-                    file << "#define " << symbol << "_H" << std::endl << std::endl;
+                    prefix << "#ifndef " << symbol << "_H" << std::endl;
+                    prefix << "#define " << symbol << "_H" << std::endl << std::endl;
+                }
+            }
+            if(!ctx.header.empty()) {
+                prefix << ctx.header << std::endl;
+            }
+
+            file << prefix.str() << buffer;
+            if(this->gConfig.exporterType == ExportType::Header && !this->IsOTRMode()){
+                file << std::endl << "#endif" << std::endl;
+            }
+
+            file.close();
+
+            for(auto& [name, entry] : pending) {
+                auto& [key, manifest, written] = entry;
+                if(!written) {
+                    continue;
+                }
+                manifest.output = output;
+                manifest.start += prefix.str().size();
+                this->gManifest.Store(key, manifest);
+            }
+        }
+    }
+
+    if(this->gConfig.exporterType != ExportType::Binary) {
+        if(!ctx.hashEntry.has_value()) {
+            std::lock_guard<std::mutex> lock(this->gHashMutex);
+            auto existing = this->gHashNode[RelativePathToSrcDir(ctx.file)];
+            ctx.hashEntry = existing ? YAML::Clone(existing) : YAML::Node();
+        }
+        (*ctx.hashEntry)["extracted"][ExportTypeToString(this->gConfig.exporterType)] = true;
+    }
+}
+
+// Exporters resolve pointers through the names of every asset of the file and its external files
+std::string Companion::GetSymbolTableHash(const YAML::Node& config) {
+    auto& ctx = GetCurrentContext();
+    std::ostringstream stream;
+    stream << this->gContextHash << "\n" << YAML::Dump(config) << "\n";
+
+    std::vector<std::string> files = { ctx.key };
+    files.insert(files.end(), ctx.externalFiles.begin(), ctx.externalFiles.end());
+
+    for(auto& file : files) {
+        auto addrMap = this->GetAddrMap(file);
+        if(addrMap == nullptr) {
+            continue;
+        }
+
+        std::map<uint32_t, AssetRef> sorted(addrMap->begin(), addrMap->end());
+        stream << file << "\n";
+        for(auto& [addr, asset] : sorted) {
+            stream << std::hex << addr << " " << asset->name << " " << asset->type << " " << asset->symbol.value_or("") << " " << asset->size.value_or(0) << "\n";
+            // Exporters also read the params of the assets they point into, e.g. the count of an overlapping vtx
+            stream << YAML::Dump(asset->node) << "\n";
+        }
+    }
+
+    const auto data = stream.str();
+    return CalculateHash(std::span(reinterpret_cast<const uint8_t*>(data.data()), data.size()));
+}
+
+void Companion::ProcessFileInContext(const std::string& path, const fs::path& directory, YAML::Node root, const std::shared_ptr<FileOutput>& output) {
+    FileContext ctx;
+    ctx.file = path;
+    ctx.key = NormalizePath(path);
+    ctx.directory = directory;
+    ctx.output = output;
+
+    if(this->gCurrentWrapper != nullptr && output->wrapper == nullptr) {
+        output->wrapper = std::make_shared<DeferredWrapper>();
+    }
+
+    const auto active = ctx.key;
+    auto previous = sCurrentContext;
+    sCurrentContext = &ctx;
+    sActiveFiles.insert(active);
+    try {
+        this->ProcessFile(root);
+    } catch (...) {
+        sCurrentContext = previous;
+        sActiveFiles.erase(active);
+        // Don't leave the workers waiting on this file hanging, the error is reported by this one
+        this->MarkFileCompleted(path);
+        throw;
+    }
+    sCurrentContext = previous;
+    sActiveFiles.erase(active);
+    this->MarkFileCompleted(path);
+
+    if(ctx.hashEntry.has_value()) {
+        output->hashes.emplace_back(RelativePathToSrcDir(path), ctx.hashEntry.value());
+    }
+
+    if(this->gConfig.lowMemory) {
+        this->ReleaseParseData(ctx);
+    }
+}
+
+// Parse results are only looked up by the file itself and the files listing it in external_files,
+// so they can go once the file and all of those are done
+void Companion::ReleaseParseData(const FileContext& ctx) {
+    std::vector<std::string> released;
+    {
+        std::lock_guard<std::mutex> lock(this->gFilesMutex);
+        this->gFinishedFiles.insert(ctx.key);
+        if(!this->gDependents.contains(ctx.key) || this->gDependents[ctx.key] == 0) {
+            released.push_back(ctx.key);
+        }
+
+        for(auto& external : ctx.externalFiles) {
+            const auto dependents = this->gDependents.find(external);
+            if(dependents == this->gDependents.end() || dependents->second == 0) {
+                continue;
+            }
+            if(--dependents->second == 0 && this->gFinishedFiles.contains(external)) {
+                released.push_back(external);
+            }
+        }
+
+        for(auto& file : released) {
+            this->gParseResults.erase(file);
+        }
+    }
+
+    for(auto& file : released) {
+        SPDLOG_DEBUG("Released parse results of {}", file);
+    }
+    Decompressor::TrimCache();
+}
+
+void Companion::CommitOutput(FileOutput& output) {
+    if(output.wrapper != nullptr) {
+        output.wrapper->Flush(this->gCurrentWrapper);
+        output.wrapper = nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(this->gHashMutex);
+    for(auto& [path, entry] : output.hashes) {
+        this->gHashNode[path] = entry;
+    }
+    output.hashes.clear();
+}
+
+// Decodes every compressed block referenced by the yamls up front on the pool, so the factories only hit the cache
+void Companion::PrefetchCompressedData(std::vector<std::tuple<std::string, fs::path, YAML::Node>>& files, size_t jobs) {
+    struct Block {
+        uint32_t offset;
+        CompressionType type;
+        // Size and alpha of tkmk00 textures
+        std::optional<std::tuple<uint32_t, uint32_t>> tkmk00;
+
+        auto operator<=>(const Block&) const = default;
+    };
+
+    const auto rom = this->GetRomData();
+    std::set<Block> blocks;
+
+    for(auto& [path, directory, root] : files) {
+        uint32_t segmentNumber = 0;
+        std::unordered_map<uint32_t, uint32_t> segments;
+
+        if(auto config = root[":config"]; config && config["segments"] && config["segments"].IsSequence()) {
+            for(auto segment : config["segments"]) {
+                if(!segment.IsSequence() || segment.size() != 2) {
+                    continue;
                 }
-                if(!this->gFileHeader.empty()) {
-                    file << this->gFileHeader << std::endl;
+                segments[segment[0].as<uint32_t>()] = segment[1].as<uint32_t>();
+            }
+
+            auto first = config["segments"][0];
+            if(first.IsSequence() && first.size() == 2 && !config["no_compression"]) {
+                segmentNumber = first[0].as<uint32_t>();
+                const auto offset = first[1].as<uint32_t>();
+                const auto type = offset < rom.size() ? Decompressor::GetCompressionType(rom, offset) : CompressionType::None;
+                if(type == CompressionType::MIO0 || type == CompressionType::YAY0 || type == CompressionType::YAY1) {
+                    blocks.insert({ offset, type });
                 }
-                file << buffer;
-                if(!this->IsOTRMode()){
-                    file << std::endl << "#endif" << std::endl;
+            }
+        }
+
+        // Same translation AutoDecode does, addresses relative to a vram can't be resolved before processing
+        const auto translate = [&](uint32_t offset) -> std::optional<uint32_t> {
+            if(!IS_SEGMENTED(offset)) {
+                if(segmentNumber == 0) {
+                    return std::nullopt;
                 }
-            } else {
-                if(!this->gFileHeader.empty()) {
-                    file << this->gFileHeader << std::endl;
+                offset = (segmentNumber << 24) | offset;
+            }
+
+            const auto segment = SEGMENT_NUMBER(offset);
+            if(segments.contains(segment)) {
+                return segments[segment] + SEGMENT_OFFSET(offset);
+            }
+            if(this->gConfig.segment.global.contains(segment)) {
+                return this->gConfig.segment.global.at(segment) + SEGMENT_OFFSET(offset);
+            }
+            return std::nullopt;
+        };
+
+        for(auto asset = root.begin(); asset != root.end(); ++asset) {
+            auto node = asset->second;
+            if(!node.IsMap() || !node["offset"] || (!node["mio0"] && !node["tkmk00"])) {
+                continue;
+            }
+
+            const auto offset = translate(node["offset"].as<uint32_t>());
+            if(!offset.has_value() || offset.value() >= rom.size()) {
+                continue;
+            }
+
+            if(node["mio0"]) {
+                blocks.insert({ offset.value(), CompressionType::MIO0 });
+            } else if(node["width"] && node["height"] && node["alpha"]) {
+                const auto size = node["width"].as<uint32_t>() * node["height"].as<uint32_t>() * 2;
+                blocks.insert({ offset.value(), CompressionType::None, std::make_tuple(size, node["alpha"].as<uint32_t>()) });
+            }
+        }
+    }
+
+    if(blocks.empty()) {
+        return;
+    }
+
+    SPDLOG_INFO("Prefetching {} compressed blocks with {} jobs", blocks.size(), jobs);
+
+    Torch::ThreadPool pool(std::min(jobs, blocks.size()));
+    std::vector<std::future<void>> pending;
+    for(const auto& block : blocks) {
+        pending.push_back(pool.Submit([rom, block] {
+            // Errors are left for the factory that actually uses the block to report
+            try {
+                if(block.tkmk00.has_value()) {
+                    const auto [size, alpha] = block.tkmk00.value();
+                    Decompressor::DecodeTKMK00(rom, block.offset, size, alpha);
+                } else {
+                    Decompressor::Decode(rom, block.offset, block.type);
                 }
-                file << buffer;
+            } catch (const std::exception& e) {
+                SPDLOG_DEBUG("Failed to prefetch block at 0x{:X}: {}", block.offset, e.what());
             }
+        }));
+    }
 
-            file.close();
+    for(auto& job : pending) {
+        job.wait();
+    }
+}
+
+void Companion::ProcessFiles(std::vector<std::tuple<std::string, fs::path, YAML::Node>>& files) {
+    size_t jobs = this->gConfig.jobs == 0 ? Torch::ThreadPool::DefaultSize() : this->gConfig.jobs;
+#ifdef __EMSCRIPTEN__
+    jobs = 1;
+#endif
+
+    // Prefetching would hold every compressed block of the rom in memory at once
+    if(jobs > 1 && this->gConfig.parseMode == ParseMode::Default && !this->gConfig.lowMemory) {
+        this->PrefetchCompressedData(files, jobs);
+    }
+
+    // External files outside the scanned list are scheduled too, so they end up in the group of the files
+    // that depend on them instead of being picked up by whichever worker gets to them first
+    {
+        std::unordered_set<std::string> known;
+        for(auto& [path, directory, root] : files) {
+            known.insert(NormalizePath(path));
+        }
+        for(size_t i = 0; i < files.size(); i++) {
+            auto root = std::get<2>(files[i]);
+            auto externals = root[":config"]["external_files"];
+            if(!externals || !externals.IsSequence()) {
+                continue;
+            }
+            for(auto external : externals) {
+                const auto path = (this->gSourceDirectory / external.as<std::string>()).string();
+                if(!fs::exists(path) || !known.insert(NormalizePath(path)).second) {
+                    continue;
+                }
+                auto directory = relative(fs::path(path), this->gAssetPath).replace_extension("");
+                files.emplace_back(path, directory, this->gDocuments.Get(path).root);
+            }
         }
     }
 
-    if(this->gConfig.exporterType != ExportType::Binary) {
-        this->gHashNode[RelativePathToSrcDir(this->gCurrentFile)]["extracted"][ExportTypeToString(this->gConfig.exporterType)] = true;
+    if(this->gConfig.lowMemory) {
+        for(auto& [path, directory, root] : files) {
+            if(auto externals = root[":config"]["external_files"]; externals && externals.IsSequence()) {
+                for(auto external : externals) {
+                    this->gDependents[NormalizePath((this->gSourceDirectory / external.as<std::string>()).string())]++;
+                }
+            }
+        }
+    }
+
+    if(jobs <= 1 || files.size() <= 1) {
+        for(auto& [path, directory, root] : files) {
+            if (!this->MarkFileProcessed(path)) {
+                continue;
+            }
+            auto output = std::make_shared<FileOutput>();
+            this->ProcessFileInContext(path, directory, root, output);
+            this->CommitOutput(*output);
+        }
+        return;
+    }
+
+    std::unordered_map<std::string, size_t> indices;
+    for(size_t i = 0; i < files.size(); i++) {
+        indices[NormalizePath(std::get<0>(files[i]))] = i;
+    }
+
+    // Files that depend on each other (external_files) or use factories with global state
+    // can't run concurrently, so they get merged into the same group
+    std::vector<size_t> groups(files.size());
+    std::vector<std::vector<size_t>> dependencies(files.size());
+    std::function<size_t(size_t)> find = [&](size_t i) {
+        return groups[i] == i ? i : groups[i] = find(groups[i]);
+    };
+    const auto merge = [&](size_t a, size_t b) {
+        groups[find(a)] = find(b);
+    };
+    std::optional<size_t> shared;
+
+    for(size_t i = 0; i < files.size(); i++) {
+        groups[i] = i;
+    }
+
+    for(size_t i = 0; i < files.size(); i++) {
+        auto& root = std::get<2>(files[i]);
+
+        if(auto externals = root[":config"]["external_files"]; externals && externals.IsSequence()) {
+            for(auto external : externals) {
+                auto dep = indices.find(NormalizePath((this->gSourceDirectory / external.as<std::string>()).string()));
+                if(dep != indices.end()) {
+                    dependencies[i].push_back(dep->second);
+                    merge(i, dep->second);
+                }
+            }
+        }
+
+        for(auto asset = root.begin(); asset != root.end(); ++asset) {
+            auto node = asset->second;
+            if(!node.IsMap() || !node["type"]) {
+                continue;
+            }
+
+            auto factory = this->GetFactory(GetTypeNode(node));
+            if(factory.has_value() && factory.value()->HasSharedState()) {
+                if(shared.has_value()) {
+                    merge(i, shared.value());
+                }
+                shared = i;
+                break;
+            }
+        }
+    }
+
+    // Dependencies first, then the order they were found on disk
+    std::vector<size_t> plan;
+    std::vector<bool> visited(files.size(), false);
+    std::function<void(size_t)> visit = [&](size_t i) {
+        if(visited[i]) {
+            return;
+        }
+        visited[i] = true;
+        for(auto dep : dependencies[i]) {
+            visit(dep);
+        }
+        plan.push_back(i);
+    };
+    for(size_t i = 0; i < files.size(); i++) {
+        visit(i);
+    }
+
+    std::map<size_t, std::vector<size_t>> planned;
+    for(size_t step = 0; step < plan.size(); step++) {
+        planned[find(plan[step])].push_back(step);
+    }
+
+    // Outputs are committed in plan order, so the archive and hash file don't depend on scheduling
+    std::vector<std::shared_ptr<FileOutput>> outputs(plan.size());
+    std::vector<bool> done(plan.size(), false);
+    std::mutex commitMutex;
+    size_t committed = 0;
+    std::atomic<bool> failed = false;
+    std::exception_ptr error = nullptr;
+
+    const auto commit = [&](size_t step, const std::shared_ptr<FileOutput>& output) {
+        std::lock_guard<std::mutex> lock(commitMutex);
+        outputs[step] = output;
+        done[step] = true;
+        while(committed < plan.size() && done[committed]) {
+            if(outputs[committed] != nullptr) {
+                this->CommitOutput(*outputs[committed]);
+                outputs[committed] = nullptr;
+            }
+            committed++;
+        }
+    };
+
+    SPDLOG_INFO("Processing {} files in {} groups with {} jobs", files.size(), planned.size(), jobs);
+
+    {
+        Torch::ThreadPool pool(std::min(jobs, planned.size()));
+        std::vector<std::future<void>> tasks;
+
+        for(auto& [group, steps] : planned) {
+            tasks.push_back(pool.Submit([&, steps = steps] {
+                for(auto step : steps) {
+                    std::shared_ptr<FileOutput> output;
+                    if(!failed) {
+                        auto& [path, directory, root] = files[plan[step]];
+                        try {
+                            if (this->MarkFileProcessed(path)) {
+                                output = std::make_shared<FileOutput>();
+                                this->ProcessFileInContext(path, directory, root, output);
+                            }
+                        } catch (...) {
+                            std::lock_guard<std::mutex> lock(commitMutex);
+                            if(error == nullptr) {
+                                error = std::current_exception();
+                            }
+                            failed = true;
+                            output = nullptr;
+                        }
+                    }
+                    commit(step, failed ? nullptr : output);
+                }
+            }));
+        }
+
+        for(auto& task : tasks) {
+            task.wait();
+        }
+    }
+
+    if(error != nullptr) {
+        std::rethrow_exception(error);
+    }
+}
+
+bool Companion::MarkFileProcessed(const std::string& file) {
+    std::lock_guard<std::mutex> lock(this->gFilesMutex);
+    return this->gProcessedFiles.insert(NormalizePath(file)).second;
+}
+
+void Companion::MarkFileCompleted(const std::string& file) {
+    {
+        std::lock_guard<std::mutex> lock(this->gFilesMutex);
+        this->gCompletedFiles.insert(NormalizePath(file));
     }
+    this->gFilesCompleted.notify_all();
+}
+
+void Companion::WaitForFile(const std::string& file) {
+    const auto key = NormalizePath(file);
+    std::unique_lock<std::mutex> lock(this->gFilesMutex);
+    this->gFilesCompleted.wait(lock, [&] {
+        return this->gCompletedFiles.contains(key);
+    });
+}
+
+AssetAddrMap* Companion::GetAddrMap(const std::string& key, bool create) {
+    std::lock_guard<std::mutex> lock(this->gFilesMutex);
+    if(create) {
+        return &this->gAddrMap[key];
+    }
+
+    const auto entry = this->gAddrMap.find(key);
+    return entry != this->gAddrMap.end() ? &entry->second : nullptr;
+}
+
+AssetRangeIndex* Companion::GetAssetRanges(const std::string& key, bool create) {
+    std::lock_guard<std::mutex> lock(this->gFilesMutex);
+    if(create) {
+        return &this->gAssetRanges[key];
+    }
+
+    const auto entry = this->gAssetRanges.find(key);
+    return entry != this->gAssetRanges.end() ? &entry->second : nullptr;
+}
+
+AssetRef Companion::CompileAsset(const std::string& name, YAML::Node& node) {
+    auto asset = std::make_shared<AssetDescriptor>();
+    asset->name = name;
+    asset->node = node;
+    asset->offset = GetNode<uint32_t>(node, "offset");
+    asset->symbol = GetNode<std::string>(node, "symbol");
+    asset->comment = GetNode<std::string>(node, "comment");
+    asset->autogen = node["autogen"].IsDefined();
+
+    if(node["type"]) {
+        asset->type = GetTypeNode(node);
+        if(const auto factory = this->GetFactory(asset->type); factory.has_value()) {
+            asset->factory = factory.value();
+        }
+    }
+
+    if(asset->factory != nullptr) {
+        asset->alignment = asset->factory->GetAlignment();
+        if(!asset->autogen) {
+            asset->size = asset->factory->GetAssetSize(node);
+        }
+    }
+    asset->alignment = GetSafeNode<uint32_t>(node, "alignment", asset->alignment);
+
+    return asset;
+}
+
+void Companion::IndexAssetRange(const std::string& key, const AssetRef& asset) {
+    this->GetAssetRanges(key, true)->Insert(asset);
+}
+
+ParseResults* Companion::GetParseResults(const std::string& key, bool create) {
+    std::lock_guard<std::mutex> lock(this->gFilesMutex);
+    if(create) {
+        return &this->gParseResults[key];
+    }
+
+    const auto entry = this->gParseResults.find(key);
+    return entry != this->gParseResults.end() ? &entry->second : nullptr;
+}
+
+BinaryWrapper* Companion::GetCurrentWrapper() {
+    auto& ctx = GetCurrentContext();
+    if(ctx.output != nullptr && ctx.output->wrapper != nullptr) {
+        return ctx.output->wrapper.get();
+    }
+
+    return this->gCurrentWrapper;
 }
 
 void Companion::Process() {
@@ -1027,18 +1625,17 @@ void Companion::Process() {
     }
 
     auto start = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
-    YAML::Node config = YAML::LoadFile(configPath.string());
+    const auto configDocument = this->gDocuments.Get(configPath);
+    YAML::Node config = configDocument.root;
 
     bool isDirectoryMode = config["mode"] && config["mode"].as<std::string>() == "directory";
 
     if(!isDirectoryMode) {
         if(this->gRomPath.has_value()){
-            std::ifstream input( this->gRomPath.value(), std::ios::binary );
-            this->gRomData = std::vector<uint8_t>( std::istreambuf_iterator( input ), {} );
-            input.close();
+            this->gRomFile = Torch::MappedFile(this->gRomPath.value());
         }
 
-        this->gCartridge = std::make_shared<N64::Cartridge>(this->gRomData);
+        this->gCartridge = std::make_shared<N64::Cartridge>(this->GetRomData());
         this->gCartridge->Initialize();
 
         if(!config[this->gCartridge->GetHash()]){
@@ -1065,8 +1662,8 @@ void Companion::Process() {
                 auto restart = GetSafeNode<bool>(item, "restart");
 
                 if (type == "DECOMPRESS") {
-                    this->gRomData = CompTool::Decompress(this->gRomData);
-                    this->gCartridge = std::make_shared<N64::Cartridge>(this->gRomData);
+                    this->gRomFile = Torch::MappedFile(CompTool::Decompress(this->GetRomData()));
+                    this->gCartridge = std::make_shared<N64::Cartridge>(this->GetRomData());
                     this->gCartridge->Initialize();
 
                     auto hash = this->gCartridge->GetHash();
@@ -1095,6 +1692,13 @@ void Companion::Process() {
         return;
     }
 
+    this->gConfig.lowMemory = GetSafeNode<bool>(cfg, "low_memory", false);
+
+    // Skips parsing the yamls that did not change since the last run
+    if(GetSafeNode<bool>(cfg, "yaml_cache", false)) {
+        this->gDocuments.LoadCompiled(this->gDestinationDirectory / ".torch" / "documents.bin");
+    }
+
     if (rom["metadata"]) {
         ProcessTables(rom);
     }
@@ -1104,6 +1708,7 @@ void Companion::Process() {
         for (int i = 0; i < segments.size(); i++) {
             this->gConfig.segment.global[i + 1] = segments[i];
         }
+        this->gConfig.segment.generation++;
     }
     this->gAssetPath = (this->gSourceDirectory / rom["path"].as<std::string>()).string();
     auto opath = cfg["output"];
@@ -1213,32 +1818,32 @@ void Companion::Process() {
 #endif
 
     if(cfg["logging"]){
-        auto level = cfg["logging"].as<std::string>();
-        if(level == "TRACE") {
-            spdlog::set_level(spdlog::level::trace);
-        } else if(level == "DEBUG") {
-            spdlog::set_level(spdlog::level::debug);
-        } else if(level == "INFO") {
-            spdlog::set_level(spdlog::level::info);
-        } else if(level == "WARN") {
-            spdlog::set_level(spdlog::level::warn);
-        } else if(level == "ERROR") {
-            spdlog::set_level(spdlog::level::err);
-        } else if(level == "CRITICAL") {
-            spdlog::set_level(spdlog::level::critical);
-        } else if(level == "OFF") {
-            spdlog::set_level(spdlog::level::off);
-        } else {
+        const auto level = Torch::Logging::ParseLevel(cfg["logging"].as<std::string>());
+        if(!level.has_value()) {
             throw std::runtime_error("Invalid logging level, please use TRACE, DEBUG, INFO, WARN, ERROR, CRITICAL or OFF");
         }
+        Torch::Logging::SetLevel(level.value());
     }
 
     this->gConfig.textureDefines = cfg["textures"] && (cfg["textures"].as<std::string>() == "ADDITIONAL_DEFINES");
 
+    {
+        std::ostringstream context;
+        context << configDocument.hash << "\n";
+        context << (this->gCartridge != nullptr ? this->gCartridge->GetHash() : "") << "\n";
+        context << static_cast<int>(this->gConfig.otrMode) << this->gConfig.debug << this->gConfig.textureDefines << "\n";
+        const auto data = context.str();
+        this->gContextHash = CalculateHash(std::span(reinterpret_cast<const uint8_t*>(data.data()), data.size()));
+    }
+
     this->ParseHash();
 
+    if(this->gConfig.parseMode == ParseMode::Default) {
+        Decompressor::SetCacheDirectory(this->gDestinationDirectory / ".torch" / "cache" / this->gCartridge->GetHash());
+    }
+
     SPDLOG_CRITICAL("------------------------------------------------");
-    spdlog::set_pattern(line);
+    Torch::Logging::UseLinePattern(true);
 
     SPDLOG_CRITICAL("Starting Torch...");
 
@@ -1265,7 +1870,7 @@ void Companion::Process() {
                 wrapper = new SWrapper(this->gConfig.outputPath);
                 break;
             case ArchiveType::O2R:
-                wrapper = new ZWrapper(this->gConfig.outputPath);
+                wrapper = new ZWrapper(this->gConfig.outputPath, this->gConfig.storeArchive);
                 break;
             default:
                 throw std::runtime_error("Invalid archive type for export type Binary");
@@ -1287,6 +1892,7 @@ void Companion::Process() {
         vWriter.Write((uint32_t) 0);
     }
 
+    std::vector<std::tuple<std::string, fs::path, YAML::Node>> files;
     for (const auto & entry : Torch::getRecursiveEntries(this->gAssetPath)){
         if(entry.is_directory())  {
             continue;
@@ -1302,16 +1908,12 @@ void Companion::Process() {
             continue;
         }
 
-        YAML::Node root = YAML::LoadFile(yamlPath);
-        this->gCurrentDirectory = relative(entry.path(), this->gAssetPath).replace_extension("");
-        this->gCurrentFile = yamlPath;
-
-        if (!this->gProcessedFiles.contains(this->gCurrentFile)) {
-            ProcessFile(root);
-            this->gProcessedFiles.insert(this->gCurrentFile);
-        }
+        auto directory = relative(entry.path(), this->gAssetPath).replace_extension("");
+        files.emplace_back(yamlPath, directory, this->gDocuments.Get(yamlPath).root);
     }
 
+    this->ProcessFiles(files);
+
     if(wrapper != nullptr) {
         // Add additional files specified by the user
         for (const auto& filePath : this->gAdditionalFiles) {
@@ -1320,7 +1922,7 @@ void Companion::Process() {
                 std::vector<char> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
                 input.close();
                 std::string filename = fs::path(filePath).filename().string();
-                wrapper->AddFile(filename, data);
+                wrapper->AddFile(filename, std::move(data));
                 SPDLOG_INFO("Added additional file: {}", filename);
             } else {
                 SPDLOG_WARN("Could not open additional file: {}", filePath);
@@ -1328,7 +1930,7 @@ void Companion::Process() {
         }
 
         SPDLOG_CRITICAL("Writing version file");
-        wrapper->AddFile("version", vWriter.ToVector());
+        wrapper->AddFile("version", vWriter.Release());
         vWriter.Close();
         wrapper->Close();
     }
@@ -1338,23 +1940,29 @@ void Companion::Process() {
     file << this->gHashNode;
     file.close();
 
+    if(this->gConfig.exporterType == ExportType::Code || this->gConfig.exporterType == ExportType::Header) {
+        this->gManifest.Save(this->gDestinationDirectory / "torch.manifest.bin");
+    }
+
+    this->gDocuments.SaveCompiled(this->gDestinationDirectory / ".torch" / "documents.bin");
+
     auto end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
     auto level = spdlog::get_level();
-    spdlog::set_level(spdlog::level::info);
+    Torch::Logging::SetLevel(spdlog::level::info);
     SPDLOG_CRITICAL("Done! Took {}ms", end.count() - start.count());
+    SPDLOG_CRITICAL("Peak memory: {} MiB", Torch::getPeakMemoryUsage() / (1024 * 1024));
     SPDLOG_CRITICAL("------------------------------------------------");
-    spdlog::set_level(level);
-    spdlog::set_pattern(regular);
+    Torch::Logging::SetLevel(level);
+    Torch::Logging::UseLinePattern(false);
 
     Decompressor::ClearCache();
     this->gCartridge = nullptr;
     Instance = nullptr;
 }
 
-void Companion::Pack(const std::string& folder, const std::string& output, const ArchiveType otrMode) {
+void Companion::Pack(const std::string& folder, const std::string& output, const ArchiveType otrMode, const bool store) {
 
-    spdlog::set_level(spdlog::level::debug);
-    spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] %v");
+    Torch::Logging::Init();
 
     SPDLOG_CRITICAL("------------------------------------------------");
 
@@ -1362,18 +1970,6 @@ void Companion::Pack(const std::string& folder, const std::string& output, const
     SPDLOG_CRITICAL("Scanning {}", folder);
 
     auto start = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
-    std::unordered_map<std::string, std::vector<char>> files;
-
-    for (const auto & entry : Torch::getRecursiveEntries(folder)){
-        if(entry.is_directory())  {
-            continue;
-        }
-
-        std::ifstream input( entry.path(), std::ios::binary );
-        auto data = std::vector( std::istreambuf_iterator( input ), {} );
-        input.close();
-        files[entry.path().generic_string()] = data;
-    }
 
     std::unique_ptr<BinaryWrapper> wrapper;
     switch (otrMode) {
@@ -1381,26 +1977,37 @@ void Companion::Pack(const std::string& folder, const std::string& output, const
             wrapper.reset(new SWrapper(output));
             break;
         case ArchiveType::O2R:
-            wrapper.reset(new ZWrapper(output));
+            wrapper.reset(new ZWrapper(output, store));
             break;
         default:
             throw std::runtime_error("Invalid archive type for export type Binary");
     }
     wrapper->CreateArchive();
 
-    for(auto& [path, data] : files){
-        std::string normalized = path;
+    // Files are read one at a time, the archive only keeps a bounded number of them in flight while compressing
+    for (const auto & entry : Torch::getRecursiveEntries(folder)){
+        if(entry.is_directory())  {
+            continue;
+        }
+
+        std::string normalized = entry.path().generic_string();
         std::replace(normalized.begin(), normalized.end(), '\\', '/');
         // Remove parent folder
         normalized = normalized.substr(folder.length() + 1);
-        wrapper->AddFile(normalized, data);
+
+        std::ifstream input(entry.path(), std::ios::binary | std::ios::ate);
+        std::vector<char> data(static_cast<size_t>(input.tellg()));
+        input.seekg(0, std::ios::beg);
+        input.read(data.data(), static_cast<std::streamsize>(data.size()));
+        input.close();
+
+        wrapper->AddFile(normalized, std::move(data));
         SPDLOG_CRITICAL("> Added {}", normalized);
     }
 
     auto end = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
     SPDLOG_CRITICAL("Done! Took {}ms", end.count() - start.count());
     SPDLOG_CRITICAL("Exported to {}", output);
-    spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] %v");
     SPDLOG_CRITICAL("------------------------------------------------");
 
     wrapper->Close();
@@ -1411,18 +2018,19 @@ std::optional<std::tuple<std::string, YAML::Node>> Companion::RegisterAsset(cons
         return std::nullopt;
     }
 
-    auto output = (this->gCurrentDirectory / name).string();
+    auto& ctx = GetCurrentContext();
+    auto output = (ctx.directory / name).string();
     std::replace(output.begin(), output.end(), '\\', '/');
 
-    auto entry = std::make_tuple(output, node);
-    this->gAddrMap[this->gCurrentFile][node["offset"].as<uint32_t>()] = entry;
+    const auto asset = this->CompileAsset(output, node);
+    (*this->GetAddrMap(ctx.key, true))[asset->offset.value()] = asset;
+    this->IndexAssetRange(ctx.key, asset);
+    auto entry = asset->ToTuple();
     auto dResult = this->ParseNode(node, output);
     if(dResult.has_value()) {
-        this->gParseResults[this->gCurrentFile].push_back(dResult.value());
+        this->GetParseResults(ctx.key, true)->Add(dResult.value());
     }
-    spdlog::set_pattern(regular);
-    SPDLOG_INFO("------------------------------------------------");
-    spdlog::set_pattern(line);
+    SPDLOG_LOGGER_INFO(Torch::Logging::Plain(), "------------------------------------------------");
 
     return entry;
 }
@@ -1433,15 +2041,16 @@ void Companion::RegisterFactory(const std::string& type, const std::shared_ptr<B
 }
 
 std::optional<std::shared_ptr<BaseFactory>> Companion::GetFactory(const std::string &type) {
-    if(!this->gFactories.contains(type)){
+    const auto factory = this->gFactories.find(type);
+    if(factory == this->gFactories.end()){
         return std::nullopt;
     }
 
-    return this->gFactories[type];
+    return factory->second;
 }
 
 std::optional<Table> Companion::SearchTable(uint32_t addr){
-    for(auto& table : this->gTables){
+    for(auto& table : GetCurrentContext().tables){
         if(addr >= table.start && addr <= table.end){
             return table;
         }
@@ -1451,202 +2060,232 @@ std::optional<Table> Companion::SearchTable(uint32_t addr){
 }
 
 std::optional<std::string> Companion::GetEnumFromValue(const std::string& key, int32_t id) {
-    if(!this->gEnums.contains(key)){
+    const auto entries = this->gEnums.find(key);
+    if(entries == this->gEnums.end()){
         return std::nullopt;
     }
 
-    if(!this->gEnums[key].contains(id)){
+    const auto entry = entries->second.find(id);
+    if(entry == entries->second.end()){
         return std::nullopt;
     }
 
-    return this->gEnums[key][id];
+    return entry->second;
 }
 
 std::optional<std::uint32_t> Companion::GetFileOffsetFromSegmentedAddr(const uint8_t segment) const {
 
-    auto segments = this->gConfig.segment;
+    auto& ctx = GetCurrentContext();
+
+    if(segment < SegmentTable::Size) {
+        auto& table = ctx.segmentTable;
+        if(table.generation != this->gConfig.segment.generation) {
+            this->ResolveSegments(ctx);
+        }
+
+        if(!(table.present & (1u << segment))) {
+            return std::nullopt;
+        }
+
+        return table.offsets[segment];
+    }
 
-    if(segments.temporal.contains(segment)) {
-        return segments.temporal[segment];
+    if(ctx.temporalSegments.contains(segment)) {
+        return ctx.temporalSegments[segment];
     }
 
-    if(segments.local.contains(segment)) {
-        return segments.local[segment];
+    if(ctx.localSegments.contains(segment)) {
+        return ctx.localSegments[segment];
     }
 
-    if(segments.global.contains(segment)) {
-        return segments.global[segment];
+    if(this->gConfig.segment.global.contains(segment)) {
+        return this->gConfig.segment.global.at(segment);
     }
 
     return std::nullopt;
 }
 
+void Companion::ResolveSegments(FileContext& ctx) const {
+    auto& table = ctx.segmentTable;
+    table.offsets.fill(0);
+    table.present = 0;
+
+    // Lowest priority first, so local segments replace global ones and temporal ones replace both
+    const std::unordered_map<uint32_t, uint32_t>* layers[] = { &this->gConfig.segment.global, &ctx.localSegments, &ctx.temporalSegments };
+    for(const auto* segments : layers) {
+        for(const auto& [id, offset] : *segments) {
+            if(id < SegmentTable::Size) {
+                table.offsets[id] = offset;
+                table.present |= 1u << id;
+            }
+        }
+    }
+
+    table.generation = this->gConfig.segment.generation;
+}
+
 uint32_t Companion::PatchVirtualAddr(uint32_t addr) {
     if (addr & 0x80000000) {
-        if (gVirtualAddrMap.contains(gCurrentFile)) {
-            addr -= std::get<0>(gVirtualAddrMap[gCurrentFile]);
-            addr += std::get<1>(gVirtualAddrMap[gCurrentFile]);
+        auto& ctx = GetCurrentContext();
+        if (ctx.virtualAddr.has_value()) {
+            addr -= std::get<0>(ctx.virtualAddr.value());
+            addr += std::get<1>(ctx.virtualAddr.value());
         }
     }
 
     return addr;
 }
 
-std::optional<std::tuple<std::string, YAML::Node>> Companion::GetNodeByAddr(uint32_t addr){
-    if(!this->gAddrMap.contains(this->gCurrentFile)){
-        return std::nullopt;
+AssetRef Companion::GetAssetByAddr(uint32_t addr) {
+    auto& ctx = GetCurrentContext();
+    auto addrMap = this->GetAddrMap(ctx.key);
+    if(addrMap == nullptr){
+        return nullptr;
     }
 
     // HACK: Adjust address to rom address if virtual address
     addr = PatchVirtualAddr(addr);
 
-    if(!this->gAddrMap[this->gCurrentFile].contains(addr)){
-        for (auto &file : this->gCurrentExternalFiles) {
-            if (!this->gAddrMap.contains(file)) {
-                SPDLOG_WARN("GetNodeByAddr: External File {} Not Found.", file);
-                continue;
-            }
+    if(const auto entry = addrMap->find(addr); entry != addrMap->end()) {
+        return entry->second;
+    }
 
-            if (!this->gAddrMap[file].contains(addr)) {
-                continue;
-            }
-            return this->gAddrMap[file][addr];
+    for (auto &file : ctx.externalFiles) {
+        auto externalMap = this->GetAddrMap(file);
+        if (externalMap == nullptr) {
+            SPDLOG_WARN("GetNodeByAddr: External File {} Not Found.", file);
+            continue;
+        }
+
+        if(const auto entry = externalMap->find(addr); entry != externalMap->end()) {
+            return entry->second;
         }
+    }
+
+    return nullptr;
+}
+
+std::optional<std::tuple<std::string, YAML::Node>> Companion::GetNodeByAddr(uint32_t addr){
+    const auto asset = this->GetAssetByAddr(addr);
+    if(asset == nullptr) {
         return std::nullopt;
     }
 
-    return this->gAddrMap[this->gCurrentFile][addr];
+    return asset->ToTuple();
 }
 
 std::optional<std::string> Companion::GetStringByAddr(const uint32_t addr) {
-    if(this->gManualSegments.contains(addr)) {
-        return this->gManualSegments[addr];
+    auto& manualSegments = GetCurrentContext().manualSegments;
+    if(manualSegments.contains(addr)) {
+        return manualSegments[addr];
     }
 
-    auto node = this->GetNodeByAddr(addr);
+    const auto asset = this->GetAssetByAddr(addr);
 
-    if(!node.has_value()) {
+    if(asset == nullptr) {
         return std::nullopt;
     }
 
-    return std::get<0>(node.value());
+    return asset->name;
 }
 
-std::optional<std::tuple<std::string, YAML::Node>> Companion::GetSafeNodeByAddr(const uint32_t addr, std::string type) {
-    auto node = this->GetNodeByAddr(addr);
+AssetRef Companion::GetSafeAssetByAddr(const uint32_t addr, const std::string& type) {
+    auto asset = this->GetAssetByAddr(addr);
 
-    if(!node.has_value()) {
-        return std::nullopt;
+    if(asset != nullptr && asset->type != type) {
+        throw std::runtime_error("Requested node type does not match with the target node type at " + Torch::to_hex(addr, false) + " Found: " + asset->type + " Expected: " + type);
     }
 
-    auto [name, n] = node.value();
-    auto n_type = GetTypeNode(n);
+    return asset;
+}
+
+std::optional<std::tuple<std::string, YAML::Node>> Companion::GetSafeNodeByAddr(const uint32_t addr, std::string type) {
+    const auto asset = this->GetSafeAssetByAddr(addr, type);
 
-    if(n_type != type) {
-        throw std::runtime_error("Requested node type does not match with the target node type at " + Torch::to_hex(addr, false) + " Found: " + n_type + " Expected: " + type);
+    if(asset == nullptr) {
+        return std::nullopt;
     }
 
-    return node;
+    return asset->ToTuple();
 
 }
 
 std::optional<std::string> Companion::GetSafeStringByAddr(const uint32_t addr, std::string type) {
-    if(this->gManualSegments.contains(addr)) {
-        return this->gManualSegments[addr];
+    auto& manualSegments = GetCurrentContext().manualSegments;
+    if(manualSegments.contains(addr)) {
+        return manualSegments[addr];
     }
 
-    auto node = this->GetNodeByAddr(addr);
+    const auto asset = this->GetSafeAssetByAddr(addr, type);
 
-    if(!node.has_value()) {
+    if(asset == nullptr) {
         return std::nullopt;
     }
 
-    auto [name, n] = node.value();
-    auto n_type = GetTypeNode(n);
-
-    if(n_type != type) {
-        throw std::runtime_error("Requested node type does not match with the target node type at " + Torch::to_hex(addr, false) + " Found: " + n_type + " Expected: " + type);
-    }
-
-    return std::get<0>(node.value());
+    return asset->name;
 }
 
 std::string Companion::GetSymbolFromAddr(uint32_t address, bool validZero) {
-    auto dec = Companion::Instance->GetNodeByAddr(address);
-    std::ostringstream outSymbol;
-
     if(address == 0 && !validZero) {
-        outSymbol << "NULL";
-    } else if (dec.has_value()) {
-        auto node = std::get<1>(dec.value());
-        auto symbol = GetSafeNode<std::string>(node, "symbol");
-        outSymbol << "&" << symbol;
-    } else {
-        outSymbol << "0x" << std::uppercase << std::hex << address;
+        return "NULL";
     }
 
+    const auto asset = Companion::Instance->GetAssetByAddr(address);
+
+    if (asset != nullptr) {
+        return "&" + asset->GetSymbol();
+    }
+
+    std::ostringstream outSymbol;
+    outSymbol << "0x" << std::uppercase << std::hex << address;
     return outSymbol.str();
 }
 
 std::optional<ParseResultData> Companion::GetParseDataByAddr(uint32_t addr) {
-    if(!this->gParseResults.contains(this->gCurrentFile)){
-        for (auto &file : this->gCurrentExternalFiles) {
-            if (!this->gParseResults.contains(file)) {
+    auto& ctx = GetCurrentContext();
+    auto results = this->GetParseResults(ctx.key);
+    if(results == nullptr){
+        for (auto &file : ctx.externalFiles) {
+            auto externalResults = this->GetParseResults(file);
+            if (externalResults == nullptr) {
                 SPDLOG_INFO("GetParseDataByAddr: External File {} Not Found.", file);
                 continue;
             }
 
-            for (auto& result : this->gParseResults[file]){
-                if (result.data.has_value() && result.GetOffset() == addr){
-                    return result;
-                }
+            if (auto result = externalResults->FindByAddr(addr)) {
+                return result;
             }
         }
         return std::nullopt;
     }
 
-    for(auto& result : this->gParseResults[this->gCurrentFile]){
-        if(result.data.has_value() && result.GetOffset() == addr){
-            return result;
-        }
-    }
-
-    return std::nullopt;
+    return results->FindByAddr(addr);
 }
 
 std::optional<ParseResultData> Companion::GetParseDataBySymbol(const std::string& symbol) {
-    if(!this->gParseResults.contains(this->gCurrentFile)){
+    auto results = this->GetParseResults(GetCurrentContext().key);
+    if(results == nullptr){
         return std::nullopt;
     }
 
-    for(auto& result : this->gParseResults[this->gCurrentFile]){
-        auto sym = GetNode<std::string>(result.node, "symbol");
-
-        if(result.data.has_value() && sym.has_value() && sym.value() == symbol){
-            return result;
-        }
-    }
-
-    return std::nullopt;
-
+    return results->FindBySymbol(symbol);
 }
 
 std::optional<std::vector<std::tuple<std::string, YAML::Node>>> Companion::GetNodesByType(const std::string& type){
     std::vector<std::tuple<std::string, YAML::Node>> nodes;
 
-    if(!this->gAddrMap.contains(this->gCurrentFile)){
+    auto addrMap = this->GetAddrMap(GetCurrentContext().key);
+    if(addrMap == nullptr){
         return nodes;
     }
 
-    for(auto& [addr, tpl] : this->gAddrMap[this->gCurrentFile]){
-        auto [name, node] = tpl;
-        const auto n_type = GetTypeNode(node);
-        if(node["autogen"]){
-            SPDLOG_DEBUG("Skipping autogenerated asset {}", name);
+    for(auto& [addr, asset] : *addrMap){
+        if(asset->autogen){
+            SPDLOG_DEBUG("Skipping autogenerated asset {}", asset->name);
             continue;
         }
-        if(n_type == type){
-            nodes.push_back(tpl);
+        if(asset->type == type){
+            nodes.push_back(asset->ToTuple());
         }
     }
 
@@ -1654,13 +2293,22 @@ std::optional<std::vector<std::tuple<std::string, YAML::Node>>> Companion::GetNo
 
 }
 
+AssetRef Companion::GetAssetContainingAddr(const std::string& type, uint32_t addr) {
+    auto ranges = this->GetAssetRanges(GetCurrentContext().key);
+    if(ranges == nullptr){
+        return nullptr;
+    }
+
+    return ranges->Find(type, addr);
+}
+
 void Companion::RegisterCompanionFile(const std::string path, std::vector<char> data) {
-    this->gCompanionFiles[path] = data;
+    GetCurrentContext().companionFiles[path] = std::move(data);
     SPDLOG_TRACE("Registered companion file {}", path);
 }
 
 std::string Companion::NormalizeAsset(const std::string& name) const {
-    auto path = fs::path(this->gCurrentFile).stem().string() + "_" + name;
+    auto path = fs::path(GetCurrentContext().file).stem().string() + "_" + name;
     return path;
 }
 
@@ -1670,7 +2318,7 @@ static std::string& ConvertWinToUnixSlash(std::string& path) {
 }
 
 std::string Companion::RelativePath(const std::string& path) const {
-    std::string doutput = (this->gCurrentDirectory / path).string();
+    std::string doutput = (GetCurrentContext().directory / path).string();
     ConvertWinToUnixSlash(doutput);
     return doutput;
 }
@@ -1687,8 +2335,8 @@ std::string Companion::RelativePathToSrcDir(const std::string& path) const {
     return doutput;
 }
 
-std::string Companion::CalculateHash(const std::vector<uint8_t>& data) {
-    return Chocobo1::SHA1().addData(data).finalize().toString();
+std::string Companion::CalculateHash(std::span<const uint8_t> data) {
+    return Chocobo1::SHA1().addData(data.data(), data.size()).finalize().toString();
 }
 
 std::optional<YAML::Node> Companion::AddAsset(YAML::Node asset) {
@@ -1710,7 +2358,6 @@ std::optional<YAML::Node> Companion::AddAsset(YAML::Node asset) {
         }
     }
 
-    auto rom = this->GetRomData();
     auto factory = this->GetFactory(type);
 
     if(!factory.has_value()) {
@@ -1735,8 +2382,8 @@ std::optional<YAML::Node> Companion::AddAsset(YAML::Node asset) {
 
     auto result = this->RegisterAsset(output, asset);
 
-    if(!gCurrentVirtualPath.empty()) {
-        asset["path"] = gCurrentVirtualPath;
+    if(auto& virtualPath = GetCurrentContext().virtualPath; !virtualPath.empty()) {
+        asset["path"] = virtualPath;
     }
 
     if(result.has_value()){
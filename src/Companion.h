@@ -8,12 +8,22 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <variant>
+#include <mutex>
+#include <condition_variable>
+#include <map>
+#include <array>
 #include "factories/BaseFactory.h"
 #include "n64/Cartridge.h"
 #include "utils/Decompressor.h"
+#include "utils/MappedFile.h"
+#include "utils/AssetDescriptor.h"
+#include "utils/AssetRangeIndex.h"
+#include "utils/AssetManifest.h"
+#include "utils/DocumentCache.h"
 #include "factories/TextureFactory.h"
 
 class BinaryWrapper;
+class DeferredWrapper;
 namespace fs = std::filesystem;
 
 enum class ParseMode {
@@ -48,8 +58,21 @@ enum class ArchiveType {
 
 struct SegmentConfig {
     std::unordered_map<uint32_t, uint32_t> global;
-    std::unordered_map<uint32_t, uint32_t> local;
-    std::unordered_map<uint32_t, uint32_t> temporal;
+    // Bumped whenever global changes, so every file context knows to resolve its table again
+    uint32_t generation = 1;
+};
+
+/*
+ * Segments 0x00-0x1F resolved to file offsets, with the temporal, local and global segments
+ * of a file context already merged in priority order. Rebuilt lazily when any of them change.
+ */
+struct SegmentTable {
+    static constexpr uint32_t Size = 0x20;
+
+    std::array<uint32_t, Size> offsets = {};
+    uint32_t present = 0;
+    // 0 marks the table as stale
+    uint32_t generation = 0;
 };
 
 struct Table {
@@ -91,6 +114,10 @@ struct TorchConfig {
     bool debug;
     bool modding;
     bool textureDefines;
+    bool storeArchive = false;
+    // Drops parse results once nothing can look them up anymore
+    bool lowMemory = false;
+    uint32_t jobs = 1;
 };
 
 struct ParseResultData {
@@ -98,16 +125,96 @@ struct ParseResultData {
     std::string type;
     YAML::Node node;
     std::optional<std::shared_ptr<IParsedData>> data;
+    AssetRef asset;
 
     uint32_t GetOffset() {
-        return GetSafeNode<uint32_t>(node, "offset");
+        if(!asset->offset.has_value()) {
+            return GetSafeNode<uint32_t>(node, "offset");
+        }
+        return asset->offset.value();
     }
 
     std::optional<std::string> GetSymbol() {
-        return GetSafeNode<std::string>(node, "symbol");
+        if(!asset->symbol.has_value()) {
+            return GetSafeNode<std::string>(node, "symbol");
+        }
+        return asset->symbol;
+    }
+};
+
+// Parse results of a yaml file in the order they were parsed, indexed by address and symbol
+struct ParseResults {
+    std::vector<ParseResultData> entries;
+    std::unordered_map<uint32_t, size_t> addrs;
+    std::unordered_map<std::string, size_t> symbols;
+
+    // Only results with data can be looked up, the first one registered for an address or symbol wins
+    void Add(const ParseResultData& result) {
+        const auto index = entries.size();
+        entries.push_back(result);
+        if(!result.data.has_value()) {
+            return;
+        }
+        if(result.asset->offset.has_value()) {
+            addrs.try_emplace(result.asset->offset.value(), index);
+        }
+        if(result.asset->symbol.has_value()) {
+            symbols.try_emplace(result.asset->symbol.value(), index);
+        }
+    }
+
+    std::optional<ParseResultData> FindByAddr(uint32_t addr) const {
+        const auto it = addrs.find(addr);
+        return it != addrs.end() ? std::optional(entries[it->second]) : std::nullopt;
+    }
+
+    std::optional<ParseResultData> FindBySymbol(const std::string& symbol) const {
+        const auto it = symbols.find(symbol);
+        return it != symbols.end() ? std::optional(entries[it->second]) : std::nullopt;
     }
 };
 
+/*
+ * Everything that is only valid while a yaml file is being processed.
+ * Each file gets its own context, so files can be processed in parallel.
+ */
+struct FileOutput {
+    std::shared_ptr<DeferredWrapper> wrapper;
+    std::vector<std::tuple<std::string, YAML::Node>> hashes;
+};
+
+struct FileContext {
+    std::string file;
+    // Normalized path, what the per file maps are keyed by
+    std::string key;
+    fs::path directory;
+    std::string virtualPath;
+    std::string header;
+    std::string hash;
+    std::optional<YAML::Node> hashEntry;
+    bool enablePadGen = false;
+    bool forceProcessing = false;
+    bool individualIncludes = false;
+    uint32_t pad = 0;
+    uint32_t fileOffset = 0;
+    uint32_t segmentNumber = 0;
+    std::optional<VRAMEntry> vram;
+    std::optional<std::tuple<uint32_t, uint32_t>> virtualAddr;
+    CompressionType compressionType = CompressionType::None;
+    std::vector<Table> tables;
+    std::vector<std::string> externalFiles;
+    std::unordered_map<int, std::string> manualSegments;
+    std::unordered_map<uint32_t, uint32_t> localSegments;
+    std::unordered_map<uint32_t, uint32_t> temporalSegments;
+    SegmentTable segmentTable;
+    std::unordered_map<std::string, std::vector<char>> companionFiles;
+    std::map<std::string, std::vector<WriteEntry>> writeMap;
+    std::unordered_set<uint32_t> vtxOverlaps;
+    // Descriptor of the asset being exported, exporters read the common fields from it instead of the node
+    AssetRef asset;
+    std::shared_ptr<FileOutput> output;
+};
+
 class Companion {
 public:
     static Companion* Instance;
@@ -125,7 +232,7 @@ public:
     explicit Companion(std::vector<uint8_t> rom, const ArchiveType otr, const bool debug, const bool modding = false,
                        const std::string& srcDir = "", const std::string& destPath = "") : gCartridge(nullptr),
                        gSourceDirectory(srcDir), gDestinationDirectory(destPath) {
-        this->gRomData = rom;
+        this->gRomFile = Torch::MappedFile(std::move(rom));
         this->gConfig.otrMode = otr;
         this->gConfig.debug = debug;
         this->gConfig.modding = modding;
@@ -147,9 +254,11 @@ public:
     bool IsOTRMode() const { return (this->gConfig.otrMode != ArchiveType::None); }
     bool IsDebug() const { return this->gConfig.debug; }
     bool AddTextureDefines() const { return this->gConfig.textureDefines; }
+    void SetJobs(const uint32_t jobs) { this->gConfig.jobs = jobs; }
+    void SetStoreArchive(const bool store) { this->gConfig.storeArchive = store; }
 
     N64::Cartridge* GetCartridge() const { return this->gCartridge.get(); }
-    std::vector<uint8_t>& GetRomData() { return this->gRomData; }
+    std::span<uint8_t> GetRomData() { return this->gRomFile.GetData(); }
     std::string GetOutputPath() { return this->gConfig.outputPath; }
     std::string GetDestRelativeOutputPath() { return RelativePathToDestDir(GetOutputPath()); }
 
@@ -157,7 +266,7 @@ public:
     GBIMinorVersion GetGBIMinorVersion() const { return  this->gConfig.gbi.subversion; }
     std::unordered_map<std::string, std::vector<YAML::Node>> GetCourseMetadata() { return this->gCourseMetadata; }
     std::optional<std::string> GetEnumFromValue(const std::string& key, int id);
-    bool IsUsingIndividualIncludes() const { return this->gIndividualIncludes; }
+    bool IsUsingIndividualIncludes() const { return GetCurrentContext().individualIncludes; }
 
     std::optional<ParseResultData> GetParseDataByAddr(uint32_t addr);
     std::optional<ParseResultData> GetParseDataBySymbol(const std::string& symbol);
@@ -165,21 +274,27 @@ public:
     std::optional<std::uint32_t> GetFileOffsetFromSegmentedAddr(uint8_t segment) const;
     std::optional<std::shared_ptr<BaseFactory>> GetFactory(const std::string& type);
     uint32_t PatchVirtualAddr(uint32_t addr);
+    AssetRef GetAssetByAddr(uint32_t addr);
+    // Same as GetAssetByAddr, but throws when the asset found is not of the given type
+    AssetRef GetSafeAssetByAddr(uint32_t addr, const std::string& type);
     std::optional<std::tuple<std::string, YAML::Node>> GetNodeByAddr(uint32_t addr);
     std::optional<std::string> GetStringByAddr(uint32_t addr);
     std::optional<std::tuple<std::string, YAML::Node>> GetSafeNodeByAddr(const uint32_t addr, std::string type);
     std::optional<std::string> GetSafeStringByAddr(const uint32_t addr, std::string type);
     std::optional<std::vector<std::tuple<std::string, YAML::Node>>> GetNodesByType(const std::string& type);
+    AssetRef GetAssetContainingAddr(const std::string& type, uint32_t addr);
     std::string GetSymbolFromAddr(uint32_t addr, bool validZero = false);
 
-    std::optional<std::uint32_t> GetFileOffset(void) const { return this->gCurrentFileOffset; };
-    std::optional<std::uint32_t> GetCurrSegmentNumber(void) const { return this->gCurrentSegmentNumber; };
-    CompressionType GetCurrCompressionType(void) const { return this->gCurrentCompressionType; };
-    std::optional<VRAMEntry> GetCurrentVRAM(void) const { return this->gCurrentVram; };
+    std::optional<std::uint32_t> GetFileOffset(void) const { return GetCurrentContext().fileOffset; };
+    std::optional<std::uint32_t> GetCurrSegmentNumber(void) const { return GetCurrentContext().segmentNumber; };
+    CompressionType GetCurrCompressionType(void) const { return GetCurrentContext().compressionType; };
+    std::optional<VRAMEntry> GetCurrentVRAM(void) const { return GetCurrentContext().vram; };
+    const AssetRef& GetCurrentAsset(void) const { return GetCurrentContext().asset; };
+    static FileContext& GetCurrentContext();
     std::optional<Table> SearchTable(uint32_t addr);
 
-    static std::string CalculateHash(const std::vector<uint8_t>& data);
-    static void Pack(const std::string& folder, const std::string& output, const ArchiveType otrMode);
+    static std::string CalculateHash(std::span<const uint8_t> data);
+    static void Pack(const std::string& folder, const std::string& output, const ArchiveType otrMode, const bool store = false);
     std::string NormalizeAsset(const std::string& name) const;
     std::string RelativePath(const std::string& path) const;
     std::string RelativePathToSrcDir(const std::string& path) const;
@@ -188,7 +303,7 @@ public:
     void SetAdditionalFiles(const std::vector<std::string>& files) { this->gAdditionalFiles = files; }
 
     TorchConfig& GetConfig() { return this->gConfig; }
-    BinaryWrapper* GetCurrentWrapper() { return this->gCurrentWrapper; }
+    BinaryWrapper* GetCurrentWrapper();
 
     std::optional<std::tuple<std::string, YAML::Node>> RegisterAsset(const std::string& name, YAML::Node& node);
     std::optional<YAML::Node> AddAsset(YAML::Node asset);
@@ -197,48 +312,59 @@ private:
     YAML::Node gModdingConfig;
     fs::path gSourceDirectory;
     fs::path gDestinationDirectory;
-    fs::path gCurrentDirectory;
-    std::string gCurrentHash;
     std::string gAssetPath;
-    std::vector<uint8_t> gRomData;
+    Torch::MappedFile gRomFile;
     std::optional<std::filesystem::path> gRomPath;
-    bool gNodeForceProcessing = false;
-    bool gIndividualIncludes = false;
     YAML::Node gHashNode;
+    // Fingerprint of everything besides the yamls that affects the output (rom, config.yml, flags)
+    std::string gContextHash;
+    AssetManifest gManifest;
+    DocumentCache gDocuments;
     std::shared_ptr<N64::Cartridge> gCartridge;
     std::unordered_map<std::string, std::vector<YAML::Node>> gCourseMetadata;
     std::unordered_map<std::string, std::unordered_map<int32_t, std::string>> gEnums;
-    BinaryWrapper* gCurrentWrapper;
-
-    // Temporal Variables
-    std::string gCurrentFile;
-    std::string gCurrentVirtualPath;
-    std::string gFileHeader;
-    bool gEnablePadGen = false;
-    uint32_t gCurrentPad = 0;
-    uint32_t gCurrentFileOffset;
-    uint32_t gCurrentSegmentNumber;
-    std::optional<VRAMEntry> gCurrentVram;
-    CompressionType gCurrentCompressionType = CompressionType::None;
-    std::vector<Table> gTables;
-    std::vector<std::string> gCurrentExternalFiles;
-    std::unordered_map<int, std::string> gManualSegments;
-    std::unordered_set<std::string> gProcessedFiles;
+    BinaryWrapper* gCurrentWrapper = nullptr;
 
-    std::unordered_map<std::string, std::vector<char>> gCompanionFiles;
-    std::unordered_map<std::string, std::vector<ParseResultData>> gParseResults;
+    // Files a worker has claimed and the ones whose pass is done, keyed by normalized path
+    std::unordered_set<std::string> gProcessedFiles;
+    std::unordered_set<std::string> gCompletedFiles;
+    std::condition_variable gFilesCompleted;
+    std::unordered_map<std::string, ParseResults> gParseResults;
     std::vector<std::string> gAdditionalFiles;
 
     std::unordered_map<std::string, std::string> gModdedAssetPaths;
     std::variant<std::vector<std::string>, std::string> gWriteOrder;
     std::unordered_map<std::string, std::shared_ptr<BaseFactory>> gFactories;
-    std::unordered_map<std::string, std::map<std::string, std::vector<WriteEntry>>> gWriteMap;
-    std::unordered_map<std::string, std::tuple<uint32_t, uint32_t>> gVirtualAddrMap;
-    std::unordered_map<std::string, std::unordered_map<uint32_t, std::tuple<std::string, YAML::Node>>> gAddrMap;
+    std::unordered_map<std::string, AssetAddrMap> gAddrMap;
+    std::unordered_map<std::string, AssetRangeIndex> gAssetRanges;
+    // Low memory mode, files that still have dependents to process and the ones that are finished
+    std::unordered_map<std::string, size_t> gDependents;
+    std::unordered_set<std::string> gFinishedFiles;
+
+    // Guards the state shared between files when processing in parallel
+    std::mutex gFilesMutex;
+    std::mutex gHashMutex;
+    std::mutex gModdingMutex;
 
     void ProcessFile(YAML::Node root);
+    void ProcessFileInContext(const std::string& path, const fs::path& directory, YAML::Node root, const std::shared_ptr<FileOutput>& output);
+    void ProcessFiles(std::vector<std::tuple<std::string, fs::path, YAML::Node>>& files);
+    void PrefetchCompressedData(std::vector<std::tuple<std::string, fs::path, YAML::Node>>& files, size_t jobs);
+    void CommitOutput(FileOutput& output);
+    void ReleaseParseData(const FileContext& ctx);
+    bool MarkFileProcessed(const std::string& file);
+    void MarkFileCompleted(const std::string& file);
+    void WaitForFile(const std::string& file);
+    // Keyed by FileContext::key, external_files are normalized the same way
+    AssetAddrMap* GetAddrMap(const std::string& key, bool create = false);
+    ParseResults* GetParseResults(const std::string& key, bool create = false);
+    AssetRangeIndex* GetAssetRanges(const std::string& key, bool create = false);
+    AssetRef CompileAsset(const std::string& name, YAML::Node& node);
+    void IndexAssetRange(const std::string& key, const AssetRef& asset);
     void ParseEnums(std::string& file);
     void ParseHash();
+    std::string GetSymbolTableHash(const YAML::Node& config);
+    void ResolveSegments(FileContext& ctx) const;
     void ParseModdingConfig();
     void ParseCurrentFileConfig(YAML::Node node);
     void RegisterFactory(const std::string& type, const std::shared_ptr<BaseFactory>& factory);
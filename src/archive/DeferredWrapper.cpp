@@ -0,0 +1,23 @@
+#include "DeferredWrapper.h"
+
+int32_t DeferredWrapper::CreateArchive() {
+    return 0;
+}
+
+bool DeferredWrapper::AddFile(const std::string& path, std::vector<char>&& data) {
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    this->mFiles.emplace_back(path, std::move(data));
+    return true;
+}
+
+int32_t DeferredWrapper::Close() {
+    return 0;
+}
+
+void DeferredWrapper::Flush(BinaryWrapper* target) {
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    for(auto& [path, data] : this->mFiles) {
+        target->AddFile(path, std::move(data));
+    }
+    this->mFiles.clear();
+}
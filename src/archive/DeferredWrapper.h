@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <tuple>
+#include "BinaryWrapper.h"
+
+/*
+ * Collects the files written while processing a yaml so they can be committed
+ * to the real archive later on, in a deterministic order, even when several
+ * files are being processed in parallel.
+ */
+class DeferredWrapper : public BinaryWrapper {
+public:
+    DeferredWrapper() = default;
+
+    int32_t CreateArchive(void) override;
+    bool AddFile(const std::string& path, std::vector<char>&& data) override;
+    int32_t Close(void) override;
+
+    void Flush(BinaryWrapper* target);
+private:
+    std::vector<std::tuple<std::string, std::vector<char>>> mFiles;
+};
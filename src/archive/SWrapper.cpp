@@ -5,6 +5,7 @@
 
 #include "spdlog/spdlog.h"
 #include <Companion.h>
+#include "lib/binarytools/BufferPool.h"
 
 namespace fs = std::filesystem;
 
@@ -29,7 +30,7 @@ int32_t SWrapper::CreateArchive() {
 #endif
 }
 
-bool SWrapper::AddFile(const std::string& path, std::vector<char> data) {
+bool SWrapper::AddFile(const std::string& path, std::vector<char>&& data) {
 #ifndef USE_STORMLIB
     throw std::runtime_error("StormLib is not enabled. Cannot create file");
 #else
@@ -80,6 +81,7 @@ bool SWrapper::AddFile(const std::string& path, std::vector<char> data) {
         throw std::runtime_error("Failed to close file at path " + path + " with error " + std::to_string(GetLastError()));
     }
 
+    LUS::BufferPool::Recycle(std::move(data));
     return true;
 #endif
 }
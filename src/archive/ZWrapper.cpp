@@ -6,22 +6,72 @@
 #include "spdlog/spdlog.h"
 #include <Companion.h>
 #include <miniz/zip_file.hpp>
+#include "lib/binarytools/BufferPool.h"
 
 namespace fs = std::filesystem;
 
-ZWrapper::ZWrapper(const std::string& path) {
+// Small files are stored instead of deflated, same as miniz does on its own
+#define MIN_DEFLATE_SIZE 4
+
+ZWrapper::ZWrapper(const std::string& path, bool store, size_t workers) : mWorkers(std::max<size_t>(1, workers)), mStore(store) {
     this->mPath = path;
-    this->mZip = new miniz_cpp::zip_file;
+}
+
+ZWrapper::~ZWrapper() {
+    if(this->mZip != nullptr) {
+        this->mPending.clear();
+        mz_zip_writer_end(this->mZip.get());
+    }
 }
 
 int32_t ZWrapper::CreateArchive() {
+    this->mZip = std::make_unique<mz_zip_archive>();
+    memset(this->mZip.get(), 0, sizeof(mz_zip_archive));
+
+    if(!mz_zip_writer_init_file(this->mZip.get(), this->mPath.c_str(), 0)) {
+        SPDLOG_ERROR("Failed to create ZIP (O2R) archive: {}", this->mPath);
+        this->mZip = nullptr;
+        return -1;
+    }
+
+#ifndef __EMSCRIPTEN__
+    if(this->mWorkers > 1 && !this->mStore) {
+        this->mPool = std::make_unique<Torch::ThreadPool>(this->mWorkers);
+    }
+#endif
+
     SPDLOG_INFO("Loaded ZIP (O2R) archive: {}", mPath.c_str());
     return 0;
 }
 
-bool ZWrapper::AddFile(const std::string& path, std::vector<char> data) {
-    char* fileData = data.data();
-    size_t fileSize = data.size();
+ZWrapper::CompressedEntry ZWrapper::Compress(std::vector<char>&& data) {
+    const auto size = data.size();
+    CompressedEntry entry = { std::move(data), nullptr, size, 0, 0 };
+
+    if(entry.data.size() < MIN_DEFLATE_SIZE) {
+        return entry;
+    }
+
+    entry.crc = mz_crc32(MZ_CRC32_INIT, reinterpret_cast<const mz_uint8*>(entry.data.data()), entry.data.size());
+
+    // Raw deflate with the same parameters miniz uses for zip entries
+    const auto flags = tdefl_create_comp_flags_from_zip_params(MZ_BEST_COMPRESSION, -MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY);
+    void* compressed = tdefl_compress_mem_to_heap(entry.data.data(), entry.data.size(), &entry.compressedSize, flags);
+    if(compressed == nullptr) {
+        throw std::runtime_error("Failed to compress zip entry");
+    }
+
+    entry.compressed = std::shared_ptr<void>(compressed, free);
+    LUS::BufferPool::Recycle(std::move(entry.data));
+    return entry;
+}
+
+bool ZWrapper::AddFile(const std::string& path, std::vector<char>&& data) {
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if(this->mZip == nullptr) {
+        throw std::runtime_error("Archive " + this->mPath + " is not open");
+    }
 
     if(Companion::Instance != nullptr && Companion::Instance->IsDebug()){
         SPDLOG_INFO("Creating debug file: debug/{}", path);
@@ -30,15 +80,79 @@ bool ZWrapper::AddFile(const std::string& path, std::vector<char> data) {
             fs::create_directories(fs::path(dpath).parent_path());
         }
         std::ofstream stream(dpath, std::ios::binary);
-        stream.write(fileData, fileSize);
+        stream.write(data.data(), data.size());
         stream.close();
     }
 
-    this->mZip->writebytes(path, data);
+    if(this->mStore) {
+        const auto size = data.size();
+        CompressedEntry entry = { std::move(data), nullptr, size, 0, 0 };
+        this->WriteEntry(path, entry);
+        return true;
+    }
+
+    if(this->mPool == nullptr) {
+        auto entry = Compress(std::move(data));
+        this->WriteEntry(path, entry);
+        return true;
+    }
+
+    auto job = std::make_shared<std::vector<char>>(std::move(data));
+    this->mPending.emplace_back(path, this->mPool->Submit([job] {
+        return Compress(std::move(*job));
+    }));
+
+    // Keep a few entries per worker queued so they stay busy without holding every file in memory
+    this->FlushPending(this->mWorkers * 4);
     return true;
 }
 
+void ZWrapper::WriteEntry(const std::string& path, CompressedEntry& entry) {
+    mz_bool result;
+
+    if(entry.compressed == nullptr) {
+        const auto level = this->mStore ? MZ_NO_COMPRESSION : MZ_BEST_COMPRESSION;
+        result = mz_zip_writer_add_mem(this->mZip.get(), path.c_str(), entry.data.data(), entry.data.size(), level);
+    } else {
+        result = mz_zip_writer_add_mem_ex(this->mZip.get(), path.c_str(), entry.compressed.get(), entry.compressedSize, nullptr, 0,
+                                          MZ_BEST_COMPRESSION | MZ_ZIP_FLAG_COMPRESSED_DATA, entry.size, entry.crc);
+    }
+
+    if(!result) {
+        throw std::runtime_error("Failed to write " + path + " to archive " + this->mPath);
+    }
+
+    LUS::BufferPool::Recycle(std::move(entry.data));
+}
+
+void ZWrapper::FlushPending(size_t keep) {
+    while(this->mPending.size() > keep) {
+        auto& [path, future] = this->mPending.front();
+        auto entry = future.get();
+        this->WriteEntry(path, entry);
+        this->mPending.pop_front();
+    }
+}
+
 int32_t ZWrapper::Close(void) {
-    this->mZip->save(this->mPath);
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if(this->mZip == nullptr) {
+        SPDLOG_ERROR("Archive already closed");
+        return -1;
+    }
+
+    this->FlushPending(0);
+    this->mPool = nullptr;
+
+    const auto finalized = mz_zip_writer_finalize_archive(this->mZip.get());
+    mz_zip_writer_end(this->mZip.get());
+    this->mZip = nullptr;
+
+    if(!finalized) {
+        SPDLOG_ERROR("Failed to finalize archive {}", this->mPath);
+        return -1;
+    }
+
     return 0;
 }
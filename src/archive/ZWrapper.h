@@ -1,20 +1,45 @@
 #pragma once
 
+#include <deque>
+#include <memory>
 #include <vector>
 #include <string>
+#include <future>
 #include "BinaryWrapper.h"
+#include "utils/ThreadPool.h"
 
-namespace miniz_cpp {
-class zip_file;
-}
+struct mz_zip_archive_tag;
 
+/*
+ * Writes O2R (zip) archives. Entries are deflated on a worker pool and
+ * appended to the file in the order they were added, the central directory
+ * is written out when the archive is closed. In store mode the entries are
+ * written as they are, without compression.
+ */
 class ZWrapper : public BinaryWrapper {
 public:
-    explicit ZWrapper(const std::string& path);
+    explicit ZWrapper(const std::string& path, bool store = false, size_t workers = Torch::ThreadPool::DefaultSize());
+    ~ZWrapper() override;
 
     int32_t CreateArchive(void) override;
-    bool AddFile(const std::string& path, std::vector<char> data) override;
+    bool AddFile(const std::string& path, std::vector<char>&& data) override;
     int32_t Close(void) override;
+private:
+    struct CompressedEntry {
+        std::vector<char> data;
+        std::shared_ptr<void> compressed;
+        size_t size;
+        size_t compressedSize;
+        uint32_t crc;
+    };
 
-    miniz_cpp::zip_file* mZip;
+    std::unique_ptr<mz_zip_archive_tag> mZip;
+    std::unique_ptr<Torch::ThreadPool> mPool;
+    std::deque<std::tuple<std::string, std::future<CompressedEntry>>> mPending;
+    size_t mWorkers;
+    bool mStore;
+
+    static CompressedEntry Compress(std::vector<char>&& data);
+    void WriteEntry(const std::string& path, CompressedEntry& entry);
+    void FlushPending(size_t keep);
 };
@@ -78,7 +78,7 @@ ExportResult AssetArrayBinaryExporter::Export(std::ostream &write, std::shared_p
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> AssetArrayFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> AssetArrayFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     std::vector<uint32_t> ptrs;
     auto assetType = GetSafeNode<std::string>(node, "assetType");
     auto factoryType = GetSafeNode<std::string>(node, "factoryType");
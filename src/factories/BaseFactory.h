@@ -6,6 +6,7 @@
 #include <iostream>
 #include <any>
 #include <memory>
+#include <span>
 #include <vector>
 #include <string>
 #include <variant>
@@ -88,12 +89,14 @@ public:
 class BaseExporter {
 public:
     virtual ExportResult Export(std::ostream& write, std::shared_ptr<IParsedData> data, std::string& entryName, YAML::Node& node, std::string* replacement) = 0;
+    // Exporters that write files besides their output have to run on every export
+    virtual bool IsCacheable() { return true; }
     static void WriteHeader(LUS::BinaryWriter& write, Torch::ResourceType resType, int32_t version);
 };
 
 class BaseFactory {
 public:
-    virtual std::optional<std::shared_ptr<IParsedData>> parse(std::vector<uint8_t>& buffer, YAML::Node& data) = 0;
+    virtual std::optional<std::shared_ptr<IParsedData>> parse(std::span<uint8_t> buffer, YAML::Node& data) = 0;
     virtual std::optional<std::shared_ptr<IParsedData>> parse_modding(std::vector<uint8_t>& buffer, YAML::Node& data) {
         return std::nullopt;
     }
@@ -113,6 +116,18 @@ public:
     virtual uint32_t GetAlignment() {
         return 4;
     }
+    // Factories that touch global state (e.g. the audio managers) can't run alongside other files
+    virtual bool HasSharedState() {
+        return false;
+    }
+    // Bump when the exported output changes, so incremental builds export the assets again
+    virtual uint32_t GetVersion() {
+        return 0;
+    }
+    // Size in the rom of the asset described by the node, when it can be known before parsing
+    virtual std::optional<uint32_t> GetAssetSize(YAML::Node& node) {
+        return std::nullopt;
+    }
     virtual std::optional<std::shared_ptr<IParsedData>> CreateDataPointer() {
         return std::nullopt;
     }
@@ -1,6 +1,7 @@
 #include "BlobFactory.h"
 #include "Companion.h"
 #include "utils/Decompressor.h"
+#include "utils/TextWriter.h"
 #include <iomanip>
 
 ExportResult BlobHeaderExporter::Export(std::ostream &write, std::shared_ptr<IParsedData> raw, std::string& entryName, YAML::Node &node, std::string* replacement) {
@@ -28,14 +29,9 @@ ExportResult BlobCodeExporter::Export(std::ostream &write, std::shared_ptr<IPars
 
     write << GetSafeNode<std::string>(node, "ctype", "u8") << " " << symbol << "[] = {\n" << tab_t;
 
-    for (int i = 0; i < data.size(); i++) {
-        if ((i % 15 == 0) && i != 0) {
-            write << "\n" << tab_t;
-        }
-
-        write << "0x" << std::hex << std::setw(2) << std::setfill('0') << (int) data[i] << ", ";
-    }
-    write << "\n};\n";
+    Torch::TextWriter text;
+    text.HexArray(data, 1, 15, "\n" tab_t) << "\n};\n";
+    text.Flush(write);
 
     if (Companion::Instance->IsDebug()) {
         write << "// size: 0x" << std::hex << std::uppercase << data.size() << "\n";
@@ -55,7 +51,7 @@ ExportResult BlobBinaryExporter::Export(std::ostream &write, std::shared_ptr<IPa
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> BlobFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> BlobFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto size = GetSafeNode<size_t>(node, "size");
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
     return std::make_shared<RawBuffer>(segment.data, segment.size);
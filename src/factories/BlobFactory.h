@@ -17,7 +17,7 @@ class BlobCodeExporter : public BaseExporter {
 
 class BlobFactory : public BaseFactory {
 public:
-    std::optional<std::shared_ptr<IParsedData>> parse(std::vector<uint8_t>& buffer, YAML::Node& data) override;
+    std::optional<std::shared_ptr<IParsedData>> parse(std::span<uint8_t> buffer, YAML::Node& data) override;
     inline std::unordered_map<ExportType, std::shared_ptr<BaseExporter>> GetExporters() override {
         return {
             REGISTER(Header, BlobHeaderExporter)
@@ -1,5 +1,6 @@
 #include "CompressedTextureFactory.h"
 #include "utils/Decompressor.h"
+#include "utils/TextWriter.h"
 #include "spdlog/spdlog.h"
 #include "Companion.h"
 #include <iomanip>
@@ -8,13 +9,10 @@
 extern "C" {
 #include "n64graphics/n64graphics.h"
 #include "BaseFactory.h"
-#include <libmio0/mio0.h>
-#include <libyay0/yay0.h>
-#include <libyay0/yay1.h>
 }
 
-static bool isTable = false;
-static std::vector<std::string> tableEntries;
+static thread_local bool isTable = false;
+static thread_local std::vector<std::string> tableEntries;
 
 static const std::unordered_map <std::string, TextureFormat> sTextureFormats = {
     { "RGBA16", { TextureType::RGBA16bpp, 16 } },
@@ -37,12 +35,19 @@ static const std::unordered_map <std::string, CompressionType> sCompressionTypes
     { "YAZ0", CompressionType::YAZ0 },
 };
 
+std::shared_ptr<DataChunk> CompressedTextureData::GetCompressed() {
+    std::call_once(this->mCompressedOnce, [this] {
+        this->mCompressed = Decompressor::Encode(this->mBuffer, this->mCompressionType);
+    });
+    return this->mCompressed;
+}
+
 ExportResult CompressedTextureHeaderExporter::Export(std::ostream &write, std::shared_ptr<IParsedData> raw, std::string& entryName, YAML::Node &node, std::string* replacement) {
     const auto symbol = GetSafeNode(node, "symbol", entryName);
     const auto offset = GetSafeNode<uint32_t>(node, "offset");
     auto format = GetSafeNode<std::string>(node, "format");
     auto texture = std::static_pointer_cast<CompressedTextureData>(raw);
-    auto data = texture->mBuffer;
+    const auto& data = texture->mBuffer;
     auto isOTR = Companion::Instance->IsOTRMode();
     size_t byteSize = std::max(1, (int) (texture->mFormat.depth / 8));
 
@@ -78,33 +83,8 @@ ExportResult CompressedTextureHeaderExporter::Export(std::ostream &write, std::s
         } else {
             write << "extern " << "u8 " << symbol << "[];\n";
             if (Companion::Instance->AddTextureDefines()) {
-                // Allocate worse case size
-                uint8_t* compressedData;
-                size_t compressedSize;
-                size_t worstSize;
-
-                switch (texture->mCompressionType) {
-                    case CompressionType::MIO0:
-                        worstSize = MIO0_HEADER_LENGTH + ((data.size()+7)/8) + data.size();
-                        compressedData = static_cast<uint8_t*>(std::calloc(worstSize, sizeof(uint8_t)));
-                        compressedSize = mio0_encode(data.data(), data.size(), compressedData);
-                        break;
-                    case CompressionType::YAY0:
-                        worstSize = YAY0_HEADER_LENGTH + ((data.size()+7)/8) + data.size();
-                        compressedData = static_cast<uint8_t*>(std::calloc(worstSize, sizeof(uint8_t)));
-                        compressedSize = yay0_encode(data.data(), data.size(), compressedData);
-                        break;
-                    case CompressionType::YAY1:
-                        worstSize = YAY1_HEADER_LENGTH + ((data.size()+7)/8) + data.size();
-                        compressedData = static_cast<uint8_t*>(std::calloc(worstSize, sizeof(uint8_t)));
-                        compressedSize = yay1_encode(data.data(), data.size(), compressedData);
-                        break;
-                    default:
-                        // UNIMPLEMENTED
-                        throw std::runtime_error("Unsupported Compressed Texture Type");
-                        break;
-                }
-                write << "#define _" << symbol << "_COMPRESSED_SIZE 0x" << std::hex << compressedSize << std::dec << "\n";
+                const auto compressed = texture->GetCompressed();
+                write << "#define _" << symbol << "_COMPRESSED_SIZE 0x" << std::hex << compressed->size << std::dec << "\n";
                 write << "#define _" << symbol << "_WIDTH 0x" << std::hex << texture->mWidth << std::dec << "\n";
                 write << "#define _" << symbol << "_HEIGHT 0x" << std::hex << texture->mHeight << std::dec << "\n";
             }
@@ -116,7 +96,7 @@ ExportResult CompressedTextureHeaderExporter::Export(std::ostream &write, std::s
 
 ExportResult CompressedTextureCodeExporter::Export(std::ostream &write, std::shared_ptr<IParsedData> raw, std::string& entryName, YAML::Node &node, std::string* replacement) {
     auto texture = std::static_pointer_cast<CompressedTextureData>(raw);
-    auto data = texture->mBuffer;
+    const auto& data = texture->mBuffer;
     auto offset = GetSafeNode<uint32_t>(node, "offset");
     auto symbol = GetSafeNode(node, "symbol", entryName);
     auto format = GetSafeNode<std::string>(node, "format");
@@ -129,74 +109,24 @@ ExportResult CompressedTextureCodeExporter::Export(std::ostream &write, std::sha
         create_directories(fs::path(dpath).parent_path());
     }
 
-    std::ostringstream imgstream;
-
     size_t byteSize = std::max(1, (int) (texture->mFormat.depth / 8));
     size_t isize = texture->mBuffer.size() / byteSize;
 
-    for (int i = 0; i < data.size(); i+=byteSize) {
-        if (i % 16 == 0 && i != 0) {
-            imgstream << std::endl;
-        }
-
-        imgstream << "0x";
-
-        for (int j = 0; j < byteSize; j++) {
-            imgstream << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(data[i + j]);
-        }
-
-        imgstream << ", ";
-    }
-    imgstream << std::endl;
+    Torch::TextWriter imgstream;
+    imgstream.HexArray(data, byteSize, 16, "\n") << '\n';
 
     std::ofstream file(dpath + ".inc.c", std::ios::binary);
     file << imgstream.str();
     file.close();
 
-    // Allocate worse case size
-    uint8_t* compressedData;
-    size_t compressedSize;
-    size_t worstSize;
-
-    switch (texture->mCompressionType) {
-        case CompressionType::MIO0:
-            worstSize = MIO0_HEADER_LENGTH + ((data.size()+7)/8) + data.size();
-            compressedData = static_cast<uint8_t*>(std::calloc(worstSize, sizeof(uint8_t)));
-            compressedSize = mio0_encode(data.data(), data.size(), compressedData);
-            break;
-        case CompressionType::YAY0:
-            worstSize = YAY0_HEADER_LENGTH + ((data.size()+7)/8) + data.size();
-            compressedData = static_cast<uint8_t*>(std::calloc(worstSize, sizeof(uint8_t)));
-            compressedSize = yay0_encode(data.data(), data.size(), compressedData);
-            break;
-        case CompressionType::YAY1:
-            worstSize = YAY1_HEADER_LENGTH + ((data.size()+7)/8) + data.size();
-            compressedData = static_cast<uint8_t*>(std::calloc(worstSize, sizeof(uint8_t)));
-            compressedSize = yay1_encode(data.data(), data.size(), compressedData);
-            break;
-        default:
-            // UNIMPLEMENTED
-            throw std::runtime_error("Unsupported Compressed Texture Type");
-            break;
-    }
-    if (compressedData) {
-        std::ostringstream compressedStream;
-
-        for (size_t i = 0; i < compressedSize; i++) {
-            if (i % 16 == 0 && i != 0) {
-                compressedStream << std::endl;
-            }
-
-            compressedStream << "0x";
-            compressedStream << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(compressedData[i]);
-            compressedStream << ", ";
-        }
-        compressedStream << std::endl;
+    const auto compressed = texture->GetCompressed();
+    {
+        Torch::TextWriter compressedStream;
+        compressedStream.HexArray(std::span(compressed->data, compressed->size), 1, 16, "\n") << '\n';
 
         std::ofstream file(dpath + ".incbin.c", std::ios::binary);
         file << compressedStream.str();
         file.close();
-        free(compressedData);
     }
 
     const auto searchTable = Companion::Instance->SearchTable(offset);
@@ -242,7 +172,7 @@ ExportResult CompressedTextureCodeExporter::Export(std::ostream &write, std::sha
 
         write << "\n";
     }
-    return offset + compressedSize;
+    return offset + compressed->size;
 }
 
 ExportResult CompressedTextureBinaryExporter::Export(std::ostream &write, std::shared_ptr<IParsedData> raw, std::string& entryName, YAML::Node &node, std::string* replacement) {
@@ -363,7 +293,7 @@ std::string getcomptype(CompressionType type) {
     return "None";
 }
 
-std::optional<std::shared_ptr<IParsedData>> CompressedTextureFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> CompressedTextureFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto offset = GetSafeNode<uint32_t>(node, "offset");
     auto format = GetSafeNode<std::string>(node, "format");
     auto symbol = GetSafeNode<std::string>(node, "symbol");
@@ -388,7 +318,7 @@ std::optional<std::shared_ptr<IParsedData>> CompressedTextureFactory::parse(std:
         return std::nullopt;
     }
 
-    DataChunk* uncompressedData = Decompressor::Decode(buffer, Decompressor::TranslateAddr(offset, false), compressionType);
+    auto uncompressedData = Decompressor::Decode(buffer, Decompressor::TranslateAddr(offset, false), compressionType);
 
     std::transform(format.begin(), format.end(), format.begin(), ::toupper);
 
@@ -524,33 +454,15 @@ std::optional<std::shared_ptr<IParsedData>> CompressedTextureFactory::parse_modd
         }
         case TextureType::Palette8bpp:
         case TextureType::Palette4bpp: {
-            // This implementation is not correct.
-            // The process should be:
-            // png2rgba --> imgpal2rawci
-
-            // todo: Add wheel palette input
-            // Implement so that it works.
-
-            // auto tlut = GetSafeNode<std::string>(node,"tlut_symbol");
-            // auto tlutTextureMap = Companion::Instance->GetTlutTextureMap();
-            // auto palettePtr = tlutTextureMap[tlut];
-
-            // if (palettePtr) {
-
-            //     auto imgi = png2rgba(buffer.data(), buffer.size(), &width, &height);
-            //     auto pal = png2rgba(palettePtr->mBuffer.data(), (palettePtr->mWidth * palettePtr->mWidth * palettePtr->mFormat.depth * 2), &width, &height);
-
-            //     size = width * height * fmt.depth / 8;
-            //     raw = new uint8_t[size];
-
-            //     if(imgpal2rawci(raw, imgi, pal, 0, 0, width, height, fmt.depth) <= 0){
-            //         throw std::runtime_error("Failed to convert PNG to texture");
-            //     }
-            // } else {
-
-            // }
-            SPDLOG_ERROR("Unsupported texture format for modding: {}", format);
-            return std::nullopt;
+            // Textures without a TLUT are exported as grayscale indices
+            if (node["tlut"] || node["tlut_symbol"]) {
+                const auto indices = TextureFactory::ParseModdedCI(buffer, node, fmt, &width, &height);
+                size = indices.size();
+                raw = new uint8_t[size];
+                std::copy(indices.begin(), indices.end(), raw);
+                break;
+            }
+            [[fallthrough]];
         }
         case TextureType::Grayscale8bpp:
         case TextureType::Grayscale4bpp: {
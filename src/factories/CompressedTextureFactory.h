@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include "BaseFactory.h"
 #include "utils/Decompressor.h"
 #include "utils/TextureUtils.h"
@@ -13,6 +14,12 @@ public:
     CompressionType mCompressionType;
 
     CompressedTextureData(TextureFormat format, uint32_t width, uint32_t height, std::vector<uint8_t>& buffer, CompressionType compressionType) : mFormat(format), mWidth(width), mHeight(height), mBuffer(std::move(buffer)), mCompressionType(compressionType) {}
+
+    // Encoded once and shared by every exporter of this texture
+    std::shared_ptr<DataChunk> GetCompressed();
+private:
+    std::once_flag mCompressedOnce;
+    std::shared_ptr<DataChunk> mCompressed;
 };
 
 class CompressedTextureHeaderExporter : public BaseExporter {
@@ -21,6 +28,7 @@ class CompressedTextureHeaderExporter : public BaseExporter {
 
 class CompressedTextureCodeExporter : public BaseExporter {
     ExportResult Export(std::ostream& write, std::shared_ptr<IParsedData> data, std::string& entryName, YAML::Node& node, std::string* replacement) override;
+    bool IsCacheable() override { return false; }
 };
 
 class CompressedTextureBinaryExporter : public BaseExporter {
@@ -33,7 +41,7 @@ class CompressedTextureModdingExporter : public BaseExporter {
 
 class CompressedTextureFactory : public BaseFactory {
 public:
-    std::optional<std::shared_ptr<IParsedData>> parse(std::vector<uint8_t>& buffer, YAML::Node& data) override;
+    std::optional<std::shared_ptr<IParsedData>> parse(std::span<uint8_t> buffer, YAML::Node& data) override;
     std::optional<std::shared_ptr<IParsedData>> parse_modding(std::vector<uint8_t>& buffer, YAML::Node& data) override;
     inline std::unordered_map<ExportType, std::shared_ptr<BaseExporter>> GetExporters() override {
         return {
@@ -13,55 +13,71 @@
 #define C0(pos, width) ((w0 >> (pos)) & ((1U << width) - 1))
 #define ALIGN16(val) (((val) + 0xF) & ~0xF)
 
-std::unordered_map<std::string, uint8_t> gF3DTable = {
-    { "G_VTX", 0x04 },
-    { "G_DL", 0x06 },
-    { "G_MTX", 0x1 },
-    { "G_ENDDL", 0xB8 },
-    { "G_SETTIMG", 0xFD },
-    { "G_MOVEMEM", 0x03 },
-    { "G_MV_L0", 0x86 },
-    { "G_MV_L1", 0x88 },
-    { "G_MV_LIGHT", 0xA },
-    { "G_TRI2", 0xB1 },
-    { "G_QUAD", -1 }
+// Opcodes that change between microcodes, resolved at compile time by templating on the table
+struct F3DOpcodes {
+    static constexpr GBIVersion Version = GBIVersion::f3d;
+    static constexpr uint8_t G_VTX = 0x04;
+    static constexpr uint8_t G_DL = 0x06;
+    static constexpr uint8_t G_MTX = 0x1;
+    static constexpr uint8_t G_ENDDL = 0xB8;
+    static constexpr uint8_t G_SETTIMG = 0xFD;
+    static constexpr uint8_t G_MOVEMEM = 0x03;
+    static constexpr uint8_t G_MV_L0 = 0x86;
+    static constexpr uint8_t G_MV_L1 = 0x88;
+    static constexpr uint8_t G_MV_LIGHT = 0xA;
+    static constexpr uint8_t G_TRI2 = 0xB1;
+    // f3d has no quadrangle command
+    static constexpr uint8_t G_QUAD = 0xFF;
 };
 
-std::unordered_map<std::string, uint8_t> gF3DExTable = {
-    { "G_VTX", 0x04 },
-    { "G_DL", 0x06 },
-    { "G_MTX", 0x1 },
-    { "G_ENDDL", 0xB8 },
-    { "G_SETTIMG", 0xFD },
-    { "G_MOVEMEM", 0x03 },
-    { "G_MV_L0", 0x86 },
-    { "G_MV_L1", 0x88 },
-    { "G_MV_LIGHT", 0xA },
-    { "G_TRI2", 0xB1 },
-    { "G_QUAD", 0xB5 }
+struct F3DBOpcodes : F3DOpcodes {
+    static constexpr GBIVersion Version = GBIVersion::f3db;
 };
 
-std::unordered_map<std::string, uint8_t> gF3DEx2Table = {
-    { "G_VTX", 0x01 },
-    { "G_DL", 0xDE },
-    { "G_MTX", 0xDA },
-    { "G_ENDDL", 0xDF },
-    { "G_SETTIMG", 0xFD },
-    { "G_MOVEMEM", 0xDC },
-    { "G_MV_L0", 0x86 },
-    { "G_MV_L1", 0x88 },
-    { "G_MV_LIGHT", 0xA },
-    { "G_TRI2", 0x06 },
-    { "G_QUAD", 0x07 }
+struct F3DEXOpcodes : F3DOpcodes {
+    static constexpr GBIVersion Version = GBIVersion::f3dex;
+    static constexpr uint8_t G_QUAD = 0xB5;
 };
 
-std::unordered_map<GBIVersion, std::unordered_map<std::string, uint8_t>> gGBITable = {
-    { GBIVersion::f3d, gF3DTable },
-    { GBIVersion::f3dex, gF3DExTable },
-    { GBIVersion::f3dex2, gF3DEx2Table },
+struct F3DEXBOpcodes : F3DEXOpcodes {
+    static constexpr GBIVersion Version = GBIVersion::f3dexb;
 };
 
-#define GBI(cmd) gGBITable[Companion::Instance->GetGBIVersion()][#cmd]
+struct F3DEX2Opcodes {
+    static constexpr GBIVersion Version = GBIVersion::f3dex2;
+    static constexpr uint8_t G_VTX = 0x01;
+    static constexpr uint8_t G_DL = 0xDE;
+    static constexpr uint8_t G_MTX = 0xDA;
+    static constexpr uint8_t G_ENDDL = 0xDF;
+    static constexpr uint8_t G_SETTIMG = 0xFD;
+    static constexpr uint8_t G_MOVEMEM = 0xDC;
+    static constexpr uint8_t G_MV_L0 = 0x86;
+    static constexpr uint8_t G_MV_L1 = 0x88;
+    static constexpr uint8_t G_MV_LIGHT = 0xA;
+    static constexpr uint8_t G_TRI2 = 0x06;
+    static constexpr uint8_t G_QUAD = 0x07;
+};
+
+// Calls fn with the opcode table of the given microcode
+template<typename Fn>
+static auto WithGBIOpcodes(GBIVersion version, Fn&& fn) {
+    switch (version) {
+        case GBIVersion::f3db:
+            return fn(F3DBOpcodes{});
+        case GBIVersion::f3d:
+            return fn(F3DOpcodes{});
+        case GBIVersion::f3dex:
+            return fn(F3DEXOpcodes{});
+        case GBIVersion::f3dexb:
+            return fn(F3DEXBOpcodes{});
+        case GBIVersion::f3dex2:
+            return fn(F3DEX2Opcodes{});
+    }
+
+    throw std::runtime_error("Unsupported GBI version");
+}
+
+#define GBI(cmd) Ucode::cmd
 
 #ifdef STANDALONE
 void GFXDSetGBIVersion(){
@@ -86,7 +102,8 @@ void GFXDSetGBIVersion(){
 #endif
 
 ExportResult DListHeaderExporter::Export(std::ostream &write, std::shared_ptr<IParsedData> raw, std::string& entryName, YAML::Node &node, std::string* replacement) {
-    const auto symbol = GetSafeNode(node, "symbol", entryName);
+    const auto& asset = Companion::Instance->GetCurrentAsset();
+    const auto symbol = asset->symbol.value_or(entryName);
 
     if(Companion::Instance->IsOTRMode()){
         write << "static const ALIGN_ASSET(2) char " << symbol << "[] = \"__OTR__" << (*replacement) << "\";\n\n";
@@ -98,11 +115,38 @@ ExportResult DListHeaderExporter::Export(std::ostream &write, std::shared_ptr<IP
 }
 
 #ifdef STANDALONE
-bool hasTable = false;
+thread_local bool hasTable = false;
+
+template<typename Ucode>
+static int DListMacro() {
+    auto gfx = static_cast<const N64Gfx*>(gfxd_macro_data());
+    const uint8_t opcode = (gfx->words.w0 >> 24) & 0xFF;
+
+    if(hasTable) {
+        gfxd_puts(fourSpaceTab fourSpaceTab);
+    } else {
+        gfxd_puts(fourSpaceTab);
+    }
+
+    // For mk64 only
+    if(opcode == GBI(G_QUAD) && Companion::Instance->GetGBIMinorVersion() == GBIMinorVersion::Mk64) {
+        GFXDOverride::Quadrangle(gfx);
+    // Prevents mix and matching of quadrangle commands. Forces 2TRI only.
+    } else if(opcode == GBI(G_TRI2)) {
+        GFXDOverride::Triangle2(gfx);
+    } else {
+        gfxd_macro_dflt();
+    }
+
+    gfxd_puts(",\n");
+    return 0;
+}
+
 ExportResult DListCodeExporter::Export(std::ostream &write, std::shared_ptr<IParsedData> raw, std::string& entryName, YAML::Node &node, std::string* replacement ) {
     const auto cmds = std::static_pointer_cast<DListData>(raw)->mGfxs;
-    const auto symbol = GetSafeNode(node, "symbol", entryName);
-    auto offset = GetSafeNode<uint32_t>(node, "offset");
+    const auto& asset = Companion::Instance->GetCurrentAsset();
+    const auto symbol = asset->symbol.value_or(entryName);
+    auto offset = asset->offset.value();
     const auto searchTable = Companion::Instance->SearchTable(offset);
     const auto sz = (sizeof(uint32_t) * cmds.size());
     hasTable = searchTable.has_value();
@@ -115,28 +159,8 @@ ExportResult DListCodeExporter::Export(std::ostream &write, std::shared_ptr<IPar
     gfxd_output_buffer(out, sizeof(out));
 
     gfxd_endian(gfxd_endian_host, sizeof(uint32_t));
-    gfxd_macro_fn([] {
-        auto gfx = static_cast<const N64Gfx*>(gfxd_macro_data());
-        const uint8_t opcode = (gfx->words.w0 >> 24) & 0xFF;
-
-        if(hasTable) {
-            gfxd_puts(fourSpaceTab fourSpaceTab);
-        } else {
-            gfxd_puts(fourSpaceTab);
-        }
-
-        // For mk64 only
-        if(opcode == GBI(G_QUAD) && Companion::Instance->GetGBIMinorVersion() == GBIMinorVersion::Mk64) {
-            GFXDOverride::Quadrangle(gfx);
-        // Prevents mix and matching of quadrangle commands. Forces 2TRI only.
-        } else if(opcode == GBI(G_TRI2)) {
-            GFXDOverride::Triangle2(gfx);
-        } else {
-            gfxd_macro_dflt();
-        }
-
-        gfxd_puts(",\n");
-        return 0;
+    WithGBIOpcodes(Companion::Instance->GetGBIVersion(), [](auto ucode) {
+        gfxd_macro_fn(DListMacro<decltype(ucode)>);
     });
 
     gfxd_vtx_callback(GFXDOverride::Vtx);
@@ -216,34 +240,18 @@ void DebugDisplayList(uint32_t w0, uint32_t w1){
 }
 #endif
 
-std::optional<std::tuple<std::string, YAML::Node>> SearchVtx(uint32_t ptr){
-    auto decs = Companion::Instance->GetNodesByType("VTX");
-
-    if(!decs.has_value()){
-        return std::nullopt;
-    }
-
-    for(auto& dec : decs.value()){
-        auto [name, node] = dec;
-
-        auto offset = GetSafeNode<uint32_t>(node, "offset");
-        auto count = GetSafeNode<uint32_t>(node, "count");
-        auto end = ALIGN16((count * sizeof(N64Vtx_t)));
-
-        if(ptr > offset && ptr < offset + end){
-            return std::make_tuple(GetSafeNode<std::string>(node, "symbol", name), node);
-        }
-    }
-
-    return std::nullopt;
+AssetRef SearchVtx(uint32_t ptr){
+    // Overlapping VTX arrays resolve to the widest one, see AssetRangeIndex::Find
+    return Companion::Instance->GetAssetContainingAddr("VTX", ptr);
 }
 
-ExportResult DListBinaryExporter::Export(std::ostream &write, std::shared_ptr<IParsedData> raw, std::string& entryName, YAML::Node &node, std::string* replacement ) {
-    const auto gbi = Companion::Instance->GetGBIVersion();
+template<typename Ucode>
+static ExportResult ExportDList(std::ostream &write, std::shared_ptr<IParsedData> raw, std::string* replacement) {
+    constexpr auto gbi = Ucode::Version;
     auto cmds = std::static_pointer_cast<DListData>(raw)->mGfxs;
     auto writer = LUS::BinaryWriter();
 
-    WriteHeader(writer, Torch::ResourceType::DisplayList, 0);
+    BaseExporter::WriteHeader(writer, Torch::ResourceType::DisplayList, 0);
 
     writer.Write((int8_t) gbi);
     
@@ -284,20 +292,18 @@ ExportResult DListBinaryExporter::Export(std::ostream &write, std::shared_ptr<IP
             auto ptr = w1;
 
             auto overlap = GFXDOverride::GetVtxOverlap(ptr);
-            if(overlap.has_value()){
-                auto ovnode = std::get<1>(overlap.value());
-                auto path = Companion::Instance->RelativePath(std::get<0>(overlap.value()));
+            if(overlap != nullptr){
+                const auto symbol = overlap->symbol.value_or(overlap->name);
+                auto path = Companion::Instance->RelativePath(symbol);
                 uint64_t hash = CRC64(path.c_str());
 
                 if(hash == 0) {
-                    throw std::runtime_error("Vtx hash is 0 for " + std::get<0>(overlap.value()));
+                    throw std::runtime_error("Vtx hash is 0 for " + symbol);
                 }
 
                 SPDLOG_INFO("Found vtx: 0x{:X} Hash: 0x{:X} Path: {}", ptr, hash, path);
 
-                auto offset = GetSafeNode<uint32_t>(ovnode, "offset");
-                auto count = GetSafeNode<uint32_t>(ovnode, "count");
-                auto diff = ASSET_PTR(ptr) - ASSET_PTR(offset);
+                auto diff = ASSET_PTR(ptr) - ASSET_PTR(overlap->offset.value());
 
                 N64Gfx value = gsSPVertexOTR(diff, nvtx, didx);
 
@@ -381,11 +387,13 @@ ExportResult DListBinaryExporter::Export(std::ostream &write, std::shared_ptr<IP
             bool hasOffset = false;
 
             switch (gbi) {
+                case GBIVersion::f3db:
                 case GBIVersion::f3d:
                     index = C0(16, 8);
                     offset = 0;
                     break;
                 case GBIVersion::f3dex:
+                case GBIVersion::f3dexb:
                     index = (w0 >> 16) & 0xFF;
                     offset = C0(8, 8) * 8;
                     break;
@@ -485,8 +493,15 @@ ExportResult DListBinaryExporter::Export(std::ostream &write, std::shared_ptr<IP
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> DListFactory::parse(std::vector<uint8_t>& raw_buffer, YAML::Node& node) {
-    const auto gbi = Companion::Instance->GetGBIVersion();
+ExportResult DListBinaryExporter::Export(std::ostream &write, std::shared_ptr<IParsedData> raw, std::string& entryName, YAML::Node &node, std::string* replacement ) {
+    return WithGBIOpcodes(Companion::Instance->GetGBIVersion(), [&](auto ucode) {
+        return ExportDList<decltype(ucode)>(write, raw, replacement);
+    });
+}
+
+template<typename Ucode>
+static std::optional<std::shared_ptr<IParsedData>> ParseDList(std::span<uint8_t> raw_buffer, YAML::Node& node) {
+    constexpr auto gbi = Ucode::Version;
 
     auto count = GetSafeNode<int32_t>(node, "count", -1);
     auto [_, segment] = Decompressor::AutoDecode(node, raw_buffer);
@@ -534,13 +549,15 @@ std::optional<std::shared_ptr<IParsedData>> DListFactory::parse(std::vector<uint
             uint8_t offset = 0;
             bool light = false;
 
-            switch (Companion::Instance->GetGBIVersion()) {
+            switch (gbi) {
                // If needing light generation on G_MV_L0 then we'll need to walk the DL ptr forward/backward to check for 0xBC
                // Otherwise mk64 will break.
                // PD: Mega, this works for sm64 too, why you didn't implement it? >:(
                // PD: Im jk, <3
+               case GBIVersion::f3db:
                case GBIVersion::f3d:
                case GBIVersion::f3dex:
+               case GBIVersion::f3dexb:
                     /*
                      * Only generate lights on the second gsSPLight.
                      * gsSPSetLights1(name) outputs three macros:
@@ -594,18 +611,16 @@ std::optional<std::shared_ptr<IParsedData>> DListFactory::parse(std::vector<uint
                 auto adjPtr = Companion::Instance->PatchVirtualAddr(w1);
                 auto search = SearchVtx(adjPtr);
 
-                if(search.has_value()){
-                    auto [path, vtx] = search.value();
-
-                    SPDLOG_INFO("Path: {}", path);
+                if(search != nullptr){
+                    SPDLOG_INFO("Path: {}", search->symbol.value_or(search->name));
 
-                    auto lOffset = GetSafeNode<uint32_t>(vtx, "offset");
-                    auto lCount = GetSafeNode<uint32_t>(vtx, "count");
-                    auto lSize = ALIGN16(lCount * sizeof(N64Vtx_t));
+                    // Only assets with a known size are indexed, for vtx it is the aligned count
+                    auto lOffset = search->offset.value();
+                    auto lSize = search->size.value();
 
                     if(adjPtr > lOffset && adjPtr <= lOffset + lSize){
                         SPDLOG_INFO("Found vtx at 0x{:X} matching last vtx at 0x{:X}", adjPtr, lOffset);
-                        GFXDOverride::RegisterVTXOverlap(adjPtr, search.value());
+                        GFXDOverride::RegisterVTXOverlap(adjPtr);
                     }
                 } else {
                     YAML::Node vtx;
@@ -631,3 +646,9 @@ std::optional<std::shared_ptr<IParsedData>> DListFactory::parse(std::vector<uint
 
     return std::make_shared<DListData>(gfxs);
 }
+
+std::optional<std::shared_ptr<IParsedData>> DListFactory::parse(std::span<uint8_t> raw_buffer, YAML::Node& node) {
+    return WithGBIOpcodes(Companion::Instance->GetGBIVersion(), [&](auto ucode) {
+        return ParseDList<decltype(ucode)>(raw_buffer, node);
+    });
+}
@@ -12,8 +12,6 @@
 
 namespace GFXDOverride {
 
-std::unordered_map<uint32_t, std::tuple<std::string, YAML::Node>> mVtxOverlaps;
-
 #ifdef STANDALONE
 void Triangle2(const N64Gfx* gfx) {
     auto w0 = gfx->words.w0;
@@ -55,13 +53,9 @@ int Vtx(uint32_t ptr, int32_t num) {
     ptr = Companion::Instance->PatchVirtualAddr(ptr);
     auto vtx = GetVtxOverlap(ptr);
 
-    if(vtx.has_value()){
-        auto symbol = std::get<0>(vtx.value());
-        auto node = std::get<1>(vtx.value());
-
-        auto offset = GetSafeNode<uint32_t>(node, "offset");
-        auto count = GetSafeNode<uint32_t>(node, "count");
-        auto idx = (ptr - offset) / sizeof(N64Vtx_t);
+    if(vtx != nullptr){
+        const auto symbol = vtx->symbol.value_or(vtx->name);
+        auto idx = (ptr - vtx->offset.value()) / sizeof(N64Vtx_t);
 
         SPDLOG_INFO("Replaced Vtx Overlapped: 0x{:X} Symbol: {}", ptr, symbol);
         gfxd_puts("&");
@@ -72,11 +66,10 @@ int Vtx(uint32_t ptr, int32_t num) {
         return 1;
     }
 
-    auto dec = Companion::Instance->GetSafeNodeByAddr(ptr, "VTX");
+    auto asset = Companion::Instance->GetSafeAssetByAddr(ptr, "VTX");
 
-    if(dec.has_value()){
-        auto node = std::get<1>(dec.value());
-        auto symbol = GetSafeNode<std::string>(node, "symbol");
+    if(asset != nullptr){
+        const auto& symbol = asset->GetSymbol();
         SPDLOG_INFO("Found Vtx: 0x{:X} Symbol: {}", ptr, symbol);
         gfxd_puts(symbol.c_str());
         return 1;
@@ -87,11 +80,10 @@ int Vtx(uint32_t ptr, int32_t num) {
 }
 
 int Texture(uint32_t ptr, int32_t fmt, int32_t siz, int32_t width, int32_t height, int32_t pal) {
-    auto dec = Companion::Instance->GetSafeNodeByAddr(ptr, "TEXTURE");
+    auto asset = Companion::Instance->GetSafeAssetByAddr(ptr, "TEXTURE");
 
-    if(dec.has_value()){
-        auto node = std::get<1>(dec.value());
-        auto symbol = GetSafeNode<std::string>(node, "symbol");
+    if(asset != nullptr){
+        const auto& symbol = asset->GetSymbol();
         SPDLOG_INFO("Found Texture: 0x{:X} Symbol: {}", ptr, symbol);
         gfxd_puts(symbol.c_str());
         return 1;
@@ -102,11 +94,10 @@ int Texture(uint32_t ptr, int32_t fmt, int32_t siz, int32_t width, int32_t heigh
 }
 
 int Palette(uint32_t ptr, int32_t idx, int32_t count) {
-    auto dec = Companion::Instance->GetSafeNodeByAddr(ptr, "TEXTURE");
+    auto asset = Companion::Instance->GetSafeAssetByAddr(ptr, "TEXTURE");
 
-    if(dec.has_value()){
-        auto node = std::get<1>(dec.value());
-        auto symbol = GetSafeNode<std::string>(node, "symbol");
+    if(asset != nullptr){
+        const auto& symbol = asset->GetSymbol();
         SPDLOG_INFO("Found TLUT: 0x{:X} Symbol: {}", ptr, symbol);
         gfxd_puts(symbol.c_str());
         return 1;
@@ -117,11 +108,10 @@ int Palette(uint32_t ptr, int32_t idx, int32_t count) {
 }
 
 int Lights(uint32_t ptr, int32_t count) {
-    auto dec = Companion::Instance->GetSafeNodeByAddr(ptr, "LIGHTS");
+    auto asset = Companion::Instance->GetSafeAssetByAddr(ptr, "LIGHTS");
 
-    if(dec.has_value()){
-        auto node = std::get<1>(dec.value());
-        auto symbol = GetSafeNode<std::string>(node, "symbol");
+    if(asset != nullptr){
+        const auto& symbol = asset->GetSymbol();
         SPDLOG_INFO("Found Lightsn: 0x{:X} Symbol: {}", ptr, symbol);
         gfxd_puts(symbol.c_str());
         return 1;
@@ -132,21 +122,19 @@ int Lights(uint32_t ptr, int32_t count) {
 }
 
 int Light(uint32_t ptr) {
-    auto res = Companion::Instance->GetSafeNodeByAddr(ptr, "LIGHTS");
+    auto asset = Companion::Instance->GetSafeAssetByAddr(ptr, "LIGHTS");
 
-    if(res.has_value()){
-        auto node = std::get<1>(res.value());
-        auto symbol = GetSafeNode<std::string>(node, "symbol");
+    if(asset != nullptr){
+        const auto& symbol = asset->GetSymbol();
         SPDLOG_INFO("Found Light A Ptr: 0x{:X} Symbol: {}", ptr, symbol);
         gfxd_puts(("&" + symbol + ".a").c_str());
         return 1;
     }
 
-    res = Companion::Instance->GetSafeNodeByAddr(ptr - 0x8, "LIGHTS");
+    asset = Companion::Instance->GetSafeAssetByAddr(ptr - 0x8, "LIGHTS");
 
-    if(res.has_value()){
-        auto node = std::get<1>(res.value());
-        auto symbol = GetSafeNode<std::string>(node, "symbol");
+    if(asset != nullptr){
+        const auto& symbol = asset->GetSymbol();
         SPDLOG_INFO("Found Light L Ptr: 0x{:X} Symbol: {}", ptr, symbol);
         gfxd_puts(("&" + symbol + ".l").c_str());
         return 1;
@@ -157,11 +145,10 @@ int Light(uint32_t ptr) {
 }
 
 int DisplayList(uint32_t ptr) {
-    auto dec = Companion::Instance->GetSafeNodeByAddr(ptr, "GFX");
+    auto asset = Companion::Instance->GetSafeAssetByAddr(ptr, "GFX");
 
-    if(dec.has_value()){
-        auto node = std::get<1>(dec.value());
-        auto symbol = GetSafeNode<std::string>(node, "symbol");
+    if(asset != nullptr){
+        const auto& symbol = asset->GetSymbol();
         SPDLOG_INFO("Found Display List: 0x{:X} Symbol: {}", ptr, symbol);
         gfxd_puts(symbol.c_str());
         return 1;
@@ -172,11 +159,10 @@ int DisplayList(uint32_t ptr) {
 }
 
 int Viewport(uint32_t ptr) {
-    auto dec = Companion::Instance->GetSafeNodeByAddr(ptr, "VP");
+    auto asset = Companion::Instance->GetSafeAssetByAddr(ptr, "VP");
 
-    if(dec.has_value()){
-        auto node = std::get<1>(dec.value());
-        auto symbol = GetSafeNode<std::string>(node, "symbol");
+    if(asset != nullptr){
+        const auto& symbol = asset->GetSymbol();
         SPDLOG_INFO("Found Viewport: 0x{:X} Symbol: {}", ptr, symbol);
         gfxd_puts(("&" + symbol).c_str());
         return 1;
@@ -187,11 +173,10 @@ int Viewport(uint32_t ptr) {
 }
 
 int Matrix(uint32_t ptr) {
-    auto dec = Companion::Instance->GetSafeNodeByAddr(ptr, "MTX");
+    auto asset = Companion::Instance->GetSafeAssetByAddr(ptr, "MTX");
 
-    if(dec.has_value()){
-        auto node = std::get<1>(dec.value());
-        auto symbol = GetSafeNode<std::string>(node, "symbol");
+    if(asset != nullptr){
+        const auto& symbol = asset->GetSymbol();
         SPDLOG_INFO("Found Matrix: 0x{:X} Symbol: {}", ptr, symbol);
         gfxd_puts(("&" + symbol).c_str());
         return 1;
@@ -202,23 +187,30 @@ int Matrix(uint32_t ptr) {
 }
 #endif
 
-std::optional<std::tuple<std::string, YAML::Node>> GetVtxOverlap(uint32_t ptr){
-    if(mVtxOverlaps.contains(ptr)){
-        SPDLOG_INFO("Found overlap for ptr 0x{:X}", ptr);
-        return mVtxOverlaps[ptr];
+AssetRef GetVtxOverlap(uint32_t ptr){
+    auto& overlaps = Companion::GetCurrentContext().vtxOverlaps;
+    if(!overlaps.contains(ptr)){
+        SPDLOG_TRACE("Failed to find overlap for ptr 0x{:X}", ptr);
+        return nullptr;
     }
 
-    SPDLOG_TRACE("Failed to find overlap for ptr 0x{:X}", ptr);
+    // Same widest enclosing range rule as SearchVtx
+    auto vtx = Companion::Instance->GetAssetContainingAddr("VTX", ptr);
+    if(vtx == nullptr){
+        SPDLOG_TRACE("Failed to find overlap for ptr 0x{:X}", ptr);
+        return nullptr;
+    }
 
-    return std::nullopt;
+    SPDLOG_INFO("Found overlap for ptr 0x{:X}", ptr);
+    return vtx;
 }
 
-void RegisterVTXOverlap(uint32_t ptr, std::tuple<std::string, YAML::Node>& vtx){
-    mVtxOverlaps[ptr] = vtx;
+void RegisterVTXOverlap(uint32_t ptr){
+    Companion::GetCurrentContext().vtxOverlaps.insert(ptr);
     SPDLOG_INFO("Register overlap for ptr 0x{:X}", ptr);
 }
 
 void ClearVtx(){
-    mVtxOverlaps.clear();
+    Companion::GetCurrentContext().vtxOverlaps.clear();
 }
 }
@@ -370,7 +370,7 @@ ExportResult ArrayBinaryExporter::Export(std::ostream &write, std::shared_ptr<IP
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> GenericArrayFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> GenericArrayFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     std::vector<ArrayDatum> data;
     const auto count = GetSafeNode<uint32_t>(node, "count");
     const auto type = GetSafeNode<std::string>(node, "array_type");
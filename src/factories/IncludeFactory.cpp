@@ -34,7 +34,7 @@ ExportResult IncludeCodeExporter::Export(std::ostream &write, std::shared_ptr<IP
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> IncludeFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> IncludeFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
 
     SPDLOG_INFO("parsing INC");
     const uint32_t blank = 1;
@@ -113,7 +113,7 @@ ExportResult LightsBinaryExporter::Export(std::ostream &write, std::shared_ptr<I
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> LightsFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> LightsFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto decoded = Decompressor::AutoDecode(node, buffer);
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
     LUS::BinaryReader reader(segment.data, sizeof(Lights1Raw));
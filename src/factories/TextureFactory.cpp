@@ -1,5 +1,6 @@
 #include "TextureFactory.h"
 #include "utils/Decompressor.h"
+#include "utils/TextWriter.h"
 #include "spdlog/spdlog.h"
 #include "Companion.h"
 #include <iomanip>
@@ -10,8 +11,8 @@ extern "C" {
 #include "BaseFactory.h"
 }
 
-static bool isTable = false;
-static std::vector<std::string> tableEntries;
+static thread_local bool isTable = false;
+static thread_local std::vector<std::string> tableEntries;
 
 static const std::unordered_map <std::string, TextureFormat> sTextureFormats = {
     { "RGBA16", { TextureType::RGBA16bpp, 16 } },
@@ -92,25 +93,11 @@ ExportResult TextureCodeExporter::Export(std::ostream &write, std::shared_ptr<IP
         create_directories(fs::path(dpath).parent_path());
     }
 
-    std::ostringstream imgstream;
-
     size_t byteSize = std::max(1, (int) (texture->mFormat.depth / 8));
     size_t isize = texture->mBuffer.size() / byteSize;
 
-    for (int i = 0; i < data.size(); i+=byteSize) {
-        if (i % 16 == 0 && i != 0) {
-            imgstream << std::endl;
-        }
-
-        imgstream << "0x";
-
-        for (int j = 0; j < byteSize; j++) {
-            imgstream << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(data[i + j]);
-        }
-
-        imgstream << ", ";
-    }
-    imgstream << std::endl;
+    Torch::TextWriter imgstream;
+    imgstream.HexArray(data, byteSize, 16, "\n") << '\n';
 
     if (!Companion::Instance->IsUsingIndividualIncludes()){
         std::ofstream file(dpath + ".inc.c", std::ios::binary);
@@ -269,7 +256,7 @@ ExportResult TextureModdingExporter::Export(std::ostream&write, std::shared_ptr<
 }
 
 
-std::optional<std::shared_ptr<IParsedData>> TextureFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> TextureFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto offset = GetSafeNode<uint32_t>(node, "offset");
     auto format = GetSafeNode<std::string>(node, "format");
     auto symbol = GetSafeNode<std::string>(node, "symbol");
@@ -348,6 +335,55 @@ std::optional<std::shared_ptr<IParsedData>> TextureFactory::parse(std::vector<ui
     return std::make_shared<TextureData>(fmt, width, height, result);
 }
 
+// The TLUT the modding exporter used, the parsed one wins so a modded TLUT is matched against itself
+static std::vector<uint8_t> GetModdingTlut(YAML::Node& node) {
+    std::optional<ParseResultData> palette;
+
+    if (node["tlut_symbol"]) {
+        palette = Companion::Instance->GetParseDataBySymbol(GetSafeNode<std::string>(node, "tlut_symbol"));
+    } else if (node["tlut"]) {
+        palette = Companion::Instance->GetParseDataByAddr(GetSafeNode<uint32_t>(node, "tlut"));
+    }
+
+    if (palette.has_value()) {
+        return std::static_pointer_cast<TextureData>(palette->data.value())->mBuffer;
+    }
+
+    // The TLUT is only added once its texture has been parsed, so it may not exist yet
+    if (node["tlut"] && node["colors"]) {
+        const auto colors = GetSafeNode<uint32_t>(node, "colors");
+        auto [_, segment] = Decompressor::AutoDecode(GetSafeNode<uint32_t>(node, "tlut"), colors * 2, Companion::Instance->GetRomData());
+        return std::vector(segment.data, segment.data + segment.size);
+    }
+
+    const auto symbol = GetSafeNode<std::string>(node, "symbol");
+    throw std::runtime_error("Could not find the tlut of '" + symbol + "', add a colors node or check the tlut and tlut_symbol nodes");
+}
+
+std::vector<uint8_t> TextureFactory::ParseModdedCI(std::vector<uint8_t>& buffer, YAML::Node& node, const TextureFormat& format, int* width, int* height) {
+    const auto tlut = GetModdingTlut(node);
+    const auto colors = std::min<int>(tlut.size() / 2, 1 << format.depth);
+    // Colors outside the TLUT are rejected unless the entry opts into mapping them to the nearest one
+    const auto quantize = GetSafeNode<bool>(node, "quantize", false);
+
+    const auto img = png2rgba(buffer.data(), buffer.size(), width, height);
+    if (img == nullptr) {
+        throw std::runtime_error("Failed to read PNG");
+    }
+
+    const auto pal = raw2rgba(tlut.data(), colors, 1, 16);
+    std::vector<uint8_t> result((*width * *height * format.depth + 7) / 8);
+    const auto size = rgba2rawci(result.data(), img, pal, *width * *height, colors, format.depth, quantize);
+    free(img);
+    free(pal);
+
+    if (size <= 0) {
+        throw std::runtime_error("Failed to convert PNG to texture, set quantize to map colors outside the tlut");
+    }
+
+    return result;
+}
+
 std::optional<std::shared_ptr<IParsedData>> TextureFactory::parse_modding(std::vector<uint8_t>& buffer, YAML::Node& node) {
     auto format = GetSafeNode<std::string>(node, "format");
     int width;
@@ -402,33 +438,15 @@ std::optional<std::shared_ptr<IParsedData>> TextureFactory::parse_modding(std::v
         }
         case TextureType::Palette8bpp:
         case TextureType::Palette4bpp: {
-            // This implementation is not correct.
-            // The process should be:
-            // png2rgba --> imgpal2rawci
-
-            // todo: Add wheel palette input
-            // Implement so that it works.
-
-            // auto tlut = GetSafeNode<std::string>(node,"tlut_symbol");
-            // auto tlutTextureMap = Companion::Instance->GetTlutTextureMap();
-            // auto palettePtr = tlutTextureMap[tlut];
-
-            // if (palettePtr) {
-
-            //     auto imgi = png2rgba(buffer.data(), buffer.size(), &width, &height);
-            //     auto pal = png2rgba(palettePtr->mBuffer.data(), (palettePtr->mWidth * palettePtr->mWidth * palettePtr->mFormat.depth * 2), &width, &height);
-
-            //     size = width * height * fmt.depth / 8;
-            //     raw = new uint8_t[size];
-
-            //     if(imgpal2rawci(raw, imgi, pal, 0, 0, width, height, fmt.depth) <= 0){
-            //         throw std::runtime_error("Failed to convert PNG to texture");
-            //     }
-            // } else {
-
-            // }
-            SPDLOG_ERROR("Unsupported texture format for modding: {}", format);
-            return std::nullopt;
+            // Textures without a TLUT are exported as grayscale indices
+            if (node["tlut"] || node["tlut_symbol"]) {
+                const auto indices = ParseModdedCI(buffer, node, fmt, &width, &height);
+                size = indices.size();
+                raw = new uint8_t[size];
+                std::copy(indices.begin(), indices.end(), raw);
+                break;
+            }
+            [[fallthrough]];
         }
         case TextureType::Grayscale8bpp:
         case TextureType::Grayscale4bpp: {
@@ -19,6 +19,7 @@ class TextureHeaderExporter : public BaseExporter {
 
 class TextureCodeExporter : public BaseExporter {
     ExportResult Export(std::ostream& write, std::shared_ptr<IParsedData> data, std::string& entryName, YAML::Node& node, std::string* replacement) override;
+    bool IsCacheable() override { return false; }
 };
 
 class TextureBinaryExporter : public BaseExporter {
@@ -31,7 +32,7 @@ class TextureModdingExporter : public BaseExporter {
 
 class TextureFactory : public BaseFactory {
 public:
-    std::optional<std::shared_ptr<IParsedData>> parse(std::vector<uint8_t>& buffer, YAML::Node& data) override;
+    std::optional<std::shared_ptr<IParsedData>> parse(std::span<uint8_t> buffer, YAML::Node& data) override;
     std::optional<std::shared_ptr<IParsedData>> parse_modding(std::vector<uint8_t>& buffer, YAML::Node& data) override;
     inline std::unordered_map<ExportType, std::shared_ptr<BaseExporter>> GetExporters() override {
         return {
@@ -42,4 +43,7 @@ public:
         };
     }
     bool SupportModdedAssets() override { return true; }
+
+    // Maps a modded CI4/CI8 PNG, exported as RGBA through its TLUT, back to palette indices
+    static std::vector<uint8_t> ParseModdedCI(std::vector<uint8_t>& buffer, YAML::Node& node, const TextureFormat& format, int* width, int* height);
 };
\ No newline at end of file
@@ -76,7 +76,7 @@ ExportResult Vec3fBinaryExporter::Export(std::ostream &write, std::shared_ptr<IP
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> Vec3fFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> Vec3fFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     std::vector<Vec3f> vecs;
     const auto count = GetSafeNode<int>(node, "count");
     auto [root, segment] = Decompressor::AutoDecode(node, buffer, count * sizeof(Vec3f));
@@ -74,7 +74,7 @@ ExportResult Vec3sBinaryExporter::Export(std::ostream &write, std::shared_ptr<IP
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> Vec3sFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> Vec3sFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     std::vector<Vec3s> vecs;
     const auto count = GetSafeNode<int>(node, "count");
     auto [root, segment] = Decompressor::AutoDecode(node, buffer, count * sizeof(Vec3s));
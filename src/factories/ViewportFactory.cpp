@@ -65,7 +65,7 @@ ExportResult ViewportBinaryExporter::Export(std::ostream &write, std::shared_ptr
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> ViewportFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> ViewportFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
     LUS::BinaryReader reader(segment.data, segment.size);
     VpRaw viewport;
@@ -3,14 +3,28 @@
 
 #include "Companion.h"
 #include "utils/Decompressor.h"
-
-#define NUM(x) std::dec << std::setfill(' ') << std::setw(6) << x
-#define COL(c) std::dec << std::setfill(' ') << std::setw(3) << c
+#include "utils/TextWriter.h"
+
+// {{{ x, y, z }, f, { tc1, tc2 }, { c1, c2, c3, c4 }}}
+static void WriteVtx(Torch::TextWriter& text, const VtxRaw& v) {
+    text << "{{{";
+    text.Dec(v.ob[0], 6) << ", ";
+    text.Dec(v.ob[1], 6) << ", ";
+    text.Dec(v.ob[2], 6) << "}, ";
+    text.Dec(v.flag) << ", {";
+    text.Dec(v.tc[0], 6) << ", ";
+    text.Dec(v.tc[1], 6) << "}, {";
+    text.Dec(v.cn[0], 3) << ", ";
+    text.Dec(v.cn[1], 3) << ", ";
+    text.Dec(v.cn[2], 3) << ", ";
+    text.Dec(v.cn[3], 3) << "}}},";
+}
 
 ExportResult VtxHeaderExporter::Export(std::ostream &write, std::shared_ptr<IParsedData> raw, std::string& entryName, YAML::Node &node, std::string* replacement) {
-    const auto symbol = GetSafeNode(node, "symbol", entryName);
-    auto vtx = std::static_pointer_cast<VtxData>(raw)->mVtxs;
-    const auto offset = GetSafeNode<uint32_t>(node, "offset");
+    const auto& asset = Companion::Instance->GetCurrentAsset();
+    const auto symbol = asset->symbol.value_or(entryName);
+    const auto& vtx = std::static_pointer_cast<VtxData>(raw)->mVtxs;
+    const auto offset = asset->offset.value();
 
     if(Companion::Instance->IsOTRMode()){
         write << "static const ALIGN_ASSET(2) char " << symbol << "[] = \"__OTR__" << (*replacement) << "\";\n\n";
@@ -36,9 +50,10 @@ ExportResult VtxHeaderExporter::Export(std::ostream &write, std::shared_ptr<IPar
 }
 
 ExportResult VtxCodeExporter::Export(std::ostream &write, std::shared_ptr<IParsedData> raw, std::string& entryName, YAML::Node &node, std::string* replacement ) {
-    auto vtx = std::static_pointer_cast<VtxData>(raw)->mVtxs;
-    const auto symbol = GetSafeNode(node, "symbol", entryName);
-    auto offset = GetSafeNode<uint32_t>(node, "offset");
+    const auto& vtx = std::static_pointer_cast<VtxData>(raw)->mVtxs;
+    const auto& asset = Companion::Instance->GetCurrentAsset();
+    const auto symbol = asset->symbol.value_or(entryName);
+    auto offset = asset->offset.value();
     const auto searchTable = Companion::Instance->SearchTable(offset);
 
     if(searchTable.has_value()){
@@ -49,67 +64,32 @@ ExportResult VtxCodeExporter::Export(std::ostream &write, std::shared_ptr<IParse
             write << "Vtx " << name << "[][" << vtx.size() << "] = {\n";
         }
 
-        write << fourSpaceTab << "{";
-
-        for (int i = 0; i < vtx.size(); ++i) {
-            auto v = vtx[i];
-
-            auto x = v.ob[0];
-            auto y = v.ob[1];
-            auto z = v.ob[2];
-
-            auto flag = v.flag;
+        Torch::TextWriter text(vtx.size() * 80);
+        text << fourSpaceTab << "{";
 
-            auto tc1 = v.tc[0];
-            auto tc2 = v.tc[1];
-
-            auto c1 = (uint16_t) v.cn[0];
-            auto c2 = (uint16_t) v.cn[1];
-            auto c3 = (uint16_t) v.cn[2];
-            auto c4 = (uint16_t) v.cn[3];
-
-            if(i <= vtx.size() - 1) {
-                write << "\n" << fourSpaceTab;
-            }
-
-            // {{{ x, y, z }, f, { tc1, tc2 }, { c1, c2, c3, c4 }}}
-            write << fourSpaceTab << "{{{" << NUM(x) << ", " << NUM(y) << ", " << NUM(z) << "}, " << flag << ", {" << NUM(tc1) << ", " << NUM(tc2) << "}, {" << COL(c1) << ", " << COL(c2) << ", " << COL(c3) << ", " << COL(c4) << "}}},";
+        for (const auto& v : vtx) {
+            text << "\n" << fourSpaceTab << fourSpaceTab;
+            WriteVtx(text, v);
         }
-        write << "\n" << fourSpaceTab << "},\n";
+        text << "\n" << fourSpaceTab << "},\n";
+        text.Flush(write);
 
         if(end == offset){
             write << "};\n\n";
         }
     } else {
 
-        write << "Vtx " << symbol << "[] = {\n";
-
-        for (int i = 0; i < vtx.size(); ++i) {
-            auto v = vtx[i];
-
-            auto x = v.ob[0];
-            auto y = v.ob[1];
-            auto z = v.ob[2];
+        Torch::TextWriter text(vtx.size() * 80);
+        text << "Vtx " << symbol << "[] = {\n";
 
-            auto flag = v.flag;
-
-            auto tc1 = v.tc[0];
-            auto tc2 = v.tc[1];
-
-            auto c1 = (uint16_t) v.cn[0];
-            auto c2 = (uint16_t) v.cn[1];
-            auto c3 = (uint16_t) v.cn[2];
-            auto c4 = (uint16_t) v.cn[3];
-
-            if(i <= vtx.size() - 1) {
-                write << fourSpaceTab;
-            }
-
-            // {{{ x, y, z }, f, { tc1, tc2 }, { c1, c2, c3, c4 }}}
-            write << "{{{" << NUM(x) << ", " << NUM(y) << ", " << NUM(z) << "}, " << flag << ", {" << NUM(tc1) << ", " << NUM(tc2) << "}, {" << COL(c1) << ", " << COL(c2) << ", " << COL(c3) << ", " << COL(c4) << "}}},\n";
+        for (const auto& v : vtx) {
+            text << fourSpaceTab;
+            WriteVtx(text, v);
+            text << '\n';
         }
 
-        write << "};\n";
+        text << "};\n";
+        text.Flush(write);
 
         if (Companion::Instance->IsDebug()) {
             write << "// count: " << std::to_string(vtx.size()) << " Vtxs\n";
@@ -150,7 +130,17 @@ ExportResult VtxBinaryExporter::Export(std::ostream &write, std::shared_ptr<IPar
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> VtxFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<uint32_t> VtxFactory::GetAssetSize(YAML::Node& node) {
+    auto count = GetNode<uint32_t>(node, "count");
+    if(!count.has_value()) {
+        return std::nullopt;
+    }
+
+    // Display lists reference vertices in 16 byte aligned chunks
+    return (count.value() * sizeof(VtxRaw) + 0xF) & ~0xF;
+}
+
+std::optional<std::shared_ptr<IParsedData>> VtxFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto count = GetSafeNode<size_t>(node, "count");
 
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
@@ -30,7 +30,7 @@ class VtxCodeExporter : public BaseExporter {
 
 class VtxFactory : public BaseFactory {
 public:
-    std::optional<std::shared_ptr<IParsedData>> parse(std::vector<uint8_t>& buffer, YAML::Node& data) override;
+    std::optional<std::shared_ptr<IParsedData>> parse(std::span<uint8_t> buffer, YAML::Node& data) override;
     inline std::unordered_map<ExportType, std::shared_ptr<BaseExporter>> GetExporters() override {
         return {
             REGISTER(Code, VtxCodeExporter)
@@ -41,4 +41,5 @@ public:
     uint32_t GetAlignment() override {
         return 8;
     };
+    std::optional<uint32_t> GetAssetSize(YAML::Node& node) override;
 };
\ No newline at end of file
@@ -590,7 +590,7 @@ ExportResult FZX::CourseModdingExporter::Export(std::ostream &write, std::shared
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> FZX::CourseFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> FZX::CourseFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
     LUS::BinaryReader reader(segment.data, segment.size);
 
@@ -112,7 +112,7 @@ ExportResult FZX::EADAnimationBinaryExporter::Export(std::ostream &write, std::s
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> FZX::EADAnimationFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> FZX::EADAnimationFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
     LUS::BinaryReader reader(segment.data, segment.size);
     const auto symbol = GetSafeNode<std::string>(node, "symbol");
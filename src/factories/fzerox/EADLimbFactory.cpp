@@ -114,7 +114,7 @@ ExportResult FZX::EADLimbBinaryExporter::Export(std::ostream &write, std::shared
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> FZX::EADLimbFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> FZX::EADLimbFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
     LUS::BinaryReader reader(segment.data, segment.size);
 
@@ -353,7 +353,7 @@ ExportResult FZX::GhostRecordModdingExporter::Export(std::ostream &write, std::s
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> FZX::GhostRecordFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> FZX::GhostRecordFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
     LUS::BinaryReader reader(segment.data, segment.size);
     bool isDiskDrive = GetSafeNode<bool>(node, "disk_drive", false);
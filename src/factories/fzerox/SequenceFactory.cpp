@@ -1293,7 +1293,7 @@ ExportResult FZX::SequenceBinaryExporter::Export(std::ostream &write, std::share
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> FZX::SequenceFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> FZX::SequenceFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
     const auto offset = GetSafeNode<uint32_t>(node, "offset");
     const auto symbol = GetSafeNode<std::string>(node, "symbol");
@@ -422,7 +422,7 @@ std::string FZX::SoundFontFactory::RegisterSoundFontData(std::string symbol, FZX
     return dataName;
 }
 
-std::optional<std::shared_ptr<IParsedData>> FZX::SoundFontFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> FZX::SoundFontFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
     const auto offset = GetSafeNode<uint32_t>(node, "offset");
     const auto symbol = GetSafeNode<std::string>(node, "symbol");
@@ -367,7 +367,7 @@ ExportResult MK64::CourseMetadataBinaryExporter::Export(std::ostream &write, std
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> MK64::CourseMetadataFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> MK64::CourseMetadataFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto dir = GetSafeNode<std::string>(node, "input_directory");
  
     auto m = Companion::Instance->GetCourseMetadata();
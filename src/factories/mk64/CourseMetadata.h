@@ -51,11 +51,12 @@ namespace MK64 {
 
     class CourseMetadataCodeExporter : public BaseExporter {
         ExportResult Export(std::ostream& write, std::shared_ptr<IParsedData> data, std::string& entryName, YAML::Node& node, std::string* replacement) override;
+        bool IsCacheable() override { return false; }
     };
 
     class CourseMetadataFactory : public BaseFactory {
     public:
-        std::optional<std::shared_ptr<IParsedData>> parse(std::vector<uint8_t>& buffer, YAML::Node& data) override;
+        std::optional<std::shared_ptr<IParsedData>> parse(std::span<uint8_t> buffer, YAML::Node& data) override;
         std::optional<std::shared_ptr<IParsedData>> parse_modding(std::vector<uint8_t>& buffer, YAML::Node& data) override {
             return std::nullopt;
         }
@@ -2,11 +2,9 @@
 
 #include "Companion.h"
 #include "utils/Decompressor.h"
+#include "utils/TextWriter.h"
 #include <cstdint>
 
-#define NUM(x) std::dec << std::setfill(' ') << std::setw(6) << x
-#define COL(c) "0x" << std::hex << std::setw(2) << std::setfill('0') << c
-
 ExportResult MK64::CourseVtxHeaderExporter::Export(std::ostream &write, std::shared_ptr<IParsedData> raw, std::string& entryName, YAML::Node &node, std::string* replacement) {
     const auto symbol = GetSafeNode(node, "symbol", entryName);
 
@@ -20,35 +18,29 @@ ExportResult MK64::CourseVtxHeaderExporter::Export(std::ostream &write, std::sha
 }
 
 ExportResult MK64::CourseVtxCodeExporter::Export(std::ostream &write, std::shared_ptr<IParsedData> raw, std::string& entryName, YAML::Node &node, std::string* replacement ) {
-    auto vtx = std::static_pointer_cast<CourseVtxData>(raw)->mVtxs;
+    const auto& vtx = std::static_pointer_cast<CourseVtxData>(raw)->mVtxs;
     const auto symbol = GetSafeNode(node, "symbol", entryName);
     const auto offset = GetSafeNode<uint32_t>(node, "offset");
 
-    write << "CourseVtx " << symbol << "[] = {\n";
-
-    for (int i = 0; i < vtx.size(); ++i) {
-        auto v = vtx[i];
-
-        auto x = v.ob[0];
-        auto y = v.ob[1];
-        auto z = v.ob[2];
-
-        auto tc1 = v.tc[0];
-        auto tc2 = v.tc[1];
-
-        auto c1 = (uint16_t) v.cn[0];
-        auto c2 = (uint16_t) v.cn[1];
-        auto c3 = (uint16_t) v.cn[2];
-        auto c4 = (uint16_t) v.cn[3];
-
-        if(i <= vtx.size() - 1) {
-            write << fourSpaceTab;
-        }
+    Torch::TextWriter text(vtx.size() * 80);
+    text << "CourseVtx " << symbol << "[] = {\n";
 
+    for (const auto& v : vtx) {
         // {{{ x, y, z }, { tc1, tc2 }, { c1, c2, c3, c4 }}}
-        write << "{{{" << NUM(x) << ", " << NUM(y) << ", " << NUM(z) << "}, {" << NUM(tc1) << ", " << NUM(tc2) << "}, {" << COL(c1) << ", " << COL(c2) << ", " << COL(c3) << ", " << COL(c4) << "}}},\n";
+        text << fourSpaceTab << "{{{";
+        text.Dec(v.ob[0], 6) << ", ";
+        text.Dec(v.ob[1], 6) << ", ";
+        text.Dec(v.ob[2], 6) << "}, {";
+        text.Dec(v.tc[0], 6) << ", ";
+        text.Dec(v.tc[1], 6) << "}, {";
+        text << "0x";
+        text.HexByte(v.cn[0]) << ", 0x";
+        text.HexByte(v.cn[1]) << ", 0x";
+        text.HexByte(v.cn[2]) << ", 0x";
+        text.HexByte(v.cn[3]) << "}}},\n";
     }
-    write << "};\n";
+    text << "};\n";
+    text.Flush(write);
 
     return offset + vtx.size() * sizeof(CourseVtx);
 }
@@ -75,7 +67,7 @@ ExportResult MK64::CourseVtxBinaryExporter::Export(std::ostream &write, std::sha
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> MK64::CourseVtxFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> MK64::CourseVtxFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto count = GetSafeNode<size_t>(node, "count");
 
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
@@ -74,7 +74,7 @@ ExportResult MK64::DrivingBehaviourBinaryExporter::Export(std::ostream &write, s
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> MK64::DrivingBehaviourFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> MK64::DrivingBehaviourFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
     LUS::BinaryReader reader(segment.data, segment.size);
 
@@ -31,7 +31,7 @@ namespace MK64 {
 
     class DrivingBehaviourFactory : public BaseFactory {
     public:
-        std::optional<std::shared_ptr<IParsedData>> parse(std::vector<uint8_t>& buffer, YAML::Node& data) override;
+        std::optional<std::shared_ptr<IParsedData>> parse(std::span<uint8_t> buffer, YAML::Node& data) override;
         std::optional<std::shared_ptr<IParsedData>> parse_modding(std::vector<uint8_t>& buffer, YAML::Node& data) override {
             return std::nullopt;
         }
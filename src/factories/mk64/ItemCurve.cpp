@@ -79,7 +79,7 @@ ExportResult MK64::ItemCurveBinaryExporter::Export(std::ostream &write, std::sha
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> MK64::ItemCurveFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> MK64::ItemCurveFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
     LUS::BinaryReader reader(segment.data, (10 * 10) * sizeof(uint8_t));
 
@@ -544,7 +544,7 @@ static inline uint16_t RD16(const std::vector<uint8_t>& b, size_t i) {
     return (uint16_t)((b[i + 1] << 8) | b[i]);
 }
 
-std::optional<std::shared_ptr<IParsedData>> MK64::PackedDListFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& data) {
+std::optional<std::shared_ptr<IParsedData>> MK64::PackedDListFactory::parse(std::span<uint8_t> buffer, YAML::Node& data) {
     auto [_, segment] = Decompressor::AutoDecode(data, buffer);
     std::vector<uint8_t> decoded(segment.data, segment.data + segment.size);
 
@@ -558,7 +558,7 @@ std::optional<std::shared_ptr<IParsedData>> MK64::PackedDListFactory::parse(std:
     };
 
     // Minimal expansion for export purposes
-    std::vector<uint8_t>& raw = buffer; // pour compatibilité éventuelle avec le reste du code
+    std::span<uint8_t> raw = buffer; // pour compatibilité éventuelle avec le reste du code
     YAML::Node& node = data;
 
     while (i < decoded.size()) {
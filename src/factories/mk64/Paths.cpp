@@ -65,7 +65,7 @@ ExportResult MK64::PathBinaryExporter::Export(std::ostream& write, std::shared_p
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> MK64::PathsFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> MK64::PathsFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto count = GetSafeNode<size_t>(node, "count");
 
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
@@ -63,7 +63,7 @@ ExportResult MK64::UnkSpawnDataBinaryExporter::Export(std::ostream &write, std::
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> MK64::UnkSpawnDataFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> MK64::UnkSpawnDataFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto count = GetSafeNode<size_t>(node, "count");
 
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
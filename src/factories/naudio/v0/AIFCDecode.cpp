@@ -3,11 +3,13 @@
  * that roundtrips with vadpcm_enc.
  */
 #include "AIFCDecode.h"
+#include "VADPCM.h"
 #include <cassert>
 #include <cstring>
 #include <cstdio>
 #include <cstdlib>
 #include <cstdarg>
+#include <optional>
 #include <stdexcept>
 #include "lib/binarytools/BinaryWriter.h"
 #include "lib/binarytools/BinaryReader.h"
@@ -142,77 +144,26 @@ void fail_parse(const char *fmt, ...)
     throw std::runtime_error("Error parsing file");
 }
 
-s32 myrand()
+VADPCMBook readaifccodebook(LUS::BinaryReader& fhandle)
 {
-    static u64 state = 1619236481962341ULL;
-    state *= 3123692312231ULL;
-    state++;
-    return state >> 33;
-}
-
-s16 qsample(s32 x, s32 scale)
-{
-    // Compute x / 2^scale rounded to the nearest integer, breaking ties towards zero.
-    if (scale == 0) return x;
-    return (x + (1 << (scale - 1)) - (x > 0)) >> scale;
-}
-
-s16 clamp_to_s16(s32 x)
-{
-    if (x < -0x8000) return -0x8000;
-    if (x > 0x7fff) return 0x7fff;
-    return (s16) x;
-}
-
-s32 toi4(s32 x)
-{
-    if (x >= 8) return x - 16;
-    return x;
-}
-
-s32 readaifccodebook(LUS::BinaryReader& fhandle, s32 ****table, s16 *order, s16 *npredictors)
-{
-    checked_fread(order, sizeof(s16), 1, fhandle);
-    BSWAP16(*order);
-    checked_fread(npredictors, sizeof(s16), 1, fhandle);
-    BSWAP16(*npredictors);
-    *table = new s32**[*npredictors];
-    for (s32 i = 0; i < *npredictors; i++) {
-        (*table)[i] = new s32*[8];
-        for (s32 j = 0; j < 8; j++) {
-            (*table)[i][j] = new s32[*order + 8];
-        }
+    s16 order;
+    s16 npredictors;
+    checked_fread(&order, sizeof(s16), 1, fhandle);
+    BSWAP16(order);
+    checked_fread(&npredictors, sizeof(s16), 1, fhandle);
+    BSWAP16(npredictors);
+
+    if (order < 1 || npredictors < 1) {
+        fail_parse("Invalid codebook with order %d and %d predictors", order, npredictors);
     }
 
-    for (s32 i = 0; i < *npredictors; i++) {
-        s32 **table_entry = (*table)[i];
-        for (s32 j = 0; j < *order; j++) {
-            for (s32 k = 0; k < 8; k++) {
-                s16 ts;
-                checked_fread(&ts, sizeof(s16), 1, fhandle);
-                BSWAP16(ts);
-                table_entry[k][j] = ts;
-            }
-        }
-
-        for (s32 k = 1; k < 8; k++) {
-            table_entry[k][*order] = table_entry[k - 1][*order - 1];
-        }
-
-        table_entry[0][*order] = 1 << 11;
-
-        for (s32 k = 1; k < 8; k++) {
-            s32 j = 0;
-            for (; j < k; j++) {
-                table_entry[j][k + *order] = 0;
-            }
-
-            for (; j < 8; j++) {
-                table_entry[j][k + *order] = table_entry[j - k][*order];
-            }
-        }
+    std::vector<int16_t> codebook(order * npredictors * 8);
+    for (auto& ts : codebook) {
+        checked_fread(&ts, sizeof(s16), 1, fhandle);
+        BSWAP16(ts);
     }
-    return 0;
+
+    return VADPCMBook::FromCodebook(codebook, order, npredictors);
 }
 
 ALADPCMloop *readlooppoints(LUS::BinaryReader& reader, s16 *nloops) {
@@ -229,166 +180,6 @@ ALADPCMloop *readlooppoints(LUS::BinaryReader& reader, s16 *nloops) {
     return al;
 }
 
-s32 inner_product(s32 length, s32 *v1, s32 *v2)
-{
-    s32 out = 0;
-    for (s32 i = 0; i < length; i++) {
-        out += v1[i] * v2[i];
-    }
-
-    // Compute "out / 2^11", rounded down.
-    s32 dout = out / (1 << 11);
-    s32 fiout = dout * (1 << 11);
-    return dout - (out - fiout < 0);
-}
-
-void my_decodeframe(u8 *frame, s32 *state, s32 order, s32 ***coefTable)
-{
-    s32 ix[16];
-
-    u8 header = frame[0];
-    s32 scale = 1 << (header >> 4);
-    s32 optimalp = header & 0xf;
-
-    for (s32 i = 0; i < 16; i += 2) {
-        u8 c = frame[1 + i/2];
-        ix[i] = c >> 4;
-        ix[i + 1] = c & 0xf;
-    }
-
-    for (s32 i = 0; i < 16; i++) {
-        if (ix[i] >= 8) ix[i] -= 16;
-        ix[i] *= scale;
-    }
-
-    for (s32 j = 0; j < 2; j++) {
-        s32 in_vec[16];
-        if (j == 0) {
-            for (s32 i = 0; i < order; i++) {
-                in_vec[i] = state[16 - order + i];
-            }
-        } else {
-            for (s32 i = 0; i < order; i++) {
-                in_vec[i] = state[8 - order + i];
-            }
-        }
-
-        for (s32 i = 0; i < 8; i++) {
-            s32 ind = j * 8 + i;
-            in_vec[order + i] = ix[ind];
-            state[ind] = inner_product(order + i, coefTable[optimalp][i], in_vec) + ix[ind];
-        }
-    }
-}
-
-void my_encodeframe(u8 *out, s16 *inBuffer, s32 *state, s32 ***coefTable, s32 order, s32 npredictors)
-{
-    s16 ix[16];
-    s32 prediction[16];
-    s32 inVector[16];
-    s32 saveState[16];
-    s32 optimalp = 0;
-    s32 scale;
-    s32 ie[16];
-    s32 e[16];
-    f32 min = 1e30;
-
-    for (s32 k = 0; k < npredictors; k++) {
-        for (s32 j = 0; j < 2; j++) {
-            for (s32 i = 0; i < order; i++) {
-                inVector[i] = (j == 0 ? state[16 - order + i] : inBuffer[8 - order + i]);
-            }
-
-            for (s32 i = 0; i < 8; i++) {
-                prediction[j * 8 + i] = inner_product(order + i, coefTable[k][i], inVector);
-                e[j * 8 + i] = inVector[i + order] = inBuffer[j * 8 + i] - prediction[j * 8 + i];
-            }
-        }
-
-        f32 se = 0.0f;
-        for (s32 j = 0; j < 16; j++) {
-            se += (f32) e[j] * (f32) e[j];
-        }
-
-        if (se < min) {
-            min = se;
-            optimalp = k;
-        }
-    }
-
-    for (s32 j = 0; j < 2; j++) {
-        for (s32 i = 0; i < order; i++) {
-            inVector[i] = (j == 0 ? state[16 - order + i] : inBuffer[8 - order + i]);
-        }
-
-        for (s32 i = 0; i < 8; i++) {
-            prediction[j * 8 + i] = inner_product(order + i, coefTable[optimalp][i], inVector);
-            e[j * 8 + i] = inVector[i + order] = inBuffer[j * 8 + i] - prediction[j * 8 + i];
-        }
-    }
-
-    for (s32 i = 0; i < 16; i++) {
-        ie[i] = clamp_to_s16(e[i]);
-    }
-
-    s32 max = 0;
-    for (s32 i = 0; i < 16; i++) {
-        if (abs(ie[i]) > abs(max)) {
-            max = ie[i];
-        }
-    }
-
-    for (scale = 0; scale <= 12; scale++) {
-        if (max <= 7 && max >= -8) break;
-        max /= 2;
-    }
-
-    for (s32 i = 0; i < 16; i++) {
-        saveState[i] = state[i];
-    }
-
-    for (s32 nIter = 0, again = 1; nIter < 2 && again; nIter++) {
-        again = 0;
-        if (nIter == 1) scale++;
-        if (scale > 12) {
-            scale = 12;
-        }
-
-        for (s32 j = 0; j < 2; j++) {
-            s32 base = j * 8;
-            for (s32 i = 0; i < order; i++) {
-                inVector[i] = (j == 0 ?
-                        saveState[16 - order + i] : state[8 - order + i]);
-            }
-
-            for (s32 i = 0; i < 8; i++) {
-                prediction[base + i] = inner_product(order + i, coefTable[optimalp][i], inVector);
-                s32 se = inBuffer[base + i] - prediction[base + i];
-                ix[base + i] = qsample(se, scale);
-                s32 cV = clamp_to_s16(ix[base + i]) - ix[base + i];
-                if (cV > 1 || cV < -1) again = 1;
-                ix[base + i] += cV;
-                inVector[i + order] = ix[base + i] * (1 << scale);
-                state[base + i] = prediction[base + i] + inVector[i + order];
-            }
-        }
-    }
-
-    u8 header = (scale << 4) | (optimalp & 0xf);
-    out[0] = header;
-    for (s32 i = 0; i < 16; i += 2) {
-        u8 c = ((ix[i] & 0xf) << 4) | (ix[i + 1] & 0xf);
-        out[1 + i/2] = c;
-    }
-}
-
-void permute(s16 *out, s32 *in, s32 scale)
-{
-    for (s32 i = 0; i < 16; i++) {
-        out[i] = clamp_to_s16(in[i] - scale / 2 + myrand() % (scale + 1));
-    }
-}
-
 void WriteString(const char* str, int32_t size, LUS::BinaryWriter& writer) {
     for (int i = 0; i < size; i++) {
         writer.Write((uint8_t) str[i]);
@@ -401,14 +192,11 @@ void write_header(LUS::BinaryWriter& writer, std::string id, s32 size) {
 }
 
 void write_aiff(std::vector<char> data, LUS::BinaryWriter& writer) {
-    s16 order = -1;
     s16 nloops = 0;
     ALADPCMloop *aloops = nullptr;
-    s16 npredictors = -1;
-    s32 ***coefTable = nullptr;
+    std::optional<VADPCMBook> book;
     s32 state[16] = {0};
     s32 soundPointer = -1;
-    s32 currPos = 0;
     s32 nSamples = 0;
     Chunk FormChunk;
     ChunkHeader Header;
@@ -496,7 +284,7 @@ void write_aiff(std::vector<char> data, LUS::BinaryWriter& writer) {
                         if (version != 1) {
                             fail_parse("Unknown codebook chunk version");
                         }
-                        readaifccodebook(reader, &coefTable, &order, &npredictors);
+                        book = readaifccodebook(reader);
                     }
                     else if (strcmp("VADPCMLOOPS", ChunkName) == 0) {
                         checked_fread(&version, sizeof(s16), 1, reader);
@@ -516,77 +304,26 @@ void write_aiff(std::vector<char> data, LUS::BinaryWriter& writer) {
         reader.Seek(offset + Header.ckSize, LUS::SeekOffsetType::Start);
     }
 
-    if (coefTable == nullptr) {
+    if (!book.has_value()) {
         fail_parse("Codebook missing from bitstream");
     }
 
-    for (s32 i = 0; i < order; i++) {
-        state[15 - i] = 0;
-    }
-
+    const s32 order = book->order;
+    const s32 npredictors = book->npredictors;
     u32 outputBytes = nSamples * sizeof(s16);
 
-    reader.Seek(soundPointer, LUS::SeekOffsetType::Start);
+    // Decode every frame at once, only the clamped samples end up in the AIFF
+    const size_t nFrames = nSamples / VADPCM_FRAME_SAMPLES;
+    std::vector<u8> frames(nFrames * VADPCM_FRAME_SIZE);
+    std::vector<s16> samples(nSamples);
 
-    while (currPos < nSamples) {
-        u8 input[9] = {0};
-        u8 encoded[9] = {0};
-        s32 lastState[16] = {0};
-        s32 decoded[16] = {0};
-        s16 guess[16] = {0};
-        s16 origGuess[16] = {0};
-
-        memcpy(lastState, state, sizeof(lastState));
-        checked_fread(input, 9, 1, reader);
-
-        // Decode for real
-        my_decodeframe(input, state, order, coefTable);
-        memcpy(decoded, state, sizeof(lastState));
-
-        // Create a guess from that, by clamping to 16 bits
-        for (s32 i = 0; i < 16; i++) {
-            origGuess[i] = clamp_to_s16(state[i]);
-        }
-
-        // Encode the guess
-        memcpy(state, lastState, sizeof(lastState));
-        memcpy(guess, origGuess, sizeof(guess));
-        my_encodeframe(encoded, guess, state, coefTable, order, npredictors);
-
-        // If it doesn't match, randomly round numbers until it does.
-        if (0 && memcmp(input, encoded, 9) != 0) {
-            s32 scale = 1 << (input[0] >> 4);
-            do {
-                permute(guess, decoded, scale);
-                memcpy(state, lastState, sizeof(lastState));
-                my_encodeframe(encoded, guess, state, coefTable, order, npredictors);
-            } while (memcmp(input, encoded, 9) != 0);
-
-            // Bring the matching closer to the original decode (not strictly
-            // necessary, but it will move us closer to the target on average).
-            for (s32 failures = 0; failures < 50; failures++) {
-                s32 ind = myrand() % 16;
-                s32 old = guess[ind];
-                if (old == origGuess[ind]) continue;
-                guess[ind] = origGuess[ind];
-                if (myrand() % 2) guess[ind] += (old - origGuess[ind]) / 2;
-                memcpy(state, lastState, sizeof(lastState));
-                my_encodeframe(encoded, guess, state, coefTable, order, npredictors);
-                if (memcmp(input, encoded, 9) == 0) {
-                    failures = -1;
-                }
-                else {
-                    guess[ind] = old;
-                }
-            }
-        }
+    reader.Seek(soundPointer, LUS::SeekOffsetType::Start);
+    checked_fread(frames.data(), frames.size(), 1, reader);
+    vadpcm_decode(book.value(), frames.data(), nFrames, state, samples.data());
 
-        memcpy(state, decoded, sizeof(lastState));
-        BSWAP16_MANY(guess, 16);
-        writer.Seek(currPos * 2, LUS::SeekOffsetType::Start);
-        writer.Write((char*) guess, sizeof(guess));
-        currPos += 16;
-    }
+    BSWAP16_MANY(samples.data(), nSamples);
+    writer.Seek(0, LUS::SeekOffsetType::Start);
+    writer.Write((char*) samples.data(), outputBytes);
 
     // Write an incomplete file header. We'll fill in the size later.
     writer.Seek(0, LUS::SeekOffsetType::Start);
@@ -649,7 +386,7 @@ void write_aiff(std::vector<char> data, LUS::BinaryWriter& writer) {
     for (s32 i = 0; i < npredictors; i++) {
         for (s32 j = 0; j < order; j++) {
             for (s32 k = 0; k < 8; k++) {
-                s16 ts = bswap16(coefTable[i][k][j]);
+                s16 ts = bswap16(book->Coef(i, k, j));
                 writer.Write(ts);
             }
         }
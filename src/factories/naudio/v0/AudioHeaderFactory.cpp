@@ -38,7 +38,7 @@ ExportResult AudioAIFCExporter::Export(std::ostream& write, std::shared_ptr<IPar
 }
 */
 
-std::optional<std::shared_ptr<IParsedData>> AudioHeaderFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& data) {
+std::optional<std::shared_ptr<IParsedData>> AudioHeaderFactory::parse(std::span<uint8_t> buffer, YAML::Node& data) {
     AudioManager::Instance->initialize(buffer, data);
     return std::make_shared<IParsedData>();
 }
\ No newline at end of file
@@ -67,7 +67,7 @@ void Bank::print() const {
     SPDLOG_DEBUG("Sample Bank Offset: {}", std::to_string(sampleBank->offset));
 }
 
-std::vector<Entry> AudioManager::parse_seq_file(std::vector<uint8_t>& buffer, uint32_t offset, bool isCTL){
+std::vector<Entry> AudioManager::parse_seq_file(std::span<uint8_t> buffer, uint32_t offset, bool isCTL){
     std::vector<Entry> entries;
     LUS::BinaryReader reader((char*) buffer.data(), buffer.size());
     reader.SetEndianness(Torch::Endianness::Big);
@@ -443,7 +443,7 @@ TBLFile AudioManager::parse_tbl(std::vector<uint8_t>& data, std::vector<Entry>&
     return tbl;
 }
 
-void AudioManager::initialize(std::vector<uint8_t>& buffer, YAML::Node& data) {
+void AudioManager::initialize(std::span<uint8_t> buffer, YAML::Node& data) {
 
     auto ctlOffset = data["ctl"]["offset"].as<size_t>();
     auto ctlSize = data["ctl"]["size"].as<size_t>();
@@ -477,13 +477,16 @@ void AudioManager::initialize(std::vector<uint8_t>& buffer, YAML::Node& data) {
         SPDLOG_INFO("Processed Bank {}", index);
     }
 
-    int32_t idx = -1;
+    this->samples.clear();
+    this->sampleMap.clear();
     for(auto &sample_bank : this->loaded_tbl.banks){
-        auto offsets = PyUtils::keys(sample_bank->entries);
-        std::sort(offsets.begin(), offsets.end());
-
-        for(auto &offset : offsets){
-            this->sampleMap[sample_bank->entries[offset]] = ++idx;
+        // entries is ordered by offset, which is the order the sample ids are assigned in
+        for(auto &[offset, sample] : sample_bank->entries){
+            if(this->sampleMap.contains(sample)){
+                continue;
+            }
+            this->sampleMap[sample] = this->samples.size();
+            this->samples.push_back(sample);
         }
     }
 }
@@ -517,47 +520,31 @@ void AudioManager::create_aifc(int32_t index, LUS::BinaryWriter &out) {
 }
 */
 
-AudioBankSample AudioManager::get_aifc(int32_t index) {
-    int32_t idx = 0;
-    for(auto &sample_bank : this->loaded_tbl.banks){
-        auto offsets = PyUtils::keys(sample_bank->entries);
-        std::sort(offsets.begin(), offsets.end());
-
-        for(auto &offset : offsets){
-            if(idx++ == index){
-                return *sample_bank->entries[offset];
-            }
-        }
+const AudioBankSample& AudioManager::get_aifc(int32_t index) const {
+    if(index < 0 || index >= this->samples.size()){
+        SPDLOG_ERROR("Invalid Index {}", index);
+        throw std::runtime_error("Invalid index");
     }
 
-    SPDLOG_ERROR("Invalid Index {}", index);
-    throw std::runtime_error("Invalid index");
+    return *this->samples[index];
 }
 
-uint32_t AudioManager::get_index(AudioBankSample* entry) {
-    if(!this->sampleMap.contains(entry)){
+uint32_t AudioManager::get_index(AudioBankSample* entry) const {
+    const auto it = this->sampleMap.find(entry);
+    if(it == this->sampleMap.end()){
         return -1;
     }
-    return this->sampleMap[entry];
+    return it->second;
 }
 
-std::map<uint32_t, Bank> AudioManager::get_banks() {
+const std::map<uint32_t, Bank>& AudioManager::get_banks() const {
     return this->banks;
 }
 
-std::vector<SampleBank*> AudioManager::get_loaded_banks() {
+const std::vector<SampleBank*>& AudioManager::get_loaded_banks() const {
     return this->loaded_tbl.banks;
 }
 
-std::vector<AudioBankSample*> AudioManager::get_samples() {
-    std::vector<AudioBankSample*> samples;
-    for(auto &bank : this->loaded_tbl.banks){
-        for(auto &entry : bank->entries){
-            // Avoid duplicates
-            if(std::find(samples.begin(), samples.end(), entry.second) == samples.end()){
-                samples.push_back(entry.second);
-            }
-        }
-    }
-    return samples;
-}
\ No newline at end of file
+const std::vector<AudioBankSample*>& AudioManager::get_samples() const {
+    return this->samples;
+}
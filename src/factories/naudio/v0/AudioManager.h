@@ -1,6 +1,8 @@
 #pragma once
 
 #include <map>
+#include <unordered_map>
+#include <span>
 #include <vector>
 #include <string>
 #include <iostream>
@@ -124,20 +126,22 @@ struct Bank {
 class AudioManager {
 public:
     static AudioManager* Instance;
-    void initialize(std::vector<uint8_t>& buffer, YAML::Node& data);
+    void initialize(std::span<uint8_t> buffer, YAML::Node& data);
     void bind_sample(YAML::Node& node, const std::string& path);
     std::string& get_sample(uint32_t id);
-    AudioBankSample get_aifc(int32_t index);
-    std::map<uint32_t, Bank> get_banks();
-    std::vector<SampleBank*> get_loaded_banks();
-    std::vector<AudioBankSample*> get_samples();
-    uint32_t get_index(AudioBankSample* bank);
+    const AudioBankSample& get_aifc(int32_t index) const;
+    const std::map<uint32_t, Bank>& get_banks() const;
+    const std::vector<SampleBank*>& get_loaded_banks() const;
+    const std::vector<AudioBankSample*>& get_samples() const;
+    uint32_t get_index(AudioBankSample* bank) const;
 private:
     std::map<uint32_t, Bank> banks;
-    std::map<AudioBankSample*, uint32_t> sampleMap;
+    // Every sample of every bank, ordered by bank and offset, built once on initialize
+    std::vector<AudioBankSample*> samples;
+    std::unordered_map<AudioBankSample*, uint32_t> sampleMap;
     TBLFile loaded_tbl;
 
-    static std::vector<Entry> parse_seq_file(std::vector<uint8_t>& buffer, uint32_t offset, bool isCTL);
+    static std::vector<Entry> parse_seq_file(std::span<uint8_t> buffer, uint32_t offset, bool isCTL);
     static CTLHeader parse_ctl_header(std::vector<uint8_t>& data);
     static std::optional<AudioBankSound> parse_sound(std::vector<uint8_t> data);
     static Drum parse_drum(std::vector<uint8_t>& data, uint32_t addr);
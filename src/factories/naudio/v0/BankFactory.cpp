@@ -87,13 +87,18 @@ ExportResult BankBinaryExporter::Export(std::ostream &write, std::shared_ptr<IPa
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> BankFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& data) {
-    auto banks = AudioManager::Instance->get_banks();
+std::optional<std::shared_ptr<IParsedData>> BankFactory::parse(std::span<uint8_t> buffer, YAML::Node& data) {
     auto bankId = data["id"].as<uint32_t>();
 
     if(AudioManager::Instance == nullptr){
         throw std::runtime_error("AudioManager not initialized");
     }
 
-    return std::make_shared<BankData>(banks[bankId], bankId);
+    const auto& banks = AudioManager::Instance->get_banks();
+    const auto bank = banks.find(bankId);
+    if(bank == banks.end()){
+        throw std::runtime_error("Failed to find bank with id " + std::to_string(bankId));
+    }
+
+    return std::make_shared<BankData>(bank->second, bankId);
 }
\ No newline at end of file
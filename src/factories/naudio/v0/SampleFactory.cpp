@@ -53,11 +53,11 @@ ExportResult SampleBinaryExporter::Export(std::ostream &write, std::shared_ptr<I
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SampleFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& data) {
+std::optional<std::shared_ptr<IParsedData>> SampleFactory::parse(std::span<uint8_t> buffer, YAML::Node& data) {
     const auto id = data["id"].as<int32_t>();
     if(AudioManager::Instance == nullptr){
         throw std::runtime_error("AudioManager not initialized");
     }
-    AudioBankSample entry = AudioManager::Instance->get_aifc(id);
+    const auto& entry = AudioManager::Instance->get_aifc(id);
     return std::make_shared<SampleData>(entry);
 }
\ No newline at end of file
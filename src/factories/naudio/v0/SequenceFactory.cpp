@@ -26,7 +26,7 @@ ExportResult SequenceModdingExporter::Export(std::ostream &write, std::shared_pt
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SequenceFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& data) {
+std::optional<std::shared_ptr<IParsedData>> SequenceFactory::parse(std::span<uint8_t> buffer, YAML::Node& data) {
     auto id = data["id"].as<uint32_t>();
     auto size = data["size"].as<size_t>();
     const auto offset = data["offset"].as<size_t>();
@@ -25,7 +25,8 @@ class SequenceModdingExporter : public BaseExporter {
 
 class SequenceFactory : public BaseFactory {
 public:
-    std::optional<std::shared_ptr<IParsedData>> parse(std::vector<uint8_t>& buffer, YAML::Node& data) override;
+    std::optional<std::shared_ptr<IParsedData>> parse(std::span<uint8_t> buffer, YAML::Node& data) override;
+    bool HasSharedState() override { return true; }
     std::optional<std::shared_ptr<IParsedData>> parse_modding(std::vector<uint8_t>& buffer, YAML::Node& data) override;
 
     inline std::unordered_map<ExportType, std::shared_ptr<BaseExporter>> GetExporters() override {
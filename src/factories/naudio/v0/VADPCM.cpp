@@ -0,0 +1,285 @@
+#include "VADPCM.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+namespace {
+
+// Eight 32 bit accumulators, one per output of a half frame
+class Lanes {
+public:
+#if defined(__AVX2__)
+    Lanes() : mValue(_mm256_setzero_si256()) {}
+
+    void MultiplyAdd(const int32_t* column, int32_t value) {
+        const auto weights = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column));
+        this->mValue = _mm256_add_epi32(this->mValue, _mm256_mullo_epi32(weights, _mm256_set1_epi32(value)));
+    }
+
+    // Every lane divided by 2^11, rounded down
+    void Predict(int32_t* out) const {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_srai_epi32(this->mValue, 11));
+    }
+private:
+    __m256i mValue;
+#elif defined(__SSE4_1__)
+    Lanes() : mLow(_mm_setzero_si128()), mHigh(_mm_setzero_si128()) {}
+
+    void MultiplyAdd(const int32_t* column, int32_t value) {
+        const auto factor = _mm_set1_epi32(value);
+        const auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column));
+        const auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + 4));
+        this->mLow = _mm_add_epi32(this->mLow, _mm_mullo_epi32(low, factor));
+        this->mHigh = _mm_add_epi32(this->mHigh, _mm_mullo_epi32(high, factor));
+    }
+
+    void Predict(int32_t* out) const {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_srai_epi32(this->mLow, 11));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_srai_epi32(this->mHigh, 11));
+    }
+private:
+    __m128i mLow;
+    __m128i mHigh;
+#else
+    Lanes() = default;
+
+    // Unsigned so overflow wraps around like the vector paths do
+    void MultiplyAdd(const int32_t* column, int32_t value) {
+        for (int32_t i = 0; i < VADPCMBook::Rows; i++) {
+            this->mValue[i] += static_cast<uint32_t>(column[i]) * static_cast<uint32_t>(value);
+        }
+    }
+
+    void Predict(int32_t* out) const {
+        for (int32_t i = 0; i < VADPCMBook::Rows; i++) {
+            out[i] = static_cast<int32_t>(this->mValue[i]) >> 11;
+        }
+    }
+private:
+    uint32_t mValue[VADPCMBook::Rows] = {};
+#endif
+};
+
+int16_t clamp_to_s16(int32_t x) {
+    if (x < -0x8000) return -0x8000;
+    if (x > 0x7fff) return 0x7fff;
+    return (int16_t) x;
+}
+
+int16_t qsample(int32_t x, int32_t scale) {
+    // Compute x / 2^scale rounded to the nearest integer, breaking ties towards zero.
+    if (scale == 0) return x;
+    return (x + (1 << (scale - 1)) - (x > 0)) >> scale;
+}
+
+// Predicts the 8 samples of a half frame one by one, fn turns each prediction into the input the next ones see
+template<typename Fn>
+void predict_half(const VADPCMBook& book, int32_t predictor, const int32_t* history, Fn&& fn) {
+    Lanes acc;
+    int32_t prediction[VADPCMBook::Rows];
+
+    for (int32_t c = 0; c < book.order; c++) {
+        acc.MultiplyAdd(book.Column(predictor, c), history[c]);
+    }
+
+    for (int32_t i = 0; i < VADPCMBook::Rows; i++) {
+        acc.Predict(prediction);
+        const int32_t input = fn(i, prediction[i]);
+        if (i + 1 < VADPCMBook::Rows) {
+            acc.MultiplyAdd(book.Column(predictor, book.order + i), input);
+        }
+    }
+}
+
+}
+
+VADPCMBook VADPCMBook::FromCodebook(const std::vector<int16_t>& codebook, int32_t order, int32_t npredictors) {
+    if (order < 1 || order > Columns - Rows) {
+        throw std::runtime_error("Unsupported VADPCM codebook order " + std::to_string(order));
+    }
+
+    if (npredictors < 1 || npredictors > 16 || codebook.size() < static_cast<size_t>(order * npredictors * Rows)) {
+        throw std::runtime_error("Invalid VADPCM codebook");
+    }
+
+    VADPCMBook book;
+    book.order = order;
+    book.npredictors = npredictors;
+    book.coefs.assign(npredictors * Columns * Rows, 0);
+
+    for (int32_t p = 0; p < npredictors; p++) {
+        int32_t table[Rows][Columns] = {};
+
+        for (int32_t j = 0; j < order; j++) {
+            for (int32_t k = 0; k < Rows; k++) {
+                table[k][j] = codebook[(p * order + j) * Rows + k];
+            }
+        }
+
+        table[0][order] = 1 << 11;
+        for (int32_t k = 1; k < Rows; k++) {
+            table[k][order] = table[k - 1][order - 1];
+        }
+
+        for (int32_t k = 1; k < Rows; k++) {
+            for (int32_t j = k; j < Rows; j++) {
+                table[j][k + order] = table[j - k][order];
+            }
+        }
+
+        // Output k only sees the history and the inputs before it
+        for (int32_t k = 0; k < Rows; k++) {
+            for (int32_t c = 0; c < order + k; c++) {
+                book.coefs[(p * Columns + c) * Rows + k] = table[k][c];
+            }
+        }
+    }
+
+    return book;
+}
+
+void vadpcm_decode_frame(const VADPCMBook& book, const uint8_t* frame, int32_t* state) {
+    int32_t ix[VADPCM_FRAME_SAMPLES];
+    const int32_t scale = 1 << (frame[0] >> 4);
+    const int32_t predictor = frame[0] & 0xf;
+
+    if (predictor >= book.npredictors) {
+        throw std::runtime_error("VADPCM frame uses an unknown predictor");
+    }
+
+    for (int32_t i = 0; i < VADPCM_FRAME_SAMPLES; i += 2) {
+        const uint8_t c = frame[1 + i / 2];
+        ix[i] = c >> 4;
+        ix[i + 1] = c & 0xf;
+    }
+
+    for (int32_t i = 0; i < VADPCM_FRAME_SAMPLES; i++) {
+        if (ix[i] >= 8) ix[i] -= 16;
+        ix[i] *= scale;
+    }
+
+    // Every input of a half frame is known up front, so all 8 outputs come out of one pass
+    for (int32_t j = 0; j < 2; j++) {
+        const int32_t* history = j == 0 ? state + 16 - book.order : state + 8 - book.order;
+        const int32_t base = j * 8;
+        int32_t prediction[VADPCMBook::Rows];
+        Lanes acc;
+
+        for (int32_t c = 0; c < book.order; c++) {
+            acc.MultiplyAdd(book.Column(predictor, c), history[c]);
+        }
+        for (int32_t i = 0; i < VADPCMBook::Rows - 1; i++) {
+            acc.MultiplyAdd(book.Column(predictor, book.order + i), ix[base + i]);
+        }
+        acc.Predict(prediction);
+
+        for (int32_t i = 0; i < VADPCMBook::Rows; i++) {
+            state[base + i] = prediction[i] + ix[base + i];
+        }
+    }
+}
+
+void vadpcm_encode_frame(const VADPCMBook& book, uint8_t* out, const int16_t* in, int32_t* state) {
+    const int32_t order = book.order;
+    int32_t history[VADPCMBook::Rows];
+    int32_t e[VADPCM_FRAME_SAMPLES];
+    int32_t best[VADPCM_FRAME_SAMPLES];
+    int32_t optimalp = 0;
+    float min = 1e30;
+
+    for (int32_t k = 0; k < book.npredictors; k++) {
+        for (int32_t j = 0; j < 2; j++) {
+            const int32_t base = j * 8;
+            for (int32_t i = 0; i < order; i++) {
+                history[i] = j == 0 ? state[16 - order + i] : in[8 - order + i];
+            }
+
+            predict_half(book, k, history, [&](int32_t i, int32_t prediction) {
+                return e[base + i] = in[base + i] - prediction;
+            });
+        }
+
+        float se = 0.0f;
+        for (int32_t j = 0; j < VADPCM_FRAME_SAMPLES; j++) {
+            se += (float) e[j] * (float) e[j];
+        }
+
+        if (se < min) {
+            min = se;
+            optimalp = k;
+            std::copy(e, e + VADPCM_FRAME_SAMPLES, best);
+        }
+    }
+
+    int32_t max = 0;
+    for (int32_t i = 0; i < VADPCM_FRAME_SAMPLES; i++) {
+        const int32_t ie = clamp_to_s16(best[i]);
+        if (abs(ie) > abs(max)) {
+            max = ie;
+        }
+    }
+
+    int32_t scale;
+    for (scale = 0; scale <= 12; scale++) {
+        if (max <= 7 && max >= -8) break;
+        max /= 2;
+    }
+
+    int32_t saveState[VADPCM_FRAME_SAMPLES];
+    int16_t ix[VADPCM_FRAME_SAMPLES];
+    std::copy(state, state + VADPCM_FRAME_SAMPLES, saveState);
+
+    for (int32_t nIter = 0, again = 1; nIter < 2 && again; nIter++) {
+        again = 0;
+        if (nIter == 1) scale++;
+        if (scale > 12) {
+            scale = 12;
+        }
+
+        for (int32_t j = 0; j < 2; j++) {
+            const int32_t base = j * 8;
+            for (int32_t i = 0; i < order; i++) {
+                history[i] = j == 0 ? saveState[16 - order + i] : state[8 - order + i];
+            }
+
+            predict_half(book, optimalp, history, [&](int32_t i, int32_t prediction) {
+                const int32_t se = in[base + i] - prediction;
+                ix[base + i] = qsample(se, scale);
+                const int32_t cV = clamp_to_s16(ix[base + i]) - ix[base + i];
+                if (cV > 1 || cV < -1) again = 1;
+                ix[base + i] += cV;
+                const int32_t input = ix[base + i] * (1 << scale);
+                state[base + i] = prediction + input;
+                return input;
+            });
+        }
+    }
+
+    out[0] = (scale << 4) | (optimalp & 0xf);
+    for (int32_t i = 0; i < VADPCM_FRAME_SAMPLES; i += 2) {
+        out[1 + i / 2] = ((ix[i] & 0xf) << 4) | (ix[i + 1] & 0xf);
+    }
+}
+
+void vadpcm_decode(const VADPCMBook& book, const uint8_t* frames, size_t nframes, int32_t* state, int16_t* out) {
+    for (size_t f = 0; f < nframes; f++) {
+        vadpcm_decode_frame(book, frames + f * VADPCM_FRAME_SIZE, state);
+        for (int32_t i = 0; i < VADPCM_FRAME_SAMPLES; i++) {
+            out[f * VADPCM_FRAME_SAMPLES + i] = clamp_to_s16(state[i]);
+        }
+    }
+}
+
+void vadpcm_encode(const VADPCMBook& book, const int16_t* samples, size_t nframes, int32_t* state, uint8_t* out) {
+    for (size_t f = 0; f < nframes; f++) {
+        vadpcm_encode_frame(book, out + f * VADPCM_FRAME_SIZE, samples + f * VADPCM_FRAME_SAMPLES, state);
+    }
+}
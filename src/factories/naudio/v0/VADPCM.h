@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#define VADPCM_FRAME_SIZE 9
+#define VADPCM_FRAME_SAMPLES 16
+
+/*
+ * VADPCM codebook flattened to 16 columns of 8 rows per predictor, stored column major.
+ * Column c holds the weight of input c for every output of a half frame, with the
+ * entries an output must not see already zeroed, so the whole half frame can be
+ * predicted with one 8 lane multiply-add per input.
+ */
+struct VADPCMBook {
+    static constexpr int32_t Rows = 8;
+    static constexpr int32_t Columns = 16;
+
+    int32_t order = 0;
+    int32_t npredictors = 0;
+    std::vector<int32_t> coefs;
+
+    // Raw codebook entries as stored in an AIFC file, predictor -> order -> row
+    static VADPCMBook FromCodebook(const std::vector<int16_t>& codebook, int32_t order, int32_t npredictors);
+
+    const int32_t* Column(int32_t predictor, int32_t column) const {
+        return this->coefs.data() + (predictor * Columns + column) * Rows;
+    }
+
+    int16_t Coef(int32_t predictor, int32_t row, int32_t column) const {
+        return static_cast<int16_t>(this->Column(predictor, column)[row]);
+    }
+};
+
+// Decodes nframes 9 byte frames into 16 samples each, state holds the last 16 unclamped samples
+void vadpcm_decode(const VADPCMBook& book, const uint8_t* frames, size_t nframes, int32_t* state, int16_t* out);
+// Encodes nframes groups of 16 samples, picking the predictor with the smallest error for each frame
+void vadpcm_encode(const VADPCMBook& book, const int16_t* samples, size_t nframes, int32_t* state, uint8_t* out);
+
+void vadpcm_decode_frame(const VADPCMBook& book, const uint8_t* frame, int32_t* state);
+void vadpcm_encode_frame(const VADPCMBook& book, uint8_t* out, const int16_t* in, int32_t* state);
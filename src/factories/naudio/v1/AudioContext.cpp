@@ -6,7 +6,25 @@
 std::unordered_map<AudioTableType, TableEntry> AudioContext::tables;
 NAudioDrivers AudioContext::driver = NAudioDrivers::UNKNOWN;
 
-std::optional<std::shared_ptr<IParsedData>> AudioContextFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+static void BindTable(TableEntry& table, std::span<uint8_t> buffer, uint32_t offset, uint32_t size) {
+    if(offset + size > buffer.size()) {
+        throw std::runtime_error("Audio table is out of bounds");
+    }
+
+    auto view = buffer.subspan(offset, size);
+    table.offset = offset;
+
+    // The rom outlives every asset, anything else is a temporary buffer and has to be copied
+    if(buffer.data() == Companion::Instance->GetRomData().data()) {
+        table.storage.clear();
+        table.buffer = view;
+    } else {
+        table.storage.assign(view.begin(), view.end());
+        table.buffer = table.storage;
+    }
+}
+
+std::optional<std::shared_ptr<IParsedData>> AudioContextFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto driver = GetSafeNode<std::string>(node, "driver");
 
     if(driver == "SF64") {
@@ -29,13 +47,9 @@ std::optional<std::shared_ptr<IParsedData>> AudioContextFactory::parse(std::vect
     auto tableSize = GetSafeNode<uint32_t>(table, "size");
     auto tableOffset = GetSafeNode<uint32_t>(table, "offset");
 
-    AudioContext::tables[AudioTableType::SEQ_TABLE].buffer = std::vector<uint8_t>(buffer.begin() + seqOffset, buffer.begin() + seqOffset + seqSize);
-    AudioContext::tables[AudioTableType::FONT_TABLE].buffer = std::vector<uint8_t>(buffer.begin() + bankOffset, buffer.begin() + bankOffset + bankSize);
-    AudioContext::tables[AudioTableType::SAMPLE_TABLE].buffer = std::vector<uint8_t>(buffer.begin() + tableOffset, buffer.begin() + tableOffset + tableSize);
-
-    AudioContext::tables[AudioTableType::SEQ_TABLE].offset = seqOffset;
-    AudioContext::tables[AudioTableType::FONT_TABLE].offset = bankOffset;
-    AudioContext::tables[AudioTableType::SAMPLE_TABLE].offset = tableOffset;
+    BindTable(AudioContext::tables[AudioTableType::SEQ_TABLE], buffer, seqOffset, seqSize);
+    BindTable(AudioContext::tables[AudioTableType::FONT_TABLE], buffer, bankOffset, bankSize);
+    BindTable(AudioContext::tables[AudioTableType::SAMPLE_TABLE], buffer, tableOffset, tableSize);
 
     SPDLOG_INFO("Sequence Table 0x{:X}", seqOffset);
     SPDLOG_INFO("Sound Font Table 0x{:X}", bankOffset);
@@ -45,7 +59,7 @@ std::optional<std::shared_ptr<IParsedData>> AudioContextFactory::parse(std::vect
 }
 
 LUS::BinaryReader AudioContext::MakeReader(AudioTableType type, uint32_t offset) {
-    auto entry = AudioContext::tables[type].buffer;
+    auto& entry = AudioContext::tables[type].buffer;
 
     LUS::BinaryReader reader(entry.data(), entry.size());
     reader.SetEndianness(Torch::Endianness::Big);
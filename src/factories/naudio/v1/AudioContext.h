@@ -13,7 +13,9 @@ struct TunedSample {
 struct TableEntry {
     std::shared_ptr<AudioTableData> info;
     std::unordered_map<uint32_t, AudioTableEntry> entries;
-    std::vector<uint8_t> buffer;
+    // View into the rom, only backed by storage when the table could not be borrowed
+    std::span<const uint8_t> buffer;
+    std::vector<uint8_t> storage;
     uint32_t offset;
 };
 
@@ -37,7 +39,8 @@ public:
 
 class AudioContextFactory : public BaseFactory {
 public:
-    std::optional<std::shared_ptr<IParsedData>> parse(std::vector<uint8_t>& buffer, YAML::Node& data) override;
+    std::optional<std::shared_ptr<IParsedData>> parse(std::span<uint8_t> buffer, YAML::Node& data) override;
+    bool HasSharedState() override { return true; }
 
     inline std::unordered_map<ExportType, std::shared_ptr<BaseExporter>> GetExporters() override {
         return {
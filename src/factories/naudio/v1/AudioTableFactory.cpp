@@ -99,7 +99,7 @@ ExportResult AudioTableBinaryExporter::Export(std::ostream &write, std::shared_p
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> AudioTableFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> AudioTableFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     // Parse table entry
     auto offset = GetSafeNode<uint32_t>(node, "offset");
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
@@ -36,7 +36,7 @@ ExportResult ADPCMBookBinaryExporter::Export(std::ostream &write, std::shared_pt
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> ADPCMBookFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> ADPCMBookFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto offset = GetSafeNode<uint32_t>(node, "offset");
     auto reader = AudioContext::MakeReader(AudioTableType::FONT_TABLE, offset);
 
@@ -35,7 +35,7 @@ ExportResult DrumBinaryExporter::Export(std::ostream &write, std::shared_ptr<IPa
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> DrumFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> DrumFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto offset = GetSafeNode<uint32_t>(node, "offset");
     auto parent = GetSafeNode<uint32_t>(node, "parent");
     auto sampleBankId = GetSafeNode<uint32_t>(node, "sampleBankId");
@@ -34,7 +34,7 @@ ExportResult EnvelopeBinaryExporter::Export(std::ostream &write, std::shared_ptr
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> EnvelopeFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> EnvelopeFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto offset = GetSafeNode<uint32_t>(node, "offset");
     auto reader = AudioContext::MakeReader(AudioTableType::FONT_TABLE, offset);
 
@@ -42,7 +42,7 @@ ExportResult InstrumentBinaryExporter::Export(std::ostream &write, std::shared_p
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> InstrumentFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> InstrumentFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto offset = GetSafeNode<uint32_t>(node, "offset");
     auto parent = GetSafeNode<uint32_t>(node, "parent");
     auto sampleBankId = GetSafeNode<uint32_t>(node, "sampleBankId");
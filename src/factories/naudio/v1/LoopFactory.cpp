@@ -37,7 +37,7 @@ ExportResult ADPCMLoopBinaryExporter::Export(std::ostream &write, std::shared_pt
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> ADPCMLoopFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> ADPCMLoopFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto offset = GetSafeNode<uint32_t>(node, "offset");
     auto reader = AudioContext::MakeReader(AudioTableType::FONT_TABLE, offset);
     auto loop = std::make_shared<ADPCMLoopData>();
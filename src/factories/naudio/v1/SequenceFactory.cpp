@@ -1,6 +1,7 @@
 #include "SequenceFactory.h"
 #include "Companion.h"
 #include "utils/Decompressor.h"
+#include "utils/TextWriter.h"
 #include "AudioContext.h"
 
 ExportResult NSequenceHeaderExporter::Export(std::ostream &write, std::shared_ptr<IParsedData> raw, std::string& entryName, YAML::Node &node, std::string* replacement) {
@@ -28,14 +29,9 @@ ExportResult NSequenceCodeExporter::Export(std::ostream &write, std::shared_ptr<
 
     write << GetSafeNode<std::string>(node, "ctype", "u8") << " " << symbol << "[] = {\n" << tab_t;
 
-    for (int i = 0; i < data.size(); i++) {
-        if ((i % 15 == 0) && i != 0) {
-            write << "\n" << tab_t;
-        }
-
-        write << "0x" << std::hex << std::setw(2) << std::setfill('0') << (int) data[i] << ", ";
-    }
-    write << "\n};\n";
+    Torch::TextWriter text;
+    text.HexArray(data, 1, 15, "\n" tab_t) << "\n};\n";
+    text.Flush(write);
 
     if (Companion::Instance->IsDebug()) {
         write << "// size: 0x" << std::hex << std::uppercase << data.size() << "\n";
@@ -65,7 +61,7 @@ ExportResult NSequenceBinaryExporter::Export(std::ostream &write, std::shared_pt
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> NSequenceFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> NSequenceFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto size = GetSafeNode<size_t>(node, "size");
     auto [_, segment] = Decompressor::AutoDecode(node, buffer, size);
     return std::make_shared<RawBuffer>(segment.data, segment.size);
@@ -126,7 +126,7 @@ ExportResult SF64::AnimBinaryExporter::Export(std::ostream &write, std::shared_p
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SF64::AnimFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SF64::AnimFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     YAML::Node dataNode;
     YAML::Node keyNode;
     std::vector<SF64::JointKey> jointKeys;
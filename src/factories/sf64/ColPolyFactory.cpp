@@ -91,7 +91,7 @@ ExportResult SF64::ColPolyBinaryExporter::Export(std::ostream &write, std::share
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SF64::ColPolyFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SF64::ColPolyFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     const auto offset = GetSafeNode<uint32_t>(node, "offset");
     const auto count = GetSafeNode<uint32_t>(node, "count");
     const auto meshCount = GetSafeNode<uint32_t>(node, "mesh_count", 1);
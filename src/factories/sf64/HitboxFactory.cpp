@@ -110,7 +110,7 @@ ExportResult SF64::HitboxBinaryExporter::Export(std::ostream &write, std::shared
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SF64::HitboxFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SF64::HitboxFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     std::vector<float> data;
     int count;
     std::vector<int> types;
@@ -177,7 +177,7 @@ ExportResult SF64::MessageXMLExporter::Export(std::ostream &write, std::shared_p
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SF64::MessageFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SF64::MessageFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     std::vector<uint16_t> message;
     std::ostringstream mesgStr;
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
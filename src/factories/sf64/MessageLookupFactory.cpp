@@ -100,7 +100,7 @@ ExportResult SF64::MessageLookupBinaryExporter::Export(std::ostream &write, std:
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SF64::MessageLookupFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SF64::MessageLookupFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     const auto vram = GetSafeNode<uint32_t>(node, "vram");
     const auto offset = GetSafeNode<uint32_t>(node, "offset");
     std::vector<MessageEntry> message;
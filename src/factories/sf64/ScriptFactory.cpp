@@ -301,7 +301,6 @@ ExportResult SF64::ScriptBinaryExporter::Export(std::ostream &write, std::shared
     // Export Commands and Populate Hashes Map
     for (auto ptr : sortedPtrs) {
         auto wrapper = Companion::Instance->GetCurrentWrapper();
-        std::ostringstream stream;
 
         auto cmdWriter = LUS::BinaryWriter();
         WriteHeader(cmdWriter, Torch::ResourceType::ScriptCmd, 0);
@@ -315,10 +314,7 @@ ExportResult SF64::ScriptBinaryExporter::Export(std::ostream &write, std::shared
             cmdWriter.Write(script->mCmds.at(cmdIndex++));
         }
 
-        cmdWriter.Finish(stream);
-
-        auto data = stream.str();
-        wrapper->AddFile(entryName + "_cmd_" + std::to_string(ptrCount), std::vector(data.begin(), data.end()));
+        wrapper->AddFile(entryName + "_cmd_" + std::to_string(ptrCount), cmdWriter.Release());
 
         std::ostringstream cmdName;
         cmdName << entryName << "_cmd_" << std::dec << ptrCount;
@@ -536,7 +532,7 @@ ExportResult SF64::ScriptXMLExporter::Export(std::ostream &write, std::shared_pt
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SF64::ScriptFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SF64::ScriptFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     const auto offset = GetSafeNode<uint32_t>(node, "offset");
     auto ptrsStart = offset;
     YAML::Node scriptNode;
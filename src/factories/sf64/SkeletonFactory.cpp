@@ -107,7 +107,6 @@ ExportResult SF64::SkeletonBinaryExporter::Export(std::ostream &write, std::shar
     // Export Each Limb
     for (auto &limb : limbs) {
         auto wrapper = Companion::Instance->GetCurrentWrapper();
-        std::ostringstream stream;
 
         auto limbWriter = LUS::BinaryWriter();
         WriteHeader(limbWriter, Torch::ResourceType::Limb, 0);
@@ -137,10 +136,7 @@ ExportResult SF64::SkeletonBinaryExporter::Export(std::ostream &write, std::shar
         limbWriter.Write(sibling);
         uint64_t child = (limb.mChild != 0) ? limbDict.at(limb.mChild) : 0;
         limbWriter.Write(child);
-        limbWriter.Finish(stream);
-
-        auto data = stream.str();
-        wrapper->AddFile(entryName + "_limb_" + std::to_string(limb.mIndex), std::vector(data.begin(), data.end()));
+        wrapper->AddFile(entryName + "_limb_" + std::to_string(limb.mIndex), limbWriter.Release());
     }
 
     // Export Skeleton
@@ -154,7 +150,7 @@ ExportResult SF64::SkeletonBinaryExporter::Export(std::ostream &write, std::shar
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SF64::SkeletonFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SF64::SkeletonFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     std::vector<SF64::LimbData> skeleton;
     auto [root, segment] = Decompressor::AutoDecode(node, buffer, 0x1000);
     LUS::BinaryReader reader(segment.data, segment.size);
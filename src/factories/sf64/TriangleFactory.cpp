@@ -70,7 +70,7 @@ ExportResult SF64::TriangleBinaryExporter::Export(std::ostream &write, std::shar
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SF64::TriangleFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SF64::TriangleFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     const auto offset = GetSafeNode<uint32_t>(node, "offset");
     const auto count = GetSafeNode<uint32_t>(node, "count");
     const auto meshCount = GetSafeNode<uint32_t>(node, "mesh_count", 1);
@@ -1,37 +1,81 @@
 #include <cstdint>
 #include <vector>
 #include <cmath>
-#include "endianness.h"
+#include <future>
+#include <algorithm>
 #include "AudioDecompressor.h"
+#include "utils/ThreadPool.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #define C_M_PI 3.14159265358979323846f
 
-struct StupidDMAStruct {
-    int16_t* unk_0;
-    int32_t unk_4;
-    int32_t unk_8;
-    int16_t* unk_C;
-    int16_t unk18;
+namespace {
+
+// Four floats, every operation is done lane by lane in the same order as the scalar code
+struct Vec4 {
+#if defined(__SSE2__)
+    __m128 v;
+
+    static Vec4 Load(const float* src) { return { _mm_loadu_ps(src) }; }
+    static Vec4 LoadReversed(const float* src) { auto v = _mm_loadu_ps(src); return { _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3)) }; }
+    static Vec4 Set(float value) { return { _mm_set1_ps(value) }; }
+    void Store(float* dst) const { _mm_storeu_ps(dst, v); }
+    void StoreReversed(float* dst) const { _mm_storeu_ps(dst, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3))); }
+
+    Vec4 operator+(const Vec4& o) const { return { _mm_add_ps(v, o.v) }; }
+    Vec4 operator-(const Vec4& o) const { return { _mm_sub_ps(v, o.v) }; }
+    Vec4 operator*(const Vec4& o) const { return { _mm_mul_ps(v, o.v) }; }
+    Vec4 operator/(const Vec4& o) const { return { _mm_div_ps(v, o.v) }; }
+#else
+    float v[4];
+
+    static Vec4 Load(const float* src) { return { { src[0], src[1], src[2], src[3] } }; }
+    static Vec4 LoadReversed(const float* src) { return { { src[3], src[2], src[1], src[0] } }; }
+    static Vec4 Set(float value) { return { { value, value, value, value } }; }
+    void Store(float* dst) const { for (int i = 0; i < 4; i++) dst[i] = v[i]; }
+    void StoreReversed(float* dst) const { for (int i = 0; i < 4; i++) dst[3 - i] = v[i]; }
+
+    Vec4 operator+(const Vec4& o) const { return { { v[0] + o.v[0], v[1] + o.v[1], v[2] + o.v[2], v[3] + o.v[3] } }; }
+    Vec4 operator-(const Vec4& o) const { return { { v[0] - o.v[0], v[1] - o.v[1], v[2] - o.v[2], v[3] - o.v[3] } }; }
+    Vec4 operator*(const Vec4& o) const { return { { v[0] * o.v[0], v[1] * o.v[1], v[2] * o.v[2], v[3] * o.v[3] } }; }
+    Vec4 operator/(const Vec4& o) const { return { { v[0] / o.v[0], v[1] / o.v[1], v[2] / o.v[2], v[3] / o.v[3] } }; }
+#endif
+};
+
+// Reads the big endian stream of a sample without copying or swapping it, a packet stops at the end of the data
+struct WordReader {
+    std::span<const uint8_t> data;
+    size_t position = 0;
+    bool overrun = false;
+
+    int16_t Next() {
+        const size_t offset = position++ * 2;
+        if (offset + 1 >= data.size()) {
+            overrun = true;
+            return 0;
+        }
+        return (int16_t) ((data[offset] << 8) | data[offset + 1]);
+    }
+};
+
+// The coefficients of one block, writes past the end are dropped like the game drops them in its scratch buffer
+struct Coefficients {
+    float* values;
+
+    void Set(int32_t index, float value) {
+        if (index >= 0 && index < SF64::AudioDecompressor::BlockSize) {
+            values[index] = value;
+        }
+    }
 };
 
-int16_t DFT_8014C1B4 = 0x1000;
-float DFT_80145D48[256];
-float DFT_80146148[256];
-float DFT_80146548[515];
-float DFT_80146D54;
-float DFT_80146D58;
-float DFT_80146D5C;
-float DFT_80146D60;
-float DFT_80146D64;
-float DFT_80146D68;
-float DFT_80146D6C;
-float DFT_80146D70;
-
-void func_80009124(int16_t** arg0) {
-    int16_t* var_a1;
+void func_80009124(WordReader& reader, float* output) {
+    Coefficients coefs = { output };
     int32_t temp_a0;
     uint8_t temp_s0;
-    uint8_t temp_s1;
     uint8_t temp_u1;
     int32_t temp_t5_4;
     int32_t temp_v0;
@@ -42,17 +86,13 @@ void func_80009124(int16_t** arg0) {
     uint16_t var_s0;
     uint32_t var_t3;
     int32_t i;
-    int32_t j;
-    int16_t new_var2;
 
-    var_a1 = *arg0;
-
-    for (i = 255; i >= 0; i--) {
-        DFT_80145D48[i] = 0.0f;
+    for (i = SF64::AudioDecompressor::BlockSize - 1; i >= 0; i--) {
+        output[i] = 0.0f;
     }
-    temp_v0 = *var_a1++;
+    temp_v0 = reader.Next();
     var_t3 = temp_v0 << 0x10;
-    temp_v0 = *var_a1++;
+    temp_v0 = reader.Next();
     var_t3 |= temp_v0;
 
     for (var_t2 = 0; var_t2 < 4; var_t2++) {
@@ -69,11 +109,14 @@ void func_80009124(int16_t** arg0) {
         switch (temp_v1) {
             case 1:
                 while (true) {
-                    var_s0 = *var_a1++;
+                    var_s0 = reader.Next();
+                    if (reader.overrun) {
+                        break;
+                    }
                     for (var_s1 = 0; var_s1 < 4; var_s1++) {
                         temp_u1 = (var_s0 >> 0xC) & 0xF;
                         var_s0 <<= 4;
-                        DFT_80145D48[var_v1++] = ((temp_u1 & 7) - 4) << temp_a0;
+                        coefs.Set(var_v1++, ((temp_u1 & 7) - 4) << temp_a0);
                         if (temp_u1 >= 8) {
                             goto case_1_break;
                         }
@@ -83,27 +126,30 @@ void func_80009124(int16_t** arg0) {
                 break;
             case 2:
                 for (var_s1 = 0; var_s1 < 16; var_s1++) {
-                    var_s0 = *var_a1++;
+                    var_s0 = reader.Next();
                     for (i = 0; i < 4; i++) {
                         temp_u1 = (var_s0 >> 0xC) & 0xF;
                         var_s0 <<= 4;
-                        DFT_80145D48[var_v1++] = (temp_u1 - 8) << temp_a0;
+                        coefs.Set(var_v1++, (temp_u1 - 8) << temp_a0);
                     }
                 }
                 break;
             case 6:
                 while (true) {
-                    var_s0 = *var_a1++;
+                    var_s0 = reader.Next();
+                    if (reader.overrun) {
+                        break;
+                    }
                     temp_u1 = (var_s0 >> 8) & 0xFF;
                     temp_t5_4 = temp_u1 >> 6;
-                    DFT_80145D48[var_v1] = ((temp_u1 & 0x3F) - 0x20) << temp_a0;
+                    coefs.Set(var_v1, ((temp_u1 & 0x3F) - 0x20) << temp_a0);
                     if (temp_t5_4 == 0) {
                         break;
                     }
                     var_v1 += temp_t5_4;
                     temp_u1 = var_s0 & 0xFF;
                     temp_t5_4 = temp_u1 >> 6;
-                    DFT_80145D48[var_v1] = ((temp_u1 & 0x3F) - 0x20) << temp_a0;
+                    coefs.Set(var_v1, ((temp_u1 & 0x3F) - 0x20) << temp_a0);
                     if (temp_t5_4 == 0) {
                         break;
                     }
@@ -112,16 +158,19 @@ void func_80009124(int16_t** arg0) {
                 break;
             case 3:
                 while (true) {
-                    var_s0 = *var_a1++;
+                    var_s0 = reader.Next();
+                    if (reader.overrun) {
+                        break;
+                    }
                     temp_u1 = (var_s0 >> 8) & 0xFF;
 
-                    DFT_80145D48[var_v1++] = ((temp_u1 & 0x7F) - 0x40) << temp_a0;
+                    coefs.Set(var_v1++, ((temp_u1 & 0x7F) - 0x40) << temp_a0);
 
                     if (temp_u1 >= 0x80) {
                         break;
                     }
                     temp_u1 = var_s0 & 0xFF;
-                    DFT_80145D48[var_v1++] = ((temp_u1 & 0x7F) - 0x40) << temp_a0;
+                    coefs.Set(var_v1++, ((temp_u1 & 0x7F) - 0x40) << temp_a0);
                     if (temp_u1 >= 0x80) {
                         break;
                     }
@@ -129,9 +178,12 @@ void func_80009124(int16_t** arg0) {
                 break;
             case 4:
                 while (true) {
-                    var_s0 = *var_a1++;
+                    var_s0 = reader.Next();
+                    if (reader.overrun) {
+                        break;
+                    }
                     temp_t5_4 = var_s0 >> 0xC;
-                    DFT_80145D48[var_v1] = ((var_s0 & 0xFFF) - 0x800) << temp_a0;
+                    coefs.Set(var_v1, ((var_s0 & 0xFFF) - 0x800) << temp_a0);
                     if (temp_t5_4 == 0) {
                         break;
                     }
@@ -140,9 +192,12 @@ void func_80009124(int16_t** arg0) {
                 break;
             case 5:
                 while (true) {
-                    var_s0 = *var_a1++;
+                    var_s0 = reader.Next();
+                    if (reader.overrun) {
+                        break;
+                    }
                     temp_t5_4 = var_s0 >> 0xF;
-                    DFT_80145D48[var_v1] = ((var_s0 & 0x7FFF) - 0x4000) << temp_a0;
+                    coefs.Set(var_v1, ((var_s0 & 0x7FFF) - 0x4000) << temp_a0);
                     if (temp_t5_4 == 1) {
                         break;
                     }
@@ -151,352 +206,287 @@ void func_80009124(int16_t** arg0) {
                 break;
         }
     }
-    *arg0 = var_a1;
 }
 
-void AudioSynth_HartleyTransform(float* arg0, int32_t arg1, float* arg2) {
-    int32_t length;
-    int32_t spD0;
-    int32_t spCC;
-    int32_t spC8;
-    int32_t var_a0;
-    int32_t spC0;
-    int32_t spBC;
-    int32_t pad;
-    int32_t spB4;
-    int32_t sp58;
-    int32_t sp50;
+void DivideAll(float* data, int32_t length, float divisor) {
+    const auto vdivisor = Vec4::Set(divisor);
+    for (int32_t i = 0; i < length; i += 4) {
+        (Vec4::Load(data + i) / vdivisor).Store(data + i);
+    }
+}
+
+}
+
+SF64::AudioDecompressor::AudioDecompressor() {
+    float hartley[4][Twiddles];
+    float var_fs0 = 6.283186f / BlockSize;
+    for (int32_t i = 0; i < Twiddles; i++) {
+        hartley[0][i] = cosf(var_fs0);
+        hartley[1][i] = sinf(var_fs0);
+        hartley[2][i] = cosf(3.0f * var_fs0);
+        hartley[3][i] = sinf(3.0f * var_fs0);
+        var_fs0 += 6.283186f / BlockSize;
+    }
+
+    // Stage s steps through the table with a stride of 2^s
+    for (int32_t s = 0; s < Stages; s++) {
+        auto& stage = this->mStages[s];
+        stage = {};
+        for (int32_t k = 1; (k << s) <= Twiddles; k++) {
+            const int32_t index = (k << s) - 1;
+            stage.cos1[k] = hartley[0][index];
+            stage.sin1[k] = hartley[1][index];
+            stage.cos3[k] = hartley[2][index];
+            stage.sin3[k] = hartley[3][index];
+        }
+    }
+
+    var_fs0 = 0.0f;
+    const float temp_ft0 = C_M_PI / (float) (2 * BlockSize);
+    for (int32_t i = 0; i < BlockSize / 2; i++) {
+        this->mCosMinusSin[i] = (cosf(var_fs0) - sinf(var_fs0)) * 0.707107f;
+        this->mCosPlusSin[i] = (cosf(var_fs0) + sinf(var_fs0)) * 0.707107f;
+        var_fs0 += temp_ft0;
+    }
+}
+
+const SF64::AudioDecompressor& SF64::AudioDecompressor::Get() {
+    static const AudioDecompressor instance;
+    return instance;
+}
+
+size_t SF64::AudioDecompressor::GetOutputSize(size_t size) {
+    return (size + BlockSize - 1) / BlockSize * BlockSize;
+}
+
+void SF64::AudioDecompressor::HartleyTransform(float* arg0) const {
+    constexpr int32_t length = BlockSize;
+    int32_t spBC = length * 2;
     int32_t spA8;
-    float var_fs0;
-    float temp_fa0;
-    float temp_fv1;
-    float* temp_a0;
-    float* temp_a1;
-    float* temp_a2;
-    float* temp_a3;
-    float* temp_b0;
-    float* temp_b1;
-    float* temp_b2;
-    float* temp_b3;
-    float* var_s0;
-    float* var_s1;
-    float* var_s2;
-    float* var_s3;
-
-    length = 1 << arg1;
-    spBC = length * 2;
-    sp58 = (length / 8) - 1;
-    switch (length) {
-        case 1:
-            break;
-        case 2:
-            temp_fa0 = arg0[1];
-            temp_fv1 = arg0[0];
-
-            arg0[0] = (temp_fa0 + temp_fv1) * 0.707107f;
-            arg0[1] = (temp_fv1 - temp_fa0) * 0.707107f;
-            break;
-        case 4:
-            temp_fv1 = arg0[0];
-            arg0[0] = (arg0[2] + temp_fv1) / 2.0f;
-            arg0[2] = (temp_fv1 - arg0[2]) / 2.0f;
-
-            temp_fa0 = arg0[1];
-            arg0[1] = (arg0[3] + temp_fa0) / 2.0f;
-            arg0[3] = (temp_fa0 - arg0[3]) / 2.0f;
-
-            temp_fv1 = arg0[0];
-            temp_fa0 = arg0[1];
-            arg0[0] = arg0[1] + temp_fv1;
-            arg0[1] = arg0[3] + arg0[2];
-            arg0[3] = arg0[2] - arg0[3];
-            arg0[2] = temp_fv1 - temp_fa0;
-            break;
-        default:
-            if (length != (int32_t) *arg2) {
-                *arg2 = length;
-
-                var_s0 = &arg2[1];
-                var_s1 = &var_s0[sp58];
-                var_s2 = &var_s1[sp58];
-                var_s3 = &var_s2[sp58];
-
-                var_fs0 = 6.283186f / length;
-                for (spCC = 0; spCC < sp58; spCC++) {
-                    *var_s0++ = cosf(var_fs0);
-                    *var_s1++ = sinf(var_fs0);
-                    *var_s2++ = cosf(3.0f * var_fs0);
-                    *var_s3++ = sinf(3.0f * var_fs0);
-                    var_fs0 += 6.283186f / length;
-                }
-            }
-            spC0 = 1;
-            for (spD0 = 0; spD0 < arg1 - 1; spD0++) {
-                spA8 = spBC;
-                spBC >>= 1;
-                spB4 = spBC >> 3;
-                sp50 = spBC >> 2;
-                var_a0 = 1;
-                do {
-                    for (spCC = var_a0 - 1; spCC < length; spCC += spA8) {
-                        // if (0) { }
-                        temp_a0 = arg0 + spCC;
-                        temp_a1 = temp_a0 + sp50;
-                        temp_a2 = temp_a1 + sp50;
-                        temp_a3 = temp_a2 + sp50;
-
-                        DFT_80146D54 = *temp_a0;
-                        *temp_a0 = *temp_a2 + DFT_80146D54;
-                        DFT_80146D58 = *temp_a1;
-                        *temp_a1 = *temp_a1 + *temp_a3;
-                        DFT_80146D5C = *temp_a2;
-                        *temp_a2 = DFT_80146D54 - DFT_80146D5C + DFT_80146D58 - *temp_a3;
-                        *temp_a3 = DFT_80146D54 - DFT_80146D5C - DFT_80146D58 + *temp_a3;
-                        if (sp50 > 1) {
-                            temp_a0 = arg0 + spCC + spB4;
-                            temp_a1 = temp_a0 + sp50;
-                            temp_a2 = temp_a1 + sp50;
-                            temp_a3 = temp_a2 + sp50;
-
-                            DFT_80146D54 = *temp_a0;
-                            *temp_a0 = *temp_a2 + DFT_80146D54;
-                            DFT_80146D58 = *temp_a1;
-                            *temp_a1 = *temp_a3 + DFT_80146D58;
-                            *temp_a2 = (DFT_80146D54 - *temp_a2) * 1.414214f;
-                            *temp_a3 = (DFT_80146D58 - *temp_a3) * 1.414214f;
-
-                            var_s0 = &arg2[spC0];
-                            var_s1 = &var_s0[sp58];
-                            var_s2 = &var_s1[sp58];
-                            var_s3 = &var_s2[sp58];
-                            for (spC8 = 1; spC8 < spB4; spC8++) {
-                                temp_a0 = arg0 + spCC + spC8;
-                                temp_a1 = temp_a0 + sp50;
-                                temp_a2 = temp_a1 + sp50;
-                                temp_a3 = temp_a2 + sp50;
-
-                                temp_b0 = arg0 + spCC + sp50 - spC8;
-                                temp_b1 = temp_b0 + sp50;
-                                temp_b2 = temp_b1 + sp50;
-                                temp_b3 = temp_b2 + sp50;
-
-                                DFT_80146D54 = *temp_a0;
-                                DFT_80146D58 = *temp_a1;
-                                DFT_80146D5C = *temp_a2;
-                                DFT_80146D60 = *temp_a3;
-
-                                DFT_80146D64 = *temp_b0;
-                                DFT_80146D68 = *temp_b1;
-                                DFT_80146D6C = *temp_b2;
-                                DFT_80146D70 = *temp_b3;
-
-                                *temp_a0 = DFT_80146D54 + DFT_80146D5C;
-                                *temp_a1 = DFT_80146D58 + DFT_80146D60;
-                                *temp_a2 = ((DFT_80146D54 - DFT_80146D5C + DFT_80146D64 - DFT_80146D6C) * *var_s0) +
-                                           ((DFT_80146D60 - DFT_80146D58 + DFT_80146D68 - DFT_80146D70) * *var_s1);
-                                *temp_a3 = ((DFT_80146D54 - DFT_80146D5C - DFT_80146D64 + DFT_80146D6C) * *var_s2) -
-                                           ((DFT_80146D60 - DFT_80146D58 - DFT_80146D68 + DFT_80146D70) * *var_s3);
-                                *temp_b0 = DFT_80146D64 + DFT_80146D6C;
-                                *temp_b1 = DFT_80146D68 + DFT_80146D70;
-                                *temp_b2 = ((DFT_80146D54 - DFT_80146D5C + DFT_80146D64 - DFT_80146D6C) * *var_s1) -
-                                           ((DFT_80146D60 - DFT_80146D58 + DFT_80146D68 - DFT_80146D70) * *var_s0);
-                                *temp_b3 = ((DFT_80146D54 - DFT_80146D5C - DFT_80146D64 + DFT_80146D6C) * *var_s3) +
-                                           ((DFT_80146D60 - DFT_80146D58 - DFT_80146D68 + DFT_80146D70) * *var_s2);
-                                var_s0 += spC0;
-                                var_s1 += spC0;
-                                var_s2 += spC0;
-                                var_s3 += spC0;
-                            }
-                        }
-                    }
-                    var_a0 = ((spA8 * 2) - spBC) + 1;
-                    spA8 *= 4;
-                } while (var_a0 < length);
-                spC0 = spC0 * 2;
-                temp_a0 = arg0;
-                for (spC8 = 0; spC8 < length; spC8++, temp_a0++) {
-                    *temp_a0 /= 1.414214f;
-                }
-            }
-            var_a0 = 1;
-            spA8 = 4;
-
-            do {
-                for (spCC = var_a0 - 1; spCC < length; spCC += spA8) {
-                    DFT_80146D54 = arg0[spCC];
-                    arg0[spCC] = arg0[spCC + 1] + DFT_80146D54;
-                    arg0[spCC + 1] = DFT_80146D54 - arg0[spCC + 1];
+    int32_t var_a0;
+
+    for (int32_t spD0 = 0; spD0 < Stages; spD0++) {
+        const auto& stage = this->mStages[spD0];
+        spA8 = spBC;
+        spBC >>= 1;
+        const int32_t spB4 = spBC >> 3;
+        const int32_t sp50 = spBC >> 2;
+        var_a0 = 1;
+        do {
+            for (int32_t spCC = var_a0 - 1; spCC < length; spCC += spA8) {
+                float* a = arg0 + spCC;
+                float x0 = a[0];
+                float x1 = a[sp50];
+                float x2 = a[sp50 * 2];
+                float x3 = a[sp50 * 3];
+
+                a[0] = x2 + x0;
+                a[sp50] = x1 + x3;
+                a[sp50 * 2] = x0 - x2 + x1 - x3;
+                a[sp50 * 3] = x0 - x2 - x1 + x3;
+
+                if (sp50 <= 1) {
+                    continue;
                 }
-                var_a0 = (spA8 * 2) - 1;
-                spA8 *= 4;
-            } while (var_a0 < length);
-            temp_a0 = arg0;
-            for (spC8 = 0; spC8 < length; spC8++) {
-                *temp_a0++ /= 1.414214f;
-            }
-            spB4 = 1;
-            temp_a0 = arg0;
-
-            for (spC8 = 1; spC8 < length; spC8++) {
-                if (spC8 < spB4) {
-                    DFT_80146D54 = arg0[spB4 - 1];
-                    arg0[spB4 - 1] = *temp_a0;
-                    *temp_a0 = DFT_80146D54;
+
+                float* m = a + spB4;
+                x0 = m[0];
+                x1 = m[sp50];
+                x2 = m[sp50 * 2];
+                x3 = m[sp50 * 3];
+                m[0] = x2 + x0;
+                m[sp50] = x3 + x1;
+                m[sp50 * 2] = (x0 - x2) * 1.414214f;
+                m[sp50 * 3] = (x1 - x3) * 1.414214f;
+
+                // Butterfly k only touches a[k + n * sp50] and a[sp50 - k + n * sp50], so 4 of them run at once
+                int32_t spC8 = 1;
+                for (; spC8 + 3 < spB4; spC8 += 4) {
+                    const auto a0 = Vec4::Load(a + spC8);
+                    const auto a1 = Vec4::Load(a + sp50 + spC8);
+                    const auto a2 = Vec4::Load(a + sp50 * 2 + spC8);
+                    const auto a3 = Vec4::Load(a + sp50 * 3 + spC8);
+                    const auto b0 = Vec4::LoadReversed(a + sp50 - spC8 - 3);
+                    const auto b1 = Vec4::LoadReversed(a + sp50 * 2 - spC8 - 3);
+                    const auto b2 = Vec4::LoadReversed(a + sp50 * 3 - spC8 - 3);
+                    const auto b3 = Vec4::LoadReversed(a + sp50 * 4 - spC8 - 3);
+                    const auto s0 = Vec4::Load(stage.cos1.data() + spC8);
+                    const auto s1 = Vec4::Load(stage.sin1.data() + spC8);
+                    const auto s2 = Vec4::Load(stage.cos3.data() + spC8);
+                    const auto s3 = Vec4::Load(stage.sin3.data() + spC8);
+
+                    const auto p = a0 - a2 + b0 - b2;
+                    const auto q = a3 - a1 + b1 - b3;
+                    const auto r = a0 - a2 - b0 + b2;
+                    const auto t = a3 - a1 - b1 + b3;
+
+                    (a0 + a2).Store(a + spC8);
+                    (a1 + a3).Store(a + sp50 + spC8);
+                    (p * s0 + q * s1).Store(a + sp50 * 2 + spC8);
+                    (r * s2 - t * s3).Store(a + sp50 * 3 + spC8);
+                    (b0 + b2).StoreReversed(a + sp50 - spC8 - 3);
+                    (b1 + b3).StoreReversed(a + sp50 * 2 - spC8 - 3);
+                    (p * s1 - q * s0).StoreReversed(a + sp50 * 3 - spC8 - 3);
+                    (r * s3 + t * s2).StoreReversed(a + sp50 * 4 - spC8 - 3);
                 }
-                temp_a0++;
-                spC0 = length >> 1;
-                while (spC0 < spB4) {
-                    spB4 -= spC0;
-                    spC0 >>= 1;
+
+                for (; spC8 < spB4; spC8++) {
+                    float* ta = a + spC8;
+                    float* tb = a + sp50 - spC8;
+                    const float a0 = ta[0], a1 = ta[sp50], a2 = ta[sp50 * 2], a3 = ta[sp50 * 3];
+                    const float b0 = tb[0], b1 = tb[sp50], b2 = tb[sp50 * 2], b3 = tb[sp50 * 3];
+                    const float s0 = stage.cos1[spC8], s1 = stage.sin1[spC8], s2 = stage.cos3[spC8], s3 = stage.sin3[spC8];
+
+                    const float p = a0 - a2 + b0 - b2;
+                    const float q = a3 - a1 + b1 - b3;
+                    const float r = a0 - a2 - b0 + b2;
+                    const float t = a3 - a1 - b1 + b3;
+
+                    ta[0] = a0 + a2;
+                    ta[sp50] = a1 + a3;
+                    ta[sp50 * 2] = p * s0 + q * s1;
+                    ta[sp50 * 3] = r * s2 - t * s3;
+                    tb[0] = b0 + b2;
+                    tb[sp50] = b1 + b3;
+                    tb[sp50 * 2] = p * s1 - q * s0;
+                    tb[sp50 * 3] = r * s3 + t * s2;
                 }
-                spB4 += spC0;
             }
-            break;
+            var_a0 = ((spA8 * 2) - spBC) + 1;
+            spA8 *= 4;
+        } while (var_a0 < length);
+        DivideAll(arg0, length, 1.414214f);
     }
-}
 
-void AudioSynth_InverseDiscreteCosineTransform(float* buffer0, float* buffer1, int32_t length, float* buffer2) {
-    float temp_ft0;
-    float var_fs0;
-    float* buff0fromStart;
-    float* buf2half2;
-    float* buf2half3;
-    float* buff1half1;
-    float* buff0FromEnd;
-    float* buff1half2;
-    int32_t half;
-    int32_t i;
-    int32_t size;
-
-    size = 1 << length;
-    half = size >> 1;
-
-    // Initialize buffer 2 if it is the wrong size for this calculation
-    if (size != (int32_t) buffer2[0]) {
-        buf2half2 = &buffer2[half];
-        buf2half3 = &buf2half2[half];
-        var_fs0 = 0.0f;
-        temp_ft0 = C_M_PI / (float) (2 * size);
-        for (i = 0; i < half; i++) {
-            *buf2half2++ = (cosf(var_fs0) - sinf(var_fs0)) * 0.707107f;
-            *buf2half3++ = (cosf(var_fs0) + sinf(var_fs0)) * 0.707107f;
-            var_fs0 += temp_ft0;
+    var_a0 = 1;
+    spA8 = 4;
+    do {
+        for (int32_t spCC = var_a0 - 1; spCC < length; spCC += spA8) {
+            const float temp = arg0[spCC];
+            arg0[spCC] = arg0[spCC + 1] + temp;
+            arg0[spCC + 1] = temp - arg0[spCC + 1];
+        }
+        var_a0 = (spA8 * 2) - 1;
+        spA8 *= 4;
+    } while (var_a0 < length);
+    DivideAll(arg0, length, 1.414214f);
+
+    int32_t spB4 = 1;
+    for (int32_t spC8 = 1; spC8 < length; spC8++) {
+        if (spC8 < spB4) {
+            std::swap(arg0[spB4 - 1], arg0[spC8 - 1]);
         }
+        int32_t spC0 = length >> 1;
+        while (spC0 < spB4) {
+            spB4 -= spC0;
+            spC0 >>= 1;
+        }
+        spB4 += spC0;
     }
+}
 
-    // reset the buffer pointers
-    buf2half2 = &buffer2[half];
-    buf2half3 = &buf2half2[half];
-    buff1half1 = buffer1;
-    buff0fromStart = buffer0;
+void SF64::AudioDecompressor::InverseDiscreteCosineTransform(float* buffer0, float* buffer1) const {
+    constexpr int32_t size = BlockSize;
+    constexpr int32_t half = size >> 1;
+    const float* c0 = this->mCosMinusSin.data();
+    const float* c1 = this->mCosPlusSin.data();
 
-    // handle i = 0 case
     buffer1[0] = buffer0[0];
     buffer1[half] = buffer0[half];
 
-    // advance buffer pointers
-    buf2half2++;
-    buf2half3++;
-    buff0fromStart++;
-    buff0FromEnd = &buffer0[size - 1];
-    buff1half1++;
-    buff1half2 = &buffer1[size - 1];
-
-    // convert to real amplitudes
-    for (i = 1; i < half; i++) {
-        *buff1half1++ = (*buf2half2 * *buff0fromStart) + (*buf2half3 * *buff0FromEnd);
-        *buff1half2-- = (*buf2half3 * *buff0fromStart) - (*buf2half2 * *buff0FromEnd);
-        buff0fromStart++;
-        buf2half3++;
-        buf2half2++;
-        buff0FromEnd--;
+    // Convert to real amplitudes, pairing each entry with its mirror
+    int32_t i = 1;
+    for (; i + 3 < half; i += 4) {
+        const auto front = Vec4::Load(buffer0 + i);
+        const auto back = Vec4::LoadReversed(buffer0 + size - i - 3);
+        const auto w0 = Vec4::Load(c0 + i);
+        const auto w1 = Vec4::Load(c1 + i);
+        (w0 * front + w1 * back).Store(buffer1 + i);
+        (w1 * front - w0 * back).StoreReversed(buffer1 + size - i - 3);
+    }
+    for (; i < half; i++) {
+        buffer1[i] = (c0[i] * buffer0[i]) + (c1[i] * buffer0[size - i]);
+        buffer1[size - i] = (c1[i] * buffer0[i]) - (c0[i] * buffer0[size - i]);
     }
 
-    // FFT buffer 1 using buffer 2
-    AudioSynth_HartleyTransform(buffer1, length, buffer2);
-
-    buff0fromStart = buffer0;
-    buff0FromEnd = &buffer0[size - 1];
-    buff1half1 = buffer1;
-    buff1half2 = &buffer1[half];
+    this->HartleyTransform(buffer1);
 
-    // Copy even entries of buffer 0 into the first half of buffer 1. Copy odd entries into the second half in reverse
-    // order
+    // Even entries come from the first half, odd ones from the second half in reverse
     for (i = 0; i < half; i++) {
-        *buff0fromStart = *buff1half1++;
-        *buff0FromEnd = *buff1half2++;
-        buff0fromStart += 2;
-        buff0FromEnd -= 2;
+        buffer0[i * 2] = buffer1[i];
+        buffer0[size - 1 - i * 2] = buffer1[half + i];
     }
 }
 
-void func_80009504(int16_t* arg0, StupidDMAStruct* arg1) {
-    int32_t i;
-
-    if (arg1->unk_0 != nullptr) {
-        arg1->unk_C = arg1->unk_0;
-        arg1->unk_0 = 0;
-    }
-
-    arg1->unk18 += DFT_8014C1B4;
-
-    while (arg1->unk18 > 0x1000) {
-        func_80009124(&arg1->unk_C);
-        arg1->unk18 -= 0x1000;
-    }
+void SF64::AudioDecompressor::Decompress(std::span<const uint8_t> data, int16_t* output) const {
+    alignas(16) float coefs[BlockSize] = {};
+    alignas(16) float scratch[BlockSize];
+    WordReader reader = { data };
+    const size_t blocks = GetOutputSize(data.size()) / BlockSize;
 
-    AudioSynth_InverseDiscreteCosineTransform(DFT_80145D48, DFT_80146148, 8, DFT_80146548);
+    // The first block has no coefficients yet, like the game it decodes to silence
+    for (size_t block = 0; block < blocks; block++) {
+        if (block > 0) {
+            func_80009124(reader, coefs);
+        }
 
-    for (i = 0; i < 256; i++) {
-        if (DFT_80145D48[i] > 32767.0f) {
-            DFT_80145D48[i] = 32767.0f;
+        this->InverseDiscreteCosineTransform(coefs, scratch);
+
+        int16_t* out = output + block * BlockSize;
+#if defined(__SSE2__)
+        const auto max = _mm_set1_ps(32767.0f);
+        const auto min = _mm_set1_ps(-32767.0f);
+        for (int32_t i = 0; i < BlockSize; i += 8) {
+            auto low = _mm_max_ps(_mm_min_ps(_mm_load_ps(coefs + i), max), min);
+            auto high = _mm_max_ps(_mm_min_ps(_mm_load_ps(coefs + i + 4), max), min);
+            _mm_store_ps(coefs + i, low);
+            _mm_store_ps(coefs + i + 4, high);
+            const auto packed = _mm_packs_epi32(_mm_cvttps_epi32(low), _mm_cvttps_epi32(high));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
         }
-        if (DFT_80145D48[i] < -32767.0f) {
-            DFT_80145D48[i] = -32767.0f;
+#else
+        for (int32_t i = 0; i < BlockSize; i++) {
+            if (coefs[i] > 32767.0f) {
+                coefs[i] = 32767.0f;
+            }
+            if (coefs[i] < -32767.0f) {
+                coefs[i] = -32767.0f;
+            }
+            out[i] = (int16_t) coefs[i];
         }
-    }
-
-    for (i = 0; i < 0x100; i++, arg0++) {
-        *arg0 = (int16_t) DFT_80145D48[i];
+#endif
     }
 }
 
-int32_t func_8000967C(int32_t length, int16_t* inputAddr, int16_t* ramAddr, StupidDMAStruct* arg2) {
-    int32_t pad;
-    int32_t temp_t0;
-    int32_t i;
-    int32_t var_s1;
-    int16_t* temp_t7 = inputAddr;
+std::vector<int16_t> SF64::AudioDecompressor::Decompress(std::span<const uint8_t> data) const {
+    std::vector<int16_t> output(GetOutputSize(data.size()));
+    this->Decompress(data, output.data());
+    return output;
+}
 
-    for (i = 0; i < arg2->unk_4; i++) {
-        ramAddr[i] = temp_t7[i];
+std::vector<std::vector<int16_t>> SF64::AudioDecompressor::DecompressMany(std::span<const std::span<const uint8_t>> samples, size_t jobs) const {
+    std::vector<std::vector<int16_t>> outputs(samples.size());
+    if (samples.empty()) {
+        return outputs;
     }
 
-    var_s1 = arg2->unk_4;
-    temp_t0 = (length - arg2->unk_4 + 0xFF) / 256;
-    arg2->unk_4 = (temp_t0 * 256) + arg2->unk_4 - length;
+    Torch::ThreadPool pool(std::min(jobs == 0 ? Torch::ThreadPool::DefaultSize() : jobs, samples.size()));
+    std::vector<std::future<void>> pending;
+    pending.reserve(samples.size());
 
-    for (i = 0; i < temp_t0; i++) {
-        func_80009504(&ramAddr[var_s1], arg2);
-        var_s1 += 0x100;
+    for (size_t i = 0; i < samples.size(); i++) {
+        pending.push_back(pool.Submit([this, &samples, &outputs, i] {
+            outputs[i] = this->Decompress(samples[i]);
+        }));
     }
 
-    for (i = 0; i < arg2->unk_4; i++) {
-        temp_t7[i] = ramAddr[length + i];
+    for (auto& job : pending) {
+        job.get();
     }
-    return temp_t0;
-}
 
-void SF64::DecompressAudio(std::vector<uint8_t> data, int16_t* output) {
-    StupidDMAStruct arg3 = {};
-    arg3.unk_0 = (int16_t*) data.data();
-    arg3.unk_4 = 0;
-    arg3.unk_8 = 0;
-    arg3.unk18 = 0;
-
-    for(int i = 0; i < data.size() / 2; i++){
-        arg3.unk_0[i] = BSWAP16(arg3.unk_0[i]);
-    }
+    return outputs;
+}
 
-    func_8000967C((int32_t) data.size(), arg3.unk_0, (int16_t*) output, &arg3);
-}
\ No newline at end of file
+void SF64::DecompressAudio(std::span<const uint8_t> data, int16_t* output) {
+    AudioDecompressor::Get().Decompress(data, output);
+}
@@ -1,8 +1,50 @@
 #pragma once
 
-#include <cstdint>
+#include <array>
+#include <span>
 #include <vector>
+#include <cstdint>
 
 namespace SF64 {
-    void DecompressAudio(std::vector<uint8_t> data, int16_t* output);
-}
\ No newline at end of file
+    /*
+     * Decoder for the transform coded samples used by Star Fox 64. Every 256 bytes of input
+     * decode into a block of 256 samples through an inverse DCT. The twiddle factors are
+     * computed once, so one instance can be shared by any number of threads.
+     */
+    class AudioDecompressor {
+    public:
+        static constexpr int32_t Log2Size = 8;
+        static constexpr int32_t BlockSize = 1 << Log2Size;
+
+        AudioDecompressor();
+
+        static const AudioDecompressor& Get();
+        // Number of samples the decoder writes for size bytes of input
+        static size_t GetOutputSize(size_t size);
+
+        void Decompress(std::span<const uint8_t> data, int16_t* output) const;
+        std::vector<int16_t> Decompress(std::span<const uint8_t> data) const;
+        // Decodes every sample on a thread pool, jobs = 0 uses every core
+        std::vector<std::vector<int16_t>> DecompressMany(std::span<const std::span<const uint8_t>> samples, size_t jobs = 0) const;
+    private:
+        static constexpr int32_t Stages = Log2Size - 1;
+        static constexpr int32_t Twiddles = BlockSize / 8 - 1;
+
+        // Hartley twiddles of every stage, laid out contiguously so the butterflies can load 4 at a time
+        struct Stage {
+            std::array<float, BlockSize / 8> cos1;
+            std::array<float, BlockSize / 8> sin1;
+            std::array<float, BlockSize / 8> cos3;
+            std::array<float, BlockSize / 8> sin3;
+        };
+
+        std::array<Stage, Stages> mStages;
+        std::array<float, BlockSize / 2> mCosMinusSin;
+        std::array<float, BlockSize / 2> mCosPlusSin;
+
+        void HartleyTransform(float* data) const;
+        void InverseDiscreteCosineTransform(float* coefs, float* scratch) const;
+    };
+
+    void DecompressAudio(std::span<const uint8_t> data, int16_t* output);
+}
@@ -32,7 +32,7 @@ ExportResult SM64::AnimationBinaryExporter::Export(std::ostream &write, std::sha
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SM64::AnimationFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SM64::AnimationFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto offset = node["offset"];
 
     auto [raw, data] = Decompressor::AutoDecode(node, buffer);
@@ -24,7 +24,7 @@ class AnimationBinaryExporter : public BaseExporter {
 
 class AnimationFactory : public BaseFactory {
 public:
-    std::optional<std::shared_ptr<IParsedData>> parse(std::vector<uint8_t>& buffer, YAML::Node& data) override;
+    std::optional<std::shared_ptr<IParsedData>> parse(std::span<uint8_t> buffer, YAML::Node& data) override;
     inline std::unordered_map<ExportType, std::shared_ptr<BaseExporter>> GetExporters() override {
         return { REGISTER(Binary, AnimationBinaryExporter) };
     }
@@ -176,7 +176,7 @@ ExportResult SM64::BehaviorScriptBinaryExporter::Export(std::ostream &write, std
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SM64::BehaviorScriptFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SM64::BehaviorScriptFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
     auto cmd = segment.data;
     bool processing = true;
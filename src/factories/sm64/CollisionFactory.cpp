@@ -347,7 +347,7 @@ ExportResult SM64::CollisionBinaryExporter::Export(std::ostream &write, std::sha
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SM64::CollisionFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SM64::CollisionFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     std::vector<CollisionVertex> vertices;
     std::vector<CollisionSurface> surfaces;
     std::vector<SpecialObject> specialObjects;
@@ -18,7 +18,7 @@ ExportResult SM64::DialogBinaryExporter::Export(std::ostream &write, std::shared
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SM64::DialogFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SM64::DialogFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto [root, segment] = Decompressor::AutoDecode(node, buffer);
 
     LUS::BinaryReader reader(segment.data, segment.size);
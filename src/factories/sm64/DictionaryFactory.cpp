@@ -18,7 +18,7 @@ ExportResult SM64::DictionaryBinaryExporter::Export(std::ostream &write, std::sh
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SM64::DictionaryFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& data) {
+std::optional<std::shared_ptr<IParsedData>> SM64::DictionaryFactory::parse(std::span<uint8_t> buffer, YAML::Node& data) {
     std::unordered_map<std::string, std::vector<uint8_t>> dictionary;
 
     for (auto it = data["keys"].begin(); it != data["keys"].end(); ++it) {
@@ -316,7 +316,7 @@ ExportResult SM64::GeoHeaderExporter::Export(std::ostream&write, std::shared_ptr
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SM64::GeoLayoutFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SM64::GeoLayoutFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
     auto cmd = segment.data;
 
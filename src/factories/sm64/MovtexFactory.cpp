@@ -126,7 +126,7 @@ ExportResult SM64::MovtexBinaryExporter::Export(std::ostream &write, std::shared
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SM64::MovtexFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SM64::MovtexFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     const auto offset = GetSafeNode<uint32_t>(node, "offset");
     const auto symbol = GetSafeNode<std::string>(node, "symbol");
     bool isQuad = false;
@@ -77,7 +77,7 @@ ExportResult SM64::PaintingMapBinaryExporter::Export(std::ostream &write, std::s
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SM64::PaintingMapFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SM64::PaintingMapFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
     std::vector<PaintingMapping> paintingMappings;
     std::vector<Vec3s> paintingGroups;
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
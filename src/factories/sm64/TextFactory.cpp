@@ -12,7 +12,7 @@ ExportResult SM64::TextBinaryExporter::Export(std::ostream &write, std::shared_p
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<IParsedData>> SM64::TextFactory::parse(std::vector<uint8_t>& buffer, YAML::Node& node) {
+std::optional<std::shared_ptr<IParsedData>> SM64::TextFactory::parse(std::span<uint8_t> buffer, YAML::Node& node) {
 
     std::vector<uint8_t> text;
     auto [_, segment] = Decompressor::AutoDecode(node, buffer);
@@ -48,6 +48,9 @@ EMSCRIPTEN_BINDINGS(Torch) {
         .function("Init", &Companion::Init)
         .function("GetCartridge", &Companion::GetCartridge, allow_raw_pointers())
         .function("Process", &Companion::Process)
-        .function("GetRomData", &Companion::GetRomData, allow_raw_pointers());
+        .function("GetRomData", optional_override([](Companion& self) {
+            auto rom = self.GetRomData();
+            return std::vector<uint8_t>(rom.begin(), rom.end());
+        }));
 }
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <iostream>
 #include "CLI11.hpp"
 #include "Companion.h"
+#include "utils/Logging.h"
 
 #if defined(STANDALONE) && !defined(__EMSCRIPTEN__)
 
@@ -21,8 +22,22 @@ int main(int argc, char *argv[]) {
     std::string srcdir;
     std::string destdir;
     std::vector<std::string> additionalFiles;
+    uint32_t jobs = 1;
+    bool store = false;
 
     app.require_subcommand();
+    // Lets the logging options below come after the subcommand too
+    app.fallthrough();
+
+    // Applied as soon as they are parsed, so they are in place before Init registers anything
+    app.add_flag_callback("-q,--quiet", [] {
+        Torch::Logging::ForceLevel(spdlog::level::warn);
+    }, "Only print warnings and errors")->trigger_on_parse();
+    app.add_option_function<std::string>("--log-level", [](const std::string& level) {
+        Torch::Logging::ForceLevel(Torch::Logging::ParseLevel(level).value());
+    }, "Logging level, overrides the one in config.yml")
+        ->check(CLI::IsMember({ "trace", "debug", "info", "warn", "error", "critical", "off" }, CLI::ignore_case))
+        ->trigger_on_parse();
 
     /* Generate an OTR */
     const auto otr = app.add_subcommand("otr", "OTR - Generates an otr\n");
@@ -31,9 +46,11 @@ int main(int argc, char *argv[]) {
     otr->add_flag("-v,--verbose", debug, "Verbose Debug Mode");
     otr->add_option("-s,--srcdir", srcdir, "Set source directory to locate config.yml and asset metadata for processing")->check(CLI::ExistingDirectory);
     otr->add_option("-d,--destdir", destdir, "Set destination directory for export");
+    otr->add_option("-j,--jobs", jobs, "Number of yaml files to process in parallel, 0 uses every core");
 
     otr->parse_complete_callback([&] {
         const auto instance = Companion::Instance = new Companion(filename, ArchiveType::OTR, debug, srcdir, destdir);
+        instance->SetJobs(jobs);
         instance->Init(ExportType::Binary);
     });
 
@@ -44,11 +61,15 @@ int main(int argc, char *argv[]) {
     o2r->add_flag("-v,--verbose", debug, "Verbose Debug Mode");
     o2r->add_option("-s,--srcdir", srcdir, "Set source directory to locate config.yml and asset metadata for processing")->check(CLI::ExistingDirectory);
     o2r->add_option("-d,--destdir", destdir, "Set destination directory for export");
+    o2r->add_option("-j,--jobs", jobs, "Number of yaml files to process in parallel, 0 uses every core");
     o2r->add_option("-a,--additional-files", additionalFiles, "Additional files to include in the o2r archive (e.g., mods.toml)")->check(CLI::ExistingFile);
+    o2r->add_flag("--store", store, "Store files in the o2r without compression, faster for local builds");
 
     o2r->parse_complete_callback([&] {
         const auto instance = Companion::Instance = new Companion(filename, ArchiveType::O2R, debug, srcdir, destdir);
+        instance->SetJobs(jobs);
         instance->SetAdditionalFiles(additionalFiles);
+        instance->SetStoreArchive(store);
         instance->Init(ExportType::Binary);
     });
 
@@ -59,9 +80,11 @@ int main(int argc, char *argv[]) {
     code->add_flag("-v,--verbose", debug, "Verbose Debug Mode; adds offsets to C code");
     code->add_option("-s,--srcdir", srcdir, "Set source directory to locate config.yml and asset metadata for processing")->check(CLI::ExistingDirectory);
     code->add_option("-d,--destdir", destdir, "Set destination directory to place C code to");
+    code->add_option("-j,--jobs", jobs, "Number of yaml files to process in parallel, 0 uses every core");
 
     code->parse_complete_callback([&]() {
         const auto instance = Companion::Instance = new Companion(filename, ArchiveType::None, debug, srcdir, destdir);
+        instance->SetJobs(jobs);
         instance->Init(ExportType::Code);
     });
 
@@ -71,9 +94,11 @@ int main(int argc, char *argv[]) {
     binary->add_option("<baserom.z64>", filename, "")->required()->check(CLI::ExistingFile);
     binary->add_option("-s,--srcdir", srcdir, "Set source directory to locate config.yml and asset metadata for processing")->check(CLI::ExistingDirectory);
     binary->add_option("-d,--destdir", destdir, "Set destination directory to place binary to");
+    binary->add_option("-j,--jobs", jobs, "Number of yaml files to process in parallel, 0 uses every core");
 
     binary->parse_complete_callback([&] {
         const auto instance = Companion::Instance = new Companion(filename, ArchiveType::None, debug, srcdir, destdir);
+        instance->SetJobs(jobs);
         instance->Init(ExportType::Binary);
     });
 
@@ -84,6 +109,7 @@ int main(int argc, char *argv[]) {
     header->add_flag("-o,--otr", otrModeSelected, "OTR/O2R Mode");
     header->add_option("-s,--srcdir", srcdir, "Set source directory to locate config.yml and asset metadata for processing")->check(CLI::ExistingDirectory);
     header->add_option("-d,--destdir", destdir, "Set destination directory to place headers to");
+    header->add_option("-j,--jobs", jobs, "Number of yaml files to process in parallel, 0 uses every core");
 
     header->parse_complete_callback([&] {
         if (otrModeSelected) {
@@ -93,6 +119,7 @@ int main(int argc, char *argv[]) {
         }
 
         const auto instance = Companion::Instance = new Companion(filename, otrMode, debug, srcdir, destdir);
+        instance->SetJobs(jobs);
         instance->Init(ExportType::Header);
     });
 
@@ -102,6 +129,7 @@ int main(int argc, char *argv[]) {
     pack->add_option("<folder>", folder, "Generate OTR from a directory of assets")->required()->check(CLI::ExistingDirectory);
     pack->add_option("<target>", target, "Archive output destination")->required();
     pack->add_option("<archive-type>", archive, "Archive type: otr or o2r")->required();
+    pack->add_flag("--store", store, "Store files in the o2r without compression, faster for local builds");
 
     
     pack->parse_complete_callback([&] {
@@ -114,7 +142,7 @@ int main(int argc, char *argv[]) {
         }
 
         if (!folder.empty()) {
-            Companion::Pack(folder, target, otrMode);
+            Companion::Pack(folder, target, otrMode, store);
         } else {
             std::cout << "The folder is empty" << std::endl;
         }
@@ -130,6 +158,7 @@ int main(int argc, char *argv[]) {
     modding_import->add_flag("-v,--verbose", debug, "Verbose Debug Mode");
     modding_import->add_option("-s,--srcdir", srcdir, "Set source directory to locate config.yml and asset metadata for processing, including modified files")->check(CLI::ExistingDirectory);
     modding_import->add_option("-d,--destdir", destdir, "Set destination directory to place for generating C code");
+    modding_import->add_option("-j,--jobs", jobs, "Number of yaml files to process in parallel, 0 uses every core");
 
     modding_import->parse_complete_callback([&] {
         ArchiveType otrMode;
@@ -143,6 +172,7 @@ int main(int argc, char *argv[]) {
         }
 
         const auto instance = Companion::Instance = new Companion(filename, otrMode, debug, true, srcdir, destdir);
+        instance->SetJobs(jobs);
         if (mode == "code") {
             instance->Init(ExportType::Code);
         } else if (mode == "otr" || mode == "o2r") {
@@ -158,9 +188,11 @@ int main(int argc, char *argv[]) {
     modding_export->add_option("<baserom.z64>", filename, "")->required()->check(CLI::ExistingFile);
     modding_export->add_option("-s,--srcdir", srcdir, "Set source directory to locate config.yml and asset metadata for processing, including modified files")->check(CLI::ExistingDirectory);
     modding_export->add_option("-d,--destdir", destdir, "Set destination directory to place for generating modified files");
+    modding_export->add_option("-j,--jobs", jobs, "Number of yaml files to process in parallel, 0 uses every core");
 
     modding_export->parse_complete_callback([&] {
         const auto instance = Companion::Instance = new Companion(filename, ArchiveType::None, debug, srcdir, destdir);
+        instance->SetJobs(jobs);
         if (xmlMode) {
             instance->Init(ExportType::XML);
         } else {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <vector>
 #include <string>
 #include <cstdint>
@@ -14,7 +15,7 @@ enum class CountryCode {
 
 class Cartridge {
 public:
-    explicit Cartridge(const std::vector<uint8_t>& romData)
+    explicit Cartridge(std::span<const uint8_t> romData)
       : gRomData(romData), gCountryCode(CountryCode::Unknown), gVersion(0), gGameTitle("Unknown"), gRomCRC(0) {
   }
   void Initialize();
@@ -25,7 +26,7 @@ public:
     std::string GetHash();
     uint32_t GetCRC();
 private:
-    std::vector<uint8_t> gRomData;
+    std::span<const uint8_t> gRomData;
     CountryCode gCountryCode;
     uint8_t gVersion;
     std::string gGameTitle;
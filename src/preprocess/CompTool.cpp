@@ -5,7 +5,7 @@
 #include <fstream>
 #include <cstring>
 
-uint32_t CompTool::FindFileTable(std::vector<uint8_t>& rom) {
+uint32_t CompTool::FindFileTable(std::span<uint8_t> rom) {
     uint8_t query_one[] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x50, 0x00, 0x00, 0x00, 0x00 };
     uint8_t query_two[] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x60, 0x00, 0x00, 0x00, 0x00 };
 
@@ -55,7 +55,7 @@ std::pair<uint32_t, uint32_t> CompTool::CalculateCRCs(LUS::BinaryWriter& decompF
     return std::make_pair(t6 ^ t4 ^ t3, t5 ^ t2 ^ t1);
 }
 
-std::vector<uint8_t> CompTool::Decompress(std::vector<uint8_t> rom){
+std::vector<uint8_t> CompTool::Decompress(std::span<uint8_t> rom){
     LUS::BinaryReader basefile((char*) rom.data(), rom.size());
     basefile.SetEndianness(Torch::Endianness::Big);
 
@@ -76,7 +76,7 @@ std::vector<uint8_t> CompTool::Decompress(std::vector<uint8_t> rom){
 
         auto p_size = p_end - p_begin;
         auto v_size = (int32_t) 0;
-        DataChunk* decoded = nullptr;
+        std::shared_ptr<DataChunk> decoded;
 
         if(v_begin == 0 && p_end == 0){
             break;
@@ -84,15 +84,16 @@ std::vector<uint8_t> CompTool::Decompress(std::vector<uint8_t> rom){
 
         basefile.Seek(p_begin, LUS::SeekOffsetType::Start);
 
-        auto bytes = new uint8_t[p_size];
-        basefile.Read((char*) bytes, p_size);
+        std::vector<uint8_t> raw(p_size);
+        basefile.Read((char*) raw.data(), p_size);
+        auto bytes = raw.data();
 
         switch ((CompType) comp_flag) {
             case CompType::UNCOMPRESSED:
                 v_size = p_size;
                 break;
             case CompType::COMPRESSED:
-                decoded = Decompressor::Decode(std::vector(bytes, bytes + p_size), 0, CompressionType::MIO0, true);
+                decoded = Decompressor::Decode(raw, 0, CompressionType::MIO0, true);
                 bytes = decoded->data;
                 v_size = decoded->size;
                 break;
@@ -3,6 +3,7 @@
 #include "lib/binarytools/BinaryWriter.h"
 #include <cstdint>
 #include <string>
+#include <span>
 #include <vector>
 
 enum class CompType {
@@ -13,9 +14,9 @@ enum class CompType {
 
 class CompTool {
 public:
-    static std::vector<uint8_t> Decompress(std::vector<uint8_t> rom);
+    static std::vector<uint8_t> Decompress(std::span<uint8_t> rom);
 private:
-    static uint32_t FindFileTable(std::vector<uint8_t>& rom);
+    static uint32_t FindFileTable(std::span<uint8_t> rom);
     static std::pair<uint32_t, uint32_t> CalculateCRCs(LUS::BinaryWriter& decompFile);
     static inline const uint32_t sCrcSeed = 0xF8CA4DDC;
 };
@@ -0,0 +1,11 @@
+#include "AssetDescriptor.h"
+
+#include <stdexcept>
+
+const std::string& AssetDescriptor::GetSymbol() const {
+    if(!this->symbol.has_value()) {
+        throw std::runtime_error("Yaml asset missing the 'symbol' node\nProblematic YAML:\n" + YAML::Dump(this->node));
+    }
+
+    return this->symbol.value();
+}
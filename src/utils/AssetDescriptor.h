@@ -0,0 +1,42 @@
+#pragma once
+
+#include <tuple>
+#include <memory>
+#include <string>
+#include <optional>
+#include <cstdint>
+#include <unordered_map>
+#include <yaml-cpp/yaml.h>
+
+class BaseFactory;
+
+/*
+ * The fields shared by every asset node, read out of the yaml once when the node is registered.
+ * Lookups in the asset graph go through these instead of yaml-cpp, the node itself is only kept
+ * around for the factory specific parameters.
+ */
+struct AssetDescriptor {
+    // Output path of the asset
+    std::string name;
+    // Upper case, as the factories are registered
+    std::string type;
+    std::shared_ptr<BaseFactory> factory;
+    std::optional<uint32_t> offset;
+    std::optional<std::string> symbol;
+    std::optional<std::string> comment;
+    // Size in the rom when the factory can tell it up front
+    std::optional<uint32_t> size;
+    uint32_t alignment = 4;
+    bool autogen = false;
+    YAML::Node node;
+
+    // Throws like GetSafeNode when the node has no symbol
+    const std::string& GetSymbol() const;
+
+    std::tuple<std::string, YAML::Node> ToTuple() const {
+        return { this->name, this->node };
+    }
+};
+
+typedef std::shared_ptr<const AssetDescriptor> AssetRef;
+typedef std::unordered_map<uint32_t, AssetRef> AssetAddrMap;
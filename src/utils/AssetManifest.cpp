@@ -0,0 +1,156 @@
+#include "AssetManifest.h"
+
+#include <fstream>
+#include "spdlog/spdlog.h"
+#include "Companion.h"
+#include "utils/MappedFile.h"
+#include "lib/binarytools/BinaryReader.h"
+#include "lib/binarytools/BinaryWriter.h"
+
+#define MANIFEST_MAGIC 0x544D414E
+#define MANIFEST_VERSION 2
+
+enum class EndPointer : uint8_t {
+    None,
+    Size,
+    Offset
+};
+
+static void WriteBuffer(LUS::BinaryWriter& writer, const std::string& str) {
+    writer.Write(static_cast<uint32_t>(str.size()));
+    writer.Write(const_cast<char*>(str.data()), str.size());
+}
+
+static std::string ReadBuffer(LUS::BinaryReader& reader) {
+    std::string str(reader.ReadUInt32(), '\0');
+    reader.Read(str.data(), static_cast<int32_t>(str.size()));
+    return str;
+}
+
+void AssetManifest::Load(const std::filesystem::path& path) {
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    this->mEntries.clear();
+
+    if(!std::filesystem::exists(path)) {
+        return;
+    }
+
+    auto data = Torch::MappedFile::ReadAll(path);
+    LUS::BinaryReader reader(data.data(), data.size());
+    reader.SetEndianness(Torch::Endianness::Big);
+
+    // A manifest we can't read only means everything gets exported again
+    try {
+        if(reader.ReadUInt32() != MANIFEST_MAGIC || reader.ReadUInt32() != MANIFEST_VERSION) {
+            SPDLOG_WARN("Ignoring outdated asset manifest {}", path.string());
+            return;
+        }
+
+        const auto count = reader.ReadUInt32();
+        for(uint32_t i = 0; i < count; i++) {
+            auto key = ReadBuffer(reader);
+            Entry entry;
+            entry.fingerprint = ReadBuffer(reader);
+            entry.name = ReadBuffer(reader);
+            entry.output = ReadBuffer(reader);
+            entry.start = reader.ReadUInt64();
+            entry.size = reader.ReadUInt64();
+            entry.hash = ReadBuffer(reader);
+
+            switch (static_cast<EndPointer>(reader.ReadUByte())) {
+                case EndPointer::Size:
+                    entry.endptr = static_cast<size_t>(reader.ReadUInt64());
+                    break;
+                case EndPointer::Offset: {
+                    const auto start = reader.ReadUInt32();
+                    const auto end = reader.ReadUInt32();
+                    entry.endptr = OffsetEntry{ start, end };
+                    break;
+                }
+                default:
+                    entry.endptr = std::nullopt;
+                    break;
+            }
+
+            this->mEntries[key] = std::move(entry);
+        }
+    } catch (const std::exception& e) {
+        SPDLOG_WARN("Failed to read asset manifest {}: {}", path.string(), e.what());
+        this->mEntries.clear();
+    }
+}
+
+void AssetManifest::Save(const std::filesystem::path& path) {
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    LUS::BinaryWriter writer;
+    writer.SetEndianness(Torch::Endianness::Big);
+    writer.Write(static_cast<uint32_t>(MANIFEST_MAGIC));
+    writer.Write(static_cast<uint32_t>(MANIFEST_VERSION));
+    writer.Write(static_cast<uint32_t>(this->mEntries.size()));
+
+    for(auto& [key, entry] : this->mEntries) {
+        WriteBuffer(writer, key);
+        WriteBuffer(writer, entry.fingerprint);
+        WriteBuffer(writer, entry.name);
+        WriteBuffer(writer, entry.output);
+        writer.Write(entry.start);
+        writer.Write(entry.size);
+        WriteBuffer(writer, entry.hash);
+
+        if(!entry.endptr.has_value()) {
+            writer.Write(static_cast<uint8_t>(EndPointer::None));
+        } else if(std::holds_alternative<size_t>(entry.endptr.value())) {
+            writer.Write(static_cast<uint8_t>(EndPointer::Size));
+            writer.Write(static_cast<uint64_t>(std::get<size_t>(entry.endptr.value())));
+        } else {
+            const auto offset = std::get<OffsetEntry>(entry.endptr.value());
+            writer.Write(static_cast<uint8_t>(EndPointer::Offset));
+            writer.Write(offset.start);
+            writer.Write(offset.end);
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    writer.Finish(file);
+    file.close();
+}
+
+std::optional<AssetManifest::Entry> AssetManifest::Find(const std::string& key, const std::string& fingerprint) {
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    const auto it = this->mEntries.find(key);
+    if(it == this->mEntries.end() || it->second.fingerprint != fingerprint) {
+        return std::nullopt;
+    }
+
+    return it->second;
+}
+
+void AssetManifest::Store(const std::string& key, Entry entry) {
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    this->mEntries[key] = std::move(entry);
+}
+
+std::optional<std::string> AssetManifest::ReadOutput(const Entry& entry, std::unordered_map<std::string, std::vector<uint8_t>>& files) {
+    auto file = files.find(entry.output);
+    if(file == files.end()) {
+        std::vector<uint8_t> data;
+        if(std::filesystem::exists(entry.output)) {
+            data = Torch::MappedFile::ReadAll(entry.output);
+        }
+        file = files.emplace(entry.output, std::move(data)).first;
+    }
+
+    // The output may have been deleted or edited since it was written
+    const auto& data = file->second;
+    if(entry.start > data.size() || entry.size > data.size() - entry.start) {
+        return std::nullopt;
+    }
+
+    const auto text = std::span(data).subspan(entry.start, entry.size);
+    if(Companion::CalculateHash(text) != entry.hash) {
+        return std::nullopt;
+    }
+
+    return std::string(text.begin(), text.end());
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <optional>
+#include <filesystem>
+#include <unordered_map>
+#include "factories/BaseFactory.h"
+
+/*
+ * Fingerprint of everything every exported asset was generated from, along with where its
+ * text ended up in the previous run's output, so the assets that did not change can copy
+ * it back from there instead of going through the exporter again.
+ */
+class AssetManifest {
+public:
+    struct Entry {
+        std::string fingerprint;
+        // Exporters may rename the entry, e.g. to append the texture format
+        std::string name;
+        ExportResult endptr;
+        // File the text was written to, its range in there and its hash
+        std::string output;
+        uint64_t start = 0;
+        uint64_t size = 0;
+        std::string hash;
+    };
+
+    void Load(const std::filesystem::path& path);
+    void Save(const std::filesystem::path& path);
+    std::optional<Entry> Find(const std::string& key, const std::string& fingerprint);
+    void Store(const std::string& key, Entry entry);
+
+    // Text of an entry as the previous run wrote it, files caches the outputs read so far
+    static std::optional<std::string> ReadOutput(const Entry& entry, std::unordered_map<std::string, std::vector<uint8_t>>& files);
+private:
+    std::mutex mMutex;
+    std::unordered_map<std::string, Entry> mEntries;
+};
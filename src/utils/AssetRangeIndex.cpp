@@ -0,0 +1,48 @@
+#include "AssetRangeIndex.h"
+
+#include <algorithm>
+
+void AssetRangeIndex::Insert(const AssetRef& asset) {
+    if(!asset->offset.has_value()) {
+        return;
+    }
+
+    // Autogenerated assets are not considered when looking for the asset that contains an address
+    if(asset->autogen || !asset->size.has_value()) {
+        this->Erase(asset->offset.value());
+        return;
+    }
+
+    this->mRanges[asset->offset.value()] = asset;
+    this->mMaxSize = std::max(this->mMaxSize, asset->size.value());
+}
+
+void AssetRangeIndex::Erase(uint32_t start) {
+    this->mRanges.erase(start);
+}
+
+AssetRef AssetRangeIndex::Find(const std::string& type, uint32_t addr) const {
+    auto it = this->mRanges.lower_bound(addr);
+    AssetRef best = nullptr;
+
+    // Ranges can overlap, so keep walking back until none of them could reach the address
+    while(it != this->mRanges.begin()) {
+        --it;
+        const auto& [start, asset] = *it;
+
+        if(static_cast<uint64_t>(start) + this->mMaxSize <= addr) {
+            break;
+        }
+
+        if(asset->type != type || addr >= static_cast<uint64_t>(start) + asset->size.value()) {
+            continue;
+        }
+
+        // Walking back lowers the start, so >= also settles ties on the lowest one
+        if(best == nullptr || asset->size.value() >= best->size.value()) {
+            best = asset;
+        }
+    }
+
+    return best;
+}
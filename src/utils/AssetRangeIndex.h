@@ -0,0 +1,23 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <cstdint>
+#include "AssetDescriptor.h"
+
+/*
+ * Address ranges of the assets of a file sorted by start address, used to
+ * find which asset contains a given address without scanning every node.
+ */
+class AssetRangeIndex {
+public:
+    // Indexes the asset when it has an offset and a known size, otherwise drops the one at its offset
+    void Insert(const AssetRef& asset);
+    void Erase(uint32_t start);
+    // Finds the asset of the given type where start < addr < start + size. When several overlap
+    // the widest one wins, then the lowest start, so a pointer into a sub array resolves to the enclosing array
+    AssetRef Find(const std::string& type, uint32_t addr) const;
+private:
+    std::map<uint32_t, AssetRef> mRanges;
+    uint32_t mMaxSize = 0;
+};
@@ -1,6 +1,9 @@
 #include "Decompressor.h"
 
 #include <stdexcept>
+#include <mutex>
+#include <thread>
+#include <fstream>
 #include "spdlog/spdlog.h"
 #include <Companion.h>
 
@@ -11,15 +14,128 @@ extern "C" {
 #include <libmio0/tkmk00.h>
 }
 
-std::unordered_map<uint32_t, DataChunk*> gCachedChunks;
+#define ALIGN4(val) (((val) + 0x3) & ~0x3)
 
-DataChunk* Decompressor::Decode(const std::vector<uint8_t>& buffer, const uint32_t offset, const CompressionType type, bool ignoreCache) {
+namespace fs = std::filesystem;
 
-    if(!ignoreCache && gCachedChunks.contains(offset)){
-        return gCachedChunks[offset];
+std::unordered_map<std::string, std::shared_ptr<DataChunk>> gCachedChunks;
+std::optional<fs::path> gCacheDirectory;
+std::mutex gCachedChunksMutex;
+
+static void ReleaseArray(uint8_t* data) {
+    delete[] data;
+}
+
+static void ReleaseMalloc(uint8_t* data) {
+    free(data);
+}
+
+// The chunk frees its data with the same allocator that produced it once the last reference is gone
+static std::shared_ptr<DataChunk> MakeChunk(uint8_t* data, const size_t size, void (*release)(uint8_t*)) {
+    return std::shared_ptr<DataChunk>(new DataChunk{ data, size }, [release](DataChunk* chunk) {
+        release(chunk->data);
+        delete chunk;
+    });
+}
+
+static std::string GetChunkKey(const std::string& codec, const uint32_t offset) {
+    return fmt::format("{}_{:08X}", codec, offset);
+}
+
+static std::shared_ptr<DataChunk> LoadCachedChunk(const std::string& key) {
+    std::optional<fs::path> directory;
+    {
+        std::lock_guard<std::mutex> lock(gCachedChunksMutex);
+        const auto it = gCachedChunks.find(key);
+        if(it != gCachedChunks.end()) {
+            return it->second;
+        }
+        directory = gCacheDirectory;
+    }
+
+    if(!directory.has_value()) {
+        return nullptr;
+    }
+
+    const auto path = directory.value() / (key + ".bin");
+    std::error_code ec;
+    const auto size = fs::file_size(path, ec);
+    if(ec) {
+        return nullptr;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    auto chunk = MakeChunk(new uint8_t[size], size, ReleaseArray);
+    if(!file.read(reinterpret_cast<char*>(chunk->data), size)) {
+        SPDLOG_WARN("Failed to read cached chunk {}", path.string());
+        return nullptr;
+    }
+
+    SPDLOG_DEBUG("Loaded cached chunk {}", path.string());
+    std::lock_guard<std::mutex> lock(gCachedChunksMutex);
+    return gCachedChunks.try_emplace(key, chunk).first->second;
+}
+
+// Decoding happens outside the lock, so two threads may race on the same chunk, the first one stored wins
+static std::shared_ptr<DataChunk> CacheChunk(const std::string& key, const std::shared_ptr<DataChunk>& chunk) {
+    std::optional<fs::path> directory;
+    {
+        std::lock_guard<std::mutex> lock(gCachedChunksMutex);
+        const auto [it, inserted] = gCachedChunks.try_emplace(key, chunk);
+        if(!inserted) {
+            return it->second;
+        }
+        directory = gCacheDirectory;
+    }
+
+    if(directory.has_value()) {
+        // Write to a temporary file first so an interrupted run never leaves a truncated chunk behind
+        const auto path = directory.value() / (key + ".bin");
+        auto temp = path;
+        temp += fmt::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+        std::ofstream file(temp, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(chunk->data), chunk->size);
+        file.close();
+
+        std::error_code ec;
+        if(file.good()) {
+            fs::rename(temp, path, ec);
+        }
+        if(!file.good() || ec) {
+            SPDLOG_WARN("Failed to write cached chunk {}", path.string());
+            fs::remove(temp, ec);
+        }
+    }
+
+    return chunk;
+}
+
+std::shared_ptr<DataChunk> Decompressor::Decode(std::span<const uint8_t> buffer, const uint32_t offset, const CompressionType type, bool ignoreCache) {
+    std::string key;
+
+    switch (type) {
+        case CompressionType::MIO0:
+            key = GetChunkKey("mio0", offset);
+            break;
+        case CompressionType::YAY0:
+            key = GetChunkKey("yay0", offset);
+            break;
+        case CompressionType::YAY1:
+            key = GetChunkKey("yay1", offset);
+            break;
+        default:
+            throw std::runtime_error("Unknown compression type");
+    }
+
+    if(!ignoreCache){
+        if(auto cached = LoadCachedChunk(key)){
+            return cached;
+        }
     }
 
     const unsigned char* in_buf = buffer.data() + offset;
+    std::shared_ptr<DataChunk> chunk;
 
     switch (type) {
         case CompressionType::MIO0: {
@@ -30,8 +146,8 @@ DataChunk* Decompressor::Decode(const std::vector<uint8_t>& buffer, const uint32
 
             const auto decompressed = new uint8_t[head.dest_size];
             mio0_decode(in_buf, decompressed, nullptr);
-            gCachedChunks[offset] = new DataChunk{ decompressed, head.dest_size };
-            return gCachedChunks[offset];
+            chunk = MakeChunk(decompressed, head.dest_size, ReleaseArray);
+            break;
         }
         case CompressionType::YAY0: {
             uint32_t size = 0;
@@ -41,8 +157,8 @@ DataChunk* Decompressor::Decode(const std::vector<uint8_t>& buffer, const uint32
                 throw std::runtime_error("Failed to decode YAY0");
             }
 
-            gCachedChunks[offset] = new DataChunk{ decompressed, size };
-            return gCachedChunks[offset];
+            chunk = MakeChunk(decompressed, size, ReleaseMalloc);
+            break;
         }
         case CompressionType::YAY1: {
             uint32_t size = 0;
@@ -52,29 +168,97 @@ DataChunk* Decompressor::Decode(const std::vector<uint8_t>& buffer, const uint32
                 throw std::runtime_error("Failed to decode YAY1");
             }
 
-            gCachedChunks[offset] = new DataChunk{ decompressed, size };
-            return gCachedChunks[offset];
+            chunk = MakeChunk(decompressed, size, ReleaseMalloc);
+            break;
         }
         default:
             throw std::runtime_error("Unknown compression type");
     }
+
+    return ignoreCache ? chunk : CacheChunk(key, chunk);
+}
+
+size_t Decompressor::GetMaxEncodedSize(const size_t size, const CompressionType type) {
+    size_t headerSize;
+
+    switch (type) {
+        case CompressionType::MIO0:
+            headerSize = MIO0_HEADER_LENGTH;
+            break;
+        case CompressionType::YAY0:
+            headerSize = YAY0_HEADER_LENGTH;
+            break;
+        case CompressionType::YAY1:
+            headerSize = YAY1_HEADER_LENGTH;
+            break;
+        default:
+            throw std::runtime_error("Unsupported compression type for encoding");
+    }
+
+    // Every byte stored uncompressed plus one control bit per byte, the data after the control bits starts 4 byte aligned
+    return ALIGN4(headerSize + (size + 7) / 8) + size;
 }
 
-DataChunk* Decompressor::DecodeTKMK00(const std::vector<uint8_t>& buffer, const uint32_t offset, const uint32_t size, const uint32_t alpha) {
-    if(gCachedChunks.contains(offset)){
-        return gCachedChunks[offset];
+std::shared_ptr<DataChunk> Decompressor::Encode(std::span<const uint8_t> data, const CompressionType type) {
+    std::string codec;
+
+    switch (type) {
+        case CompressionType::MIO0:
+            codec = "mio0";
+            break;
+        case CompressionType::YAY0:
+            codec = "yay0";
+            break;
+        case CompressionType::YAY1:
+            codec = "yay1";
+            break;
+        default:
+            throw std::runtime_error("Unsupported compression type for encoding");
+    }
+
+    const auto key = fmt::format("enc_{}_{}", codec, Companion::CalculateHash(data));
+    if(auto cached = LoadCachedChunk(key)) {
+        return cached;
+    }
+
+    auto encoded = std::make_unique<uint8_t[]>(GetMaxEncodedSize(data.size(), type));
+    int32_t size;
+
+    switch (type) {
+        case CompressionType::MIO0:
+            size = mio0_encode(data.data(), data.size(), encoded.get());
+            break;
+        case CompressionType::YAY0:
+            size = yay0_encode(data.data(), data.size(), encoded.get());
+            break;
+        default:
+            size = yay1_encode(data.data(), data.size(), encoded.get());
+            break;
+    }
+
+    if(size < 0) {
+        throw std::runtime_error("Failed to encode " + codec);
+    }
+
+    return CacheChunk(key, MakeChunk(encoded.release(), size, ReleaseArray));
+}
+
+std::shared_ptr<DataChunk> Decompressor::DecodeTKMK00(std::span<const uint8_t> buffer, const uint32_t offset, const uint32_t size, const uint32_t alpha) {
+    const auto key = fmt::format("{}_{:X}_{:X}", GetChunkKey("tkmk00", offset), size, alpha);
+
+    if(auto cached = LoadCachedChunk(key)){
+        return cached;
     }
 
     const uint8_t* in_buf = buffer.data() + offset;
 
-    const auto decompressed = new uint8_t[size];
+    const auto decompressed = std::make_unique<uint8_t[]>(size);
     const auto rgba = new uint8_t[size];
-    tkmk00_decode(in_buf, decompressed, rgba, alpha);
-    gCachedChunks[offset] = new DataChunk{ rgba, size };
-    return gCachedChunks[offset];
+    tkmk00_decode(in_buf, decompressed.get(), rgba, alpha);
+    return CacheChunk(key, MakeChunk(rgba, size, ReleaseArray));
 }
 
-DecompressedData Decompressor::AutoDecode(YAML::Node& node, std::vector<uint8_t>& buffer, std::optional<size_t> manualSize) {
+DecompressedData Decompressor::AutoDecode(YAML::Node& node, std::span<uint8_t> buffer, std::optional<size_t> manualSize) {
     auto offset = GetSafeNode<uint32_t>(node, "offset");
 
     CompressionType type = Companion::Instance->GetCurrCompressionType();
@@ -147,7 +331,7 @@ DecompressedData Decompressor::AutoDecode(YAML::Node& node, std::vector<uint8_t>
     throw std::runtime_error("Auto decode could not find a compression type nor uncompressed segment.\nThis is one of those issues that should never really happen.");
 }
 
-DecompressedData Decompressor::AutoDecode(uint32_t offset, std::optional<size_t> size, std::vector<uint8_t>& buffer) {
+DecompressedData Decompressor::AutoDecode(uint32_t offset, std::optional<size_t> size, std::span<uint8_t> buffer) {
     YAML::Node node;
     node["offset"] = offset;
 
@@ -178,7 +362,7 @@ uint32_t Decompressor::TranslateAddr(uint32_t addr, bool baseAddress){
     return addr;
 }
 
-CompressionType Decompressor::GetCompressionType(std::vector<uint8_t>& buffer, const uint32_t offset) {
+CompressionType Decompressor::GetCompressionType(std::span<uint8_t> buffer, const uint32_t offset) {
     if (offset) {
         LUS::BinaryReader reader((char*) buffer.data() + offset, sizeof(uint32_t));
         reader.SetEndianness(Torch::Endianness::Big);
@@ -220,9 +404,31 @@ bool Decompressor::IsSegmented(uint32_t addr) {
     return false;
 }
 
-void Decompressor::ClearCache() {
-    for(auto& [key, value] : gCachedChunks){
-        delete value->data;
+void Decompressor::SetCacheDirectory(const std::optional<fs::path>& directory) {
+    if(directory.has_value()) {
+        std::error_code ec;
+        fs::create_directories(directory.value(), ec);
+        if(ec) {
+            SPDLOG_WARN("Failed to create the decompression cache at {}", directory.value().string());
+            return;
+        }
     }
+
+    std::lock_guard<std::mutex> lock(gCachedChunksMutex);
+    gCacheDirectory = directory;
+}
+
+// Chunks still referenced by a DecompressedData are released when their last reference goes away
+void Decompressor::ClearCache() {
+    std::lock_guard<std::mutex> lock(gCachedChunksMutex);
     gCachedChunks.clear();
-}
\ No newline at end of file
+    gCacheDirectory = std::nullopt;
+}
+
+// Drops the chunks nobody else holds, they are read back from the disk cache or decoded again when needed
+void Decompressor::TrimCache() {
+    std::lock_guard<std::mutex> lock(gCachedChunksMutex);
+    std::erase_if(gCachedChunks, [](const auto& entry) {
+        return entry.second.use_count() == 1;
+    });
+}
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <span>
+#include <memory>
 #include <vector>
+#include <filesystem>
 #include <cstdint>
 #include <unordered_map>
 #include <yaml-cpp/yaml.h>
@@ -23,7 +26,7 @@ struct DataChunk {
 };
 
 struct DecompressedData {
-    DataChunk* root;
+    std::shared_ptr<DataChunk> root;
     DataChunk segment;
 
     LUS::BinaryReader GetReader() {
@@ -33,13 +36,20 @@ struct DecompressedData {
 
 class Decompressor {
 public:
-    static DataChunk* Decode(const std::vector<uint8_t>& buffer, uint32_t offset, CompressionType type, bool ignoreCache = false);
-    static DataChunk* DecodeTKMK00(const std::vector<uint8_t>& buffer, const uint32_t offset, const uint32_t size, const uint32_t alpha);
-    static DecompressedData AutoDecode(YAML::Node& node, std::vector<uint8_t>& buffer, std::optional<size_t> size = std::nullopt);
-    static DecompressedData AutoDecode(uint32_t offset, std::optional<size_t> size, std::vector<uint8_t>& buffer);
-    static CompressionType GetCompressionType(std::vector<uint8_t>& buffer, const uint32_t offset);
+    static std::shared_ptr<DataChunk> Decode(std::span<const uint8_t> buffer, uint32_t offset, CompressionType type, bool ignoreCache = false);
+    // Encoded payloads are cached by codec and content hash, so every exporter of the same data shares one encode
+    static std::shared_ptr<DataChunk> Encode(std::span<const uint8_t> data, CompressionType type);
+    // Size of the buffer the encoder may write to for an input of the given size
+    static size_t GetMaxEncodedSize(size_t size, CompressionType type);
+    static std::shared_ptr<DataChunk> DecodeTKMK00(std::span<const uint8_t> buffer, const uint32_t offset, const uint32_t size, const uint32_t alpha);
+    static DecompressedData AutoDecode(YAML::Node& node, std::span<uint8_t> buffer, std::optional<size_t> size = std::nullopt);
+    static DecompressedData AutoDecode(uint32_t offset, std::optional<size_t> size, std::span<uint8_t> buffer);
+    static CompressionType GetCompressionType(std::span<uint8_t> buffer, const uint32_t offset);
     static uint32_t TranslateAddr(uint32_t addr, bool baseAddress = false);
     static bool IsSegmented(uint32_t addr);
 
+    // Decoded chunks are also stored in this directory, it should be unique to the rom being extracted
+    static void SetCacheDirectory(const std::optional<std::filesystem::path>& directory);
     static void ClearCache();
-};
\ No newline at end of file
+    static void TrimCache();
+};
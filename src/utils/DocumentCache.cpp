@@ -0,0 +1,216 @@
+#include "DocumentCache.h"
+
+#include <fstream>
+#include <algorithm>
+#include "spdlog/spdlog.h"
+#include "Companion.h"
+#include "utils/MappedFile.h"
+#include "lib/binarytools/BinaryReader.h"
+#include "lib/binarytools/BinaryWriter.h"
+
+#define DOCUMENTS_MAGIC 0x54594D4C
+#define DOCUMENTS_VERSION 1
+
+static void WriteBuffer(LUS::BinaryWriter& writer, const std::string& str) {
+    writer.Write(static_cast<uint32_t>(str.size()));
+    writer.Write(const_cast<char*>(str.data()), str.size());
+}
+
+static std::string ReadBuffer(LUS::BinaryReader& reader) {
+    std::string str(reader.ReadUInt32(), '\0');
+    reader.Read(str.data(), static_cast<int32_t>(str.size()));
+    return str;
+}
+
+// Type, tag and style of every node followed by its scalar or children, maps store key/value pairs in order
+static void EncodeNode(LUS::BinaryWriter& writer, const YAML::Node& node) {
+    writer.Write(static_cast<uint8_t>(node.Type()));
+    WriteBuffer(writer, node.Tag());
+    writer.Write(static_cast<uint8_t>(node.Style()));
+
+    switch (node.Type()) {
+        case YAML::NodeType::Scalar:
+            WriteBuffer(writer, node.Scalar());
+            break;
+        case YAML::NodeType::Sequence:
+            writer.Write(static_cast<uint32_t>(node.size()));
+            for(const auto& child : node) {
+                EncodeNode(writer, child);
+            }
+            break;
+        case YAML::NodeType::Map:
+            writer.Write(static_cast<uint32_t>(node.size()));
+            for(auto it = node.begin(); it != node.end(); ++it) {
+                EncodeNode(writer, it->first);
+                EncodeNode(writer, it->second);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static YAML::Node DecodeNode(LUS::BinaryReader& reader) {
+    const auto type = static_cast<YAML::NodeType::value>(reader.ReadUByte());
+    const auto tag = ReadBuffer(reader);
+    const auto style = static_cast<YAML::EmitterStyle::value>(reader.ReadUByte());
+    YAML::Node node;
+
+    switch (type) {
+        case YAML::NodeType::Scalar:
+            node = YAML::Node(ReadBuffer(reader));
+            break;
+        case YAML::NodeType::Sequence: {
+            node = YAML::Node(YAML::NodeType::Sequence);
+            const auto count = reader.ReadUInt32();
+            for(uint32_t i = 0; i < count; i++) {
+                node.push_back(DecodeNode(reader));
+            }
+            break;
+        }
+        case YAML::NodeType::Map: {
+            node = YAML::Node(YAML::NodeType::Map);
+            const auto count = reader.ReadUInt32();
+            for(uint32_t i = 0; i < count; i++) {
+                auto key = DecodeNode(reader);
+                auto value = DecodeNode(reader);
+                // Keys were already unique in the source, so skip the lookup operator[] would do
+                node.force_insert(key, value);
+            }
+            break;
+        }
+        case YAML::NodeType::Null:
+            node = YAML::Node(YAML::NodeType::Null);
+            break;
+        default:
+            throw std::runtime_error("Invalid node type in compiled document");
+    }
+
+    node.SetTag(tag);
+    node.SetStyle(style);
+    return node;
+}
+
+DocumentCache::Document DocumentCache::Get(const std::filesystem::path& path) {
+    const auto key = path.lexically_normal().generic_string();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        if(const auto it = this->mDocuments.find(key); it != this->mDocuments.end()) {
+            return it->second;
+        }
+    }
+
+    const auto data = Torch::MappedFile::ReadAll(path);
+    Document document;
+    document.hash = Companion::CalculateHash(data);
+
+    std::string compiled;
+    bool decoded = false;
+    if(this->mUseCompiled) {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        if(const auto it = this->mCompiled.find(key); it != this->mCompiled.end() && it->second.first == document.hash) {
+            compiled = it->second.second;
+        }
+    }
+
+    if(!compiled.empty()) {
+        // A broken entry only costs a normal parse
+        try {
+            LUS::BinaryReader reader(compiled.data(), compiled.size());
+            reader.SetEndianness(Torch::Endianness::Big);
+            document.root = DecodeNode(reader);
+            decoded = true;
+        } catch (const std::exception& e) {
+            SPDLOG_WARN("Failed to read compiled document {}: {}", key, e.what());
+        }
+    }
+
+    if(!decoded) {
+        document.root = YAML::Load(std::string(data.begin(), data.end()));
+
+        // Aliases share one node between several keys, which the binary form can't express
+        if(this->mUseCompiled && std::find(data.begin(), data.end(), '*') == data.end()) {
+            LUS::BinaryWriter writer;
+            writer.SetEndianness(Torch::Endianness::Big);
+            EncodeNode(writer, document.root);
+            const auto buffer = writer.Release();
+            compiled.assign(buffer.begin(), buffer.end());
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    if(!compiled.empty()) {
+        this->mCompiled[key] = { document.hash, std::move(compiled) };
+    } else {
+        this->mCompiled.erase(key);
+    }
+    // Another thread may have loaded it first, every caller has to see the same nodes
+    return this->mDocuments.try_emplace(key, std::move(document)).first->second;
+}
+
+void DocumentCache::LoadCompiled(const std::filesystem::path& path) {
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    this->mUseCompiled = true;
+    this->mCompiled.clear();
+
+    if(!std::filesystem::exists(path)) {
+        return;
+    }
+
+    auto data = Torch::MappedFile::ReadAll(path);
+    LUS::BinaryReader reader(data.data(), data.size());
+    reader.SetEndianness(Torch::Endianness::Big);
+
+    try {
+        if(reader.ReadUInt32() != DOCUMENTS_MAGIC || reader.ReadUInt32() != DOCUMENTS_VERSION) {
+            SPDLOG_WARN("Ignoring outdated document cache {}", path.string());
+            return;
+        }
+
+        const auto count = reader.ReadUInt32();
+        for(uint32_t i = 0; i < count; i++) {
+            auto key = ReadBuffer(reader);
+            auto hash = ReadBuffer(reader);
+            auto compiled = ReadBuffer(reader);
+            this->mCompiled[key] = { std::move(hash), std::move(compiled) };
+        }
+    } catch (const std::exception& e) {
+        SPDLOG_WARN("Failed to read document cache {}: {}", path.string(), e.what());
+        this->mCompiled.clear();
+    }
+}
+
+void DocumentCache::SaveCompiled(const std::filesystem::path& path) {
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    if(!this->mUseCompiled) {
+        return;
+    }
+
+    LUS::BinaryWriter writer;
+    writer.SetEndianness(Torch::Endianness::Big);
+    writer.Write(static_cast<uint32_t>(DOCUMENTS_MAGIC));
+    writer.Write(static_cast<uint32_t>(DOCUMENTS_VERSION));
+
+    // Only the documents used by this run, so removed yamls don't linger
+    uint32_t count = 0;
+    for(const auto& [key, document] : this->mDocuments) {
+        count += this->mCompiled.contains(key);
+    }
+    writer.Write(count);
+
+    for(const auto& [key, document] : this->mDocuments) {
+        const auto it = this->mCompiled.find(key);
+        if(it == this->mCompiled.end()) {
+            continue;
+        }
+        WriteBuffer(writer, key);
+        WriteBuffer(writer, it->second.first);
+        WriteBuffer(writer, it->second.second);
+    }
+
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream file(path, std::ios::binary);
+    writer.Finish(file);
+    file.close();
+}
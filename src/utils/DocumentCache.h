@@ -0,0 +1,33 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <filesystem>
+#include <unordered_map>
+#include <yaml-cpp/yaml.h>
+
+/*
+ * Parsed yaml documents keyed by path, so every file is read and parsed once per run no
+ * matter how many paths ask for it. When a compiled cache is loaded, documents whose source
+ * did not change are rebuilt from their binary form instead of going through the yaml parser.
+ */
+class DocumentCache {
+public:
+    struct Document {
+        // SHA1 of the source file
+        std::string hash;
+        YAML::Node root;
+    };
+
+    // Documents share their nodes with every caller, edits made while processing are visible to all of them
+    Document Get(const std::filesystem::path& path);
+
+    void LoadCompiled(const std::filesystem::path& path);
+    void SaveCompiled(const std::filesystem::path& path);
+private:
+    std::mutex mMutex;
+    std::unordered_map<std::string, Document> mDocuments;
+    // Binary form of every document as it was parsed, before anyone edited it
+    std::unordered_map<std::string, std::pair<std::string, std::string>> mCompiled;
+    bool mUseCompiled = false;
+};
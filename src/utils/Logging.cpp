@@ -0,0 +1,127 @@
+#include "Logging.h"
+
+#include <exception>
+#include <algorithm>
+
+#ifdef STANDALONE
+#include "spdlog/async.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
+#endif
+
+#define PLAIN_PATTERN "[%Y-%m-%d %H:%M:%S.%e] [%l] %v"
+#define LINE_PATTERN  "[%Y-%m-%d %H:%M:%S.%e] [%l] > %v"
+#define ASYNC_QUEUE_SIZE 8192
+
+static std::shared_ptr<spdlog::logger> sPlain;
+static std::shared_ptr<spdlog::logger> sLine;
+static std::optional<spdlog::level::level_enum> sForcedLevel;
+
+#ifdef STANDALONE
+static std::terminate_handler sTerminate;
+
+static std::shared_ptr<spdlog::logger> CreateLogger(const std::string& name, const char* pattern, bool async) {
+    // Each logger needs its own sink since the pattern lives in the sink, console output is still serialized
+    auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+    std::shared_ptr<spdlog::logger> logger;
+#ifndef __EMSCRIPTEN__
+    if(async) {
+        // A single worker thread keeps the messages of both loggers in order
+        logger = std::make_shared<spdlog::async_logger>(name, sink, spdlog::thread_pool(), spdlog::async_overflow_policy::block);
+    } else
+#endif
+    {
+        logger = std::make_shared<spdlog::logger>(name, sink);
+    }
+    logger->set_pattern(pattern);
+    logger->flush_on(spdlog::level::warn);
+    spdlog::register_logger(logger);
+    return logger;
+}
+#endif
+
+void Torch::Logging::Init(spdlog::level::level_enum defaultLevel) {
+    const auto level = sForcedLevel.value_or(defaultLevel);
+
+    if(sPlain == nullptr) {
+#ifdef STANDALONE
+        // Debug and trace print a line per asset and command, formatting and writing them moves off the workers
+        const auto async = level <= spdlog::level::debug;
+#ifndef __EMSCRIPTEN__
+        if(async) {
+            spdlog::init_thread_pool(ASYNC_QUEUE_SIZE, 1);
+            // Drain the queue before a crash takes the process down
+            sTerminate = std::set_terminate([] {
+                spdlog::shutdown();
+                if(sTerminate != nullptr) {
+                    sTerminate();
+                }
+                std::abort();
+            });
+            std::atexit([] { spdlog::shutdown(); });
+        }
+#endif
+        sPlain = CreateLogger("torch", PLAIN_PATTERN, async);
+        sLine = CreateLogger("torch.line", LINE_PATTERN, async);
+#else
+        // Embedded builds print through the logger of the host application
+        sPlain = sLine = spdlog::default_logger();
+#endif
+    }
+
+    ApplyLevel(level);
+    UseLinePattern(false);
+}
+
+void Torch::Logging::ForceLevel(spdlog::level::level_enum level) {
+    sForcedLevel = level;
+    ApplyLevel(level);
+}
+
+void Torch::Logging::SetLevel(spdlog::level::level_enum level) {
+    if(!sForcedLevel.has_value()) {
+        ApplyLevel(level);
+    }
+}
+
+void Torch::Logging::ApplyLevel(spdlog::level::level_enum level) {
+    spdlog::set_level(level);
+    // Only the current default logger is guaranteed to be in spdlog's registry
+    for(const auto& logger : { sPlain, sLine }) {
+        if(logger != nullptr) {
+            logger->set_level(level);
+        }
+    }
+}
+
+std::optional<spdlog::level::level_enum> Torch::Logging::ParseLevel(const std::string& name) {
+    std::string upper = name;
+    std::transform(upper.begin(), upper.end(), upper.begin(), toupper);
+
+    if(upper == "TRACE") {
+        return spdlog::level::trace;
+    } else if(upper == "DEBUG") {
+        return spdlog::level::debug;
+    } else if(upper == "INFO") {
+        return spdlog::level::info;
+    } else if(upper == "WARN") {
+        return spdlog::level::warn;
+    } else if(upper == "ERROR") {
+        return spdlog::level::err;
+    } else if(upper == "CRITICAL") {
+        return spdlog::level::critical;
+    } else if(upper == "OFF") {
+        return spdlog::level::off;
+    }
+
+    return std::nullopt;
+}
+
+void Torch::Logging::UseLinePattern(bool enabled) {
+#ifdef STANDALONE
+    spdlog::set_default_logger(enabled ? sLine : sPlain);
+#endif
+}
+
+spdlog::logger* Torch::Logging::Plain() {
+    return sPlain != nullptr ? sPlain.get() : spdlog::default_logger_raw();
+}
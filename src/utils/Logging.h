@@ -0,0 +1,32 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include "spdlog/spdlog.h"
+
+namespace Torch {
+
+/*
+ * Owns the two loggers Torch prints through. The plain one is used for banners and startup
+ * output, the line one prefixes messages with "> " while assets are processed. Both are built
+ * once, so switching between them never rebuilds a formatter the way spdlog::set_pattern does.
+ */
+class Logging {
+public:
+    // Creates the loggers on first use and applies the default level unless one was forced
+    static void Init(spdlog::level::level_enum defaultLevel = spdlog::level::debug);
+    // Level requested on the command line, wins over the default and the config.yml one
+    static void ForceLevel(spdlog::level::level_enum level);
+    // Level from config.yml, ignored when one was forced
+    static void SetLevel(spdlog::level::level_enum level);
+    static std::optional<spdlog::level::level_enum> ParseLevel(const std::string& name);
+
+    // Makes the line logger the default one, SPDLOG_* macros print through it from then on
+    static void UseLinePattern(bool enabled);
+    // Banners go through SPDLOG_LOGGER_*(Torch::Logging::Plain(), ...)
+    static spdlog::logger* Plain();
+private:
+    static void ApplyLevel(spdlog::level::level_enum level);
+};
+
+}
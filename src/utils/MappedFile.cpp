@@ -0,0 +1,148 @@
+#include "MappedFile.h"
+
+#include <fstream>
+#include <stdexcept>
+#include "spdlog/spdlog.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+Torch::MappedFile::MappedFile(const std::filesystem::path& path) {
+    if(this->Map(path)) {
+        return;
+    }
+
+    SPDLOG_DEBUG("Could not map {}, reading it instead", path.string());
+    this->mBuffer = ReadAll(path);
+    this->mData = this->mBuffer;
+}
+
+Torch::MappedFile::MappedFile(std::vector<uint8_t> data) : mBuffer(std::move(data)) {
+    this->mData = this->mBuffer;
+}
+
+Torch::MappedFile::~MappedFile() {
+    this->Unmap();
+}
+
+Torch::MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+Torch::MappedFile& Torch::MappedFile::operator=(MappedFile&& other) noexcept {
+    if(this == &other) {
+        return *this;
+    }
+
+    this->Unmap();
+    this->mBuffer = std::move(other.mBuffer);
+    this->mMapping = other.mMapping;
+#ifdef _WIN32
+    this->mFileHandle = other.mFileHandle;
+    this->mMappingHandle = other.mMappingHandle;
+    other.mFileHandle = nullptr;
+    other.mMappingHandle = nullptr;
+#endif
+    this->mData = this->mMapping != nullptr ? other.mData : std::span<uint8_t>(this->mBuffer);
+    other.mMapping = nullptr;
+    other.mData = {};
+    return *this;
+}
+
+std::vector<uint8_t> Torch::MappedFile::ReadAll(const std::filesystem::path& path) {
+    std::ifstream input(path, std::ios::binary | std::ios::ate);
+    if(!input.is_open()) {
+        throw std::runtime_error("Failed to open " + path.string());
+    }
+
+    const auto size = static_cast<size_t>(input.tellg());
+    std::vector<uint8_t> data(size);
+    input.seekg(0, std::ios::beg);
+    input.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(size));
+    return data;
+}
+
+bool Torch::MappedFile::Map(const std::filesystem::path& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    // Copy on write, so consumers can keep treating the rom as writable memory
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if(mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    if(view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    this->mFileHandle = file;
+    this->mMappingHandle = mapping;
+    this->mMapping = view;
+    this->mData = std::span(static_cast<uint8_t*>(view), static_cast<size_t>(size.QuadPart));
+    return true;
+#elif !defined(__EMSCRIPTEN__)
+    const int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0) {
+        return false;
+    }
+
+    struct stat info {};
+    if(fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    // Copy on write, so consumers can keep treating the rom as writable memory
+    void* view = mmap(nullptr, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if(view == MAP_FAILED) {
+        return false;
+    }
+
+    this->mMapping = view;
+    this->mData = std::span(static_cast<uint8_t*>(view), static_cast<size_t>(info.st_size));
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Torch::MappedFile::Unmap() {
+    if(this->mMapping == nullptr) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(this->mMapping);
+    CloseHandle(this->mMappingHandle);
+    CloseHandle(this->mFileHandle);
+    this->mMappingHandle = nullptr;
+    this->mFileHandle = nullptr;
+#elif !defined(__EMSCRIPTEN__)
+    munmap(this->mMapping, this->mData.size());
+#endif
+    this->mMapping = nullptr;
+    this->mData = {};
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+
+namespace Torch {
+
+/*
+ * Read-only view of a whole file, memory mapped when the platform allows it and
+ * read into memory otherwise. It can also own an in-memory buffer (e.g. a ROM
+ * handed over by the web build or produced by a preprocess step).
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path& path);
+    explicit MappedFile(std::vector<uint8_t> data);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    std::span<uint8_t> GetData() { return this->mData; }
+    size_t GetSize() const { return this->mData.size(); }
+    bool IsMapped() const { return this->mMapping != nullptr; }
+
+    static std::vector<uint8_t> ReadAll(const std::filesystem::path& path);
+private:
+    std::span<uint8_t> mData;
+    std::vector<uint8_t> mBuffer;
+    void* mMapping = nullptr;
+#ifdef _WIN32
+    void* mFileHandle = nullptr;
+    void* mMappingHandle = nullptr;
+#endif
+
+    bool Map(const std::filesystem::path& path);
+    void Unmap();
+};
+
+}
@@ -0,0 +1,56 @@
+#include "TextWriter.h"
+
+#include <array>
+#include <algorithm>
+
+namespace Torch {
+
+static constexpr auto sHexPairs = [] {
+    constexpr char digits[] = "0123456789abcdef";
+    std::array<char, 512> table {};
+    for(size_t i = 0; i < 256; i++) {
+        table[i * 2] = digits[i >> 4];
+        table[i * 2 + 1] = digits[i & 0xF];
+    }
+    return table;
+}();
+
+TextWriter& TextWriter::HexByte(const uint8_t value) {
+    this->mBuffer.append(&sHexPairs[value * 2], 2);
+    return *this;
+}
+
+TextWriter& TextWriter::Repeat(const std::string_view text, const size_t count) {
+    this->mBuffer.reserve(this->mBuffer.size() + text.size() * count);
+    for(size_t i = 0; i < count; i++) {
+        this->mBuffer.append(text);
+    }
+    return *this;
+}
+
+TextWriter& TextWriter::HexArray(const std::span<const uint8_t> data, const size_t wordSize, const size_t lineBytes, const std::string_view lineBreak) {
+    // "0x" + two digits per byte + ", " for every word
+    this->mBuffer.reserve(this->mBuffer.size() + data.size() * 2 + (data.size() / wordSize + 1) * (4 + lineBreak.size()));
+
+    for(size_t i = 0; i < data.size(); i += wordSize) {
+        if(i % lineBytes == 0 && i != 0) {
+            this->mBuffer.append(lineBreak);
+        }
+
+        this->mBuffer.append("0x");
+        const auto end = std::min(i + wordSize, data.size());
+        for(size_t j = i; j < end; j++) {
+            this->mBuffer.append(&sHexPairs[data[j] * 2], 2);
+        }
+        this->mBuffer.append(", ");
+    }
+
+    return *this;
+}
+
+void TextWriter::Flush(std::ostream& out) {
+    out.write(this->mBuffer.data(), static_cast<std::streamsize>(this->mBuffer.size()));
+    this->mBuffer.clear();
+}
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <ostream>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <string_view>
+
+namespace Torch {
+
+/*
+ * Growable text buffer for the code exporters. Numbers are formatted straight into the
+ * buffer through a lookup table or std::to_chars instead of iostream manipulators, and the
+ * result is handed to the output stream in one write. Every helper matches the text the
+ * equivalent iostream formatting produced.
+ */
+class TextWriter {
+public:
+    explicit TextWriter(size_t reserve = 0) {
+        this->mBuffer.reserve(reserve);
+    }
+
+    TextWriter& operator<<(std::string_view text) {
+        this->mBuffer.append(text);
+        return *this;
+    }
+
+    TextWriter& operator<<(char c) {
+        this->mBuffer.push_back(c);
+        return *this;
+    }
+
+    // std::hex << std::setw(2) << std::setfill('0')
+    TextWriter& HexByte(uint8_t value);
+
+    // std::dec << std::setfill(' ') << std::setw(width)
+    template<std::integral T>
+    TextWriter& Dec(T value, size_t width = 0) {
+        char digits[24];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        const auto length = static_cast<size_t>(result.ptr - digits);
+        if(length < width) {
+            this->mBuffer.append(width - length, ' ');
+        }
+        this->mBuffer.append(digits, length);
+        return *this;
+    }
+
+    TextWriter& Repeat(std::string_view text, size_t count);
+
+    // "0x" followed by wordSize hex bytes and ", " per word, breaking the line before every lineBytes bytes
+    TextWriter& HexArray(std::span<const uint8_t> data, size_t wordSize, size_t lineBytes, std::string_view lineBreak);
+
+    const std::string& str() const { return this->mBuffer; }
+
+    // Writes the buffered text and starts over
+    void Flush(std::ostream& out);
+private:
+    std::string mBuffer;
+};
+
+}
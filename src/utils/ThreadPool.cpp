@@ -0,0 +1,45 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+Torch::ThreadPool::ThreadPool(size_t workers) {
+    workers = std::max<size_t>(1, workers);
+    for(size_t i = 0; i < workers; i++) {
+        this->mWorkers.emplace_back([this] { this->Run(); });
+    }
+}
+
+Torch::ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mStopping = true;
+    }
+    this->mCondition.notify_all();
+
+    for(auto& worker : this->mWorkers) {
+        worker.join();
+    }
+}
+
+size_t Torch::ThreadPool::DefaultSize() {
+    const auto cores = std::thread::hardware_concurrency();
+    return cores == 0 ? 1 : cores;
+}
+
+void Torch::ThreadPool::Run() {
+    while(true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(this->mMutex);
+            this->mCondition.wait(lock, [this] { return this->mStopping || !this->mJobs.empty(); });
+
+            if(this->mJobs.empty()) {
+                return;
+            }
+
+            job = std::move(this->mJobs.front());
+            this->mJobs.pop();
+        }
+        job();
+    }
+}
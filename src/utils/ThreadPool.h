@@ -0,0 +1,47 @@
+#pragma once
+
+#include <mutex>
+#include <queue>
+#include <vector>
+#include <thread>
+#include <future>
+#include <cstdint>
+#include <functional>
+#include <condition_variable>
+
+namespace Torch {
+
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t workers = DefaultSize());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template<typename F>
+    std::future<std::invoke_result_t<F>> Submit(F&& job) {
+        using R = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(job));
+        auto future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(this->mMutex);
+            this->mJobs.emplace([task] { (*task)(); });
+        }
+        this->mCondition.notify_one();
+        return future;
+    }
+
+    size_t GetSize() const { return this->mWorkers.size(); }
+    static size_t DefaultSize();
+private:
+    std::vector<std::thread> mWorkers;
+    std::queue<std::function<void()>> mJobs;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mStopping = false;
+
+    void Run();
+};
+
+}
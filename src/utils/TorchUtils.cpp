@@ -5,6 +5,14 @@
 #include <factories/BaseFactory.h>
 #include "spdlog/spdlog.h"
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <sys/resource.h>
+#endif
+
 namespace fs = std::filesystem;
 
 uint32_t Torch::translate(const uint32_t offset) {
@@ -35,4 +43,27 @@ std::vector<fs::directory_entry> Torch::getRecursiveEntries(const fs::path baseD
 
     std::vector<fs::directory_entry> sortedEntries(result.begin(), result.end());
     return sortedEntries;
-}
\ No newline at end of file
+}
+
+size_t Torch::getPeakMemoryUsage() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#elif defined(__EMSCRIPTEN__)
+    return 0;
+#else
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss;
+#else
+    // Linux reports kilobytes
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
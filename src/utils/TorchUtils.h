@@ -26,5 +26,7 @@ std::string to_hex(T number, const bool append0x = true) {
 
 uint32_t translate(uint32_t offset);
 std::vector<std::filesystem::directory_entry> getRecursiveEntries(const std::filesystem::path baseDir);
+// Peak resident memory of the process in bytes, 0 when the platform can't tell
+size_t getPeakMemoryUsage();
 
 };
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "utils/Decompressor.h"
+
+// Random bytes leave nothing to compress, so the control bits and their padding are as large as
+// they get. Build with ENABLE_ASAN to also catch writes past the encode buffer.
+
+static uint32_t sSeed = 0x64;
+
+static uint8_t NextByte() {
+    sSeed = sSeed * 1103515245 + 12345;
+    return sSeed >> 16;
+}
+
+static bool CheckRoundTrip(const CompressionType type, const char* codec, const std::vector<uint8_t>& data) {
+    const auto size = data.size();
+    const auto encoded = Decompressor::Encode(data, type);
+    const auto limit = Decompressor::GetMaxEncodedSize(size, type);
+    if(encoded->size > limit) {
+        printf("%s: %zu bytes encoded to %zu, over the %zu byte buffer\n", codec, size, encoded->size, limit);
+        return false;
+    }
+
+    const auto decoded = Decompressor::Decode(std::span(encoded->data, encoded->size), 0, type, true);
+    if(decoded->size != size || memcmp(decoded->data, data.data(), size) != 0) {
+        printf("%s: %zu bytes did not survive a round trip\n", codec, size);
+        return false;
+    }
+
+    return true;
+}
+
+static std::vector<uint8_t> RandomData(const size_t size) {
+    std::vector<uint8_t> data(size);
+    for(auto& byte : data) {
+        byte = NextByte();
+    }
+    return data;
+}
+
+// Copies of every length up to past the longest match the codecs can store
+static std::vector<uint8_t> RepeatingData() {
+    auto data = RandomData(64);
+    for(size_t length = 3; length <= 300; length++) {
+        const size_t distance = 1 + NextByte() % 64;
+        for(size_t i = 0; i < length; i++) {
+            data.push_back(data[data.size() - distance]);
+        }
+        data.push_back(NextByte());
+    }
+    return data;
+}
+
+int main() {
+    const std::pair<CompressionType, const char*> codecs[] = {
+        { CompressionType::MIO0, "mio0" },
+        { CompressionType::YAY0, "yay0" },
+        { CompressionType::YAY1, "yay1" },
+    };
+
+    bool passed = true;
+    for(const auto& [type, codec] : codecs) {
+        // Every remainder of the control bits against the 4 byte alignment
+        for(size_t size = 1; size <= 256; size++) {
+            passed &= CheckRoundTrip(type, codec, RandomData(size));
+        }
+        passed &= CheckRoundTrip(type, codec, RandomData(0x10001));
+        passed &= CheckRoundTrip(type, codec, RepeatingData());
+    }
+
+    printf("%s\n", passed ? "Decompressor: passed" : "Decompressor: failed");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <vector>
+#include <filesystem>
+#include "Companion.h"
+
+namespace fs = std::filesystem;
+
+// A display list points into the middle of a vtx that grows an overlapping one once its count is edited,
+// the incremental run has to regenerate the display list just like a clean one would.
+
+#define VTX_A_OFFSET 0x1000
+#define VTX_B_OFFSET 0x1040
+#define GFX_OFFSET 0x1100
+#define ROM_SIZE 0x2000
+
+static void WriteBE32(std::vector<uint8_t>& rom, const size_t offset, const uint32_t value) {
+    rom[offset + 0] = value >> 24;
+    rom[offset + 1] = value >> 16;
+    rom[offset + 2] = value >> 8;
+    rom[offset + 3] = value;
+}
+
+static std::vector<uint8_t> BuildRom() {
+    std::vector<uint8_t> rom(ROM_SIZE);
+    const char title[] = "TORCH INCREMENTAL";
+    std::copy(title, title + sizeof(title), rom.begin() + 0x20);
+    rom[0x3E] = 'E';
+
+    for(size_t i = VTX_A_OFFSET; i < VTX_A_OFFSET + 8 * 0x10; i++) {
+        rom[i] = i * 7;
+    }
+
+    // F3DEX2 gsSPVertex(0x1050, 2, 0) followed by gsSPEndDisplayList()
+    WriteBE32(rom, GFX_OFFSET + 0x0, 0x01002004);
+    WriteBE32(rom, GFX_OFFSET + 0x4, 0x1050);
+    WriteBE32(rom, GFX_OFFSET + 0x8, 0xDF000000);
+    WriteBE32(rom, GFX_OFFSET + 0xC, 0x00000000);
+    return rom;
+}
+
+static void WriteFile(const fs::path& path, const std::string& data) {
+    create_directories(path.parent_path());
+    std::ofstream file(path, std::ios::binary);
+    file << data;
+}
+
+static void WriteAssets(const fs::path& srcDir, const uint32_t count) {
+    std::ostringstream yaml;
+    yaml << "vtx_a:\n  type: VTX\n  offset: 0x" << std::hex << VTX_A_OFFSET << "\n  symbol: vtx_a\n  count: " << std::dec << count << "\n";
+    yaml << "vtx_b:\n  type: VTX\n  offset: 0x" << std::hex << VTX_B_OFFSET << "\n  symbol: vtx_b\n  count: 4\n";
+    yaml << "dl:\n  type: GFX\n  offset: 0x" << std::hex << GFX_OFFSET << "\n  symbol: dl\n";
+    WriteFile(srcDir / "assets" / "test.yml", yaml.str());
+}
+
+static std::map<std::string, std::string> Run(const std::vector<uint8_t>& rom, const fs::path& srcDir, const fs::path& destDir) {
+    Companion::Instance = new Companion(rom, ArchiveType::None, false, srcDir.string(), destDir.string());
+    Companion::Instance->Init(ExportType::Code);
+    Companion::Instance->Process();
+
+    std::map<std::string, std::string> outputs;
+    for(auto& entry : fs::recursive_directory_iterator(destDir / "code")) {
+        if(!entry.is_regular_file()) {
+            continue;
+        }
+
+        std::ifstream file(entry.path(), std::ios::binary);
+        std::ostringstream data;
+        data << file.rdbuf();
+        outputs[relative(entry.path(), destDir).string()] = data.str();
+    }
+    return outputs;
+}
+
+int main() {
+    const auto root = fs::temp_directory_path() / "torch_incremental_test";
+    const auto srcDir = root / "src";
+    remove_all(root);
+
+    const auto rom = BuildRom();
+    const auto hash = Companion::CalculateHash(rom);
+    WriteFile(srcDir / "config.yml", hash + ":\n  name: Incremental\n  path: assets\n  config:\n    gbi: F3DEX2\n    sort: OFFSET\n    output:\n      code: code\n");
+
+    WriteAssets(srcDir, 4);
+    const auto before = Run(rom, srcDir, root / "incremental");
+
+    WriteAssets(srcDir, 8);
+    const auto incremental = Run(rom, srcDir, root / "incremental");
+    const auto clean = Run(rom, srcDir, root / "clean");
+
+    bool passed = !clean.empty() && before != clean;
+    if(incremental != clean) {
+        for(auto& [path, data] : clean) {
+            const auto entry = incremental.find(path);
+            if(entry == incremental.end() || entry->second != data) {
+                printf("%s differs from a clean run\n", path.c_str());
+            }
+        }
+        passed = false;
+    }
+
+    remove_all(root);
+    printf("%s\n", passed ? "Incremental: passed" : "Incremental: failed");
+    return passed ? 0 : 1;
+}
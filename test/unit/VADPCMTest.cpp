@@ -0,0 +1,268 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "factories/naudio/v0/VADPCM.h"
+
+// The scalar codec the vectorized one replaced, kept as the reference this test compares against.
+// Products are summed as unsigned so overflow wraps like it did on every platform the old code ran on.
+// Chaining frames also compares the state carried between them.
+
+namespace reference {
+
+int16_t clamp_to_s16(int32_t x) {
+    if (x < -0x8000) return -0x8000;
+    if (x > 0x7fff) return 0x7fff;
+    return (int16_t) x;
+}
+
+int16_t qsample(int32_t x, int32_t scale) {
+    // Compute x / 2^scale rounded to the nearest integer, breaking ties towards zero.
+    if (scale == 0) return x;
+    return (x + (1 << (scale - 1)) - (x > 0)) >> scale;
+}
+
+using Table = std::vector<std::vector<std::vector<int32_t>>>;
+
+Table build_table(const std::vector<int16_t>& codebook, int32_t order, int32_t npredictors) {
+    Table table(npredictors, std::vector<std::vector<int32_t>>(8, std::vector<int32_t>(order + 8, 0)));
+
+    for (int32_t i = 0; i < npredictors; i++) {
+        auto& entry = table[i];
+        for (int32_t j = 0; j < order; j++) {
+            for (int32_t k = 0; k < 8; k++) {
+                entry[k][j] = codebook[(i * order + j) * 8 + k];
+            }
+        }
+
+        for (int32_t k = 1; k < 8; k++) {
+            entry[k][order] = entry[k - 1][order - 1];
+        }
+
+        entry[0][order] = 1 << 11;
+
+        for (int32_t k = 1; k < 8; k++) {
+            int32_t j = 0;
+            for (; j < k; j++) {
+                entry[j][k + order] = 0;
+            }
+
+            for (; j < 8; j++) {
+                entry[j][k + order] = entry[j - k][order];
+            }
+        }
+    }
+
+    return table;
+}
+
+int32_t inner_product(int32_t length, const int32_t* v1, const int32_t* v2) {
+    uint32_t sum = 0;
+    for (int32_t i = 0; i < length; i++) {
+        sum += static_cast<uint32_t>(v1[i]) * static_cast<uint32_t>(v2[i]);
+    }
+
+    // Compute "out / 2^11", rounded down.
+    const auto out = static_cast<int32_t>(sum);
+    const int32_t dout = out / (1 << 11);
+    const int32_t fiout = dout * (1 << 11);
+    return dout - (out - fiout < 0);
+}
+
+void decode_frame(const uint8_t* frame, int32_t* state, int32_t order, const Table& coefTable) {
+    int32_t ix[16];
+
+    const uint8_t header = frame[0];
+    const int32_t scale = 1 << (header >> 4);
+    const int32_t optimalp = header & 0xf;
+
+    for (int32_t i = 0; i < 16; i += 2) {
+        const uint8_t c = frame[1 + i / 2];
+        ix[i] = c >> 4;
+        ix[i + 1] = c & 0xf;
+    }
+
+    for (int32_t i = 0; i < 16; i++) {
+        if (ix[i] >= 8) ix[i] -= 16;
+        ix[i] *= scale;
+    }
+
+    for (int32_t j = 0; j < 2; j++) {
+        int32_t in_vec[16];
+        for (int32_t i = 0; i < order; i++) {
+            in_vec[i] = j == 0 ? state[16 - order + i] : state[8 - order + i];
+        }
+
+        for (int32_t i = 0; i < 8; i++) {
+            const int32_t ind = j * 8 + i;
+            in_vec[order + i] = ix[ind];
+            state[ind] = inner_product(order + i, coefTable[optimalp][i].data(), in_vec) + ix[ind];
+        }
+    }
+}
+
+void encode_frame(uint8_t* out, const int16_t* inBuffer, int32_t* state, const Table& coefTable, int32_t order, int32_t npredictors) {
+    int16_t ix[16];
+    int32_t prediction[16];
+    int32_t inVector[16];
+    int32_t saveState[16];
+    int32_t optimalp = 0;
+    int32_t scale;
+    int32_t ie[16];
+    int32_t e[16];
+    float min = 1e30;
+
+    for (int32_t k = 0; k < npredictors; k++) {
+        for (int32_t j = 0; j < 2; j++) {
+            for (int32_t i = 0; i < order; i++) {
+                inVector[i] = j == 0 ? state[16 - order + i] : inBuffer[8 - order + i];
+            }
+
+            for (int32_t i = 0; i < 8; i++) {
+                prediction[j * 8 + i] = inner_product(order + i, coefTable[k][i].data(), inVector);
+                e[j * 8 + i] = inVector[i + order] = inBuffer[j * 8 + i] - prediction[j * 8 + i];
+            }
+        }
+
+        float se = 0.0f;
+        for (int32_t j = 0; j < 16; j++) {
+            se += (float) e[j] * (float) e[j];
+        }
+
+        if (se < min) {
+            min = se;
+            optimalp = k;
+        }
+    }
+
+    for (int32_t j = 0; j < 2; j++) {
+        for (int32_t i = 0; i < order; i++) {
+            inVector[i] = j == 0 ? state[16 - order + i] : inBuffer[8 - order + i];
+        }
+
+        for (int32_t i = 0; i < 8; i++) {
+            prediction[j * 8 + i] = inner_product(order + i, coefTable[optimalp][i].data(), inVector);
+            e[j * 8 + i] = inVector[i + order] = inBuffer[j * 8 + i] - prediction[j * 8 + i];
+        }
+    }
+
+    for (int32_t i = 0; i < 16; i++) {
+        ie[i] = clamp_to_s16(e[i]);
+    }
+
+    int32_t max = 0;
+    for (int32_t i = 0; i < 16; i++) {
+        if (abs(ie[i]) > abs(max)) {
+            max = ie[i];
+        }
+    }
+
+    for (scale = 0; scale <= 12; scale++) {
+        if (max <= 7 && max >= -8) break;
+        max /= 2;
+    }
+
+    for (int32_t i = 0; i < 16; i++) {
+        saveState[i] = state[i];
+    }
+
+    for (int32_t nIter = 0, again = 1; nIter < 2 && again; nIter++) {
+        again = 0;
+        if (nIter == 1) scale++;
+        if (scale > 12) {
+            scale = 12;
+        }
+
+        for (int32_t j = 0; j < 2; j++) {
+            const int32_t base = j * 8;
+            for (int32_t i = 0; i < order; i++) {
+                inVector[i] = j == 0 ? saveState[16 - order + i] : state[8 - order + i];
+            }
+
+            for (int32_t i = 0; i < 8; i++) {
+                prediction[base + i] = inner_product(order + i, coefTable[optimalp][i].data(), inVector);
+                const int32_t se = inBuffer[base + i] - prediction[base + i];
+                ix[base + i] = qsample(se, scale);
+                const int32_t cV = clamp_to_s16(ix[base + i]) - ix[base + i];
+                if (cV > 1 || cV < -1) again = 1;
+                ix[base + i] += cV;
+                inVector[i + order] = ix[base + i] * (1 << scale);
+                state[base + i] = prediction[base + i] + inVector[i + order];
+            }
+        }
+    }
+
+    out[0] = (scale << 4) | (optimalp & 0xf);
+    for (int32_t i = 0; i < 16; i += 2) {
+        out[1 + i / 2] = ((ix[i] & 0xf) << 4) | (ix[i + 1] & 0xf);
+    }
+}
+
+}
+
+static bool CheckRandomBooks(uint32_t seed, size_t rounds) {
+    constexpr size_t Frames = 8;
+    std::mt19937 rng(seed);
+    const auto next = [&](int32_t min, int32_t max) {
+        return std::uniform_int_distribution<int32_t>(min, max)(rng);
+    };
+
+    for (size_t round = 0; round < rounds; round++) {
+        const int32_t order = next(1, VADPCMBook::Columns - VADPCMBook::Rows);
+        const int32_t npredictors = next(1, 16);
+        // Real books stay well inside the 16 bit range, keep most rounds there so states don't saturate
+        const int32_t range = round % 4 == 0 ? 0x7FFF : 0x1000;
+
+        std::vector<int16_t> codebook(order * npredictors * VADPCMBook::Rows);
+        for (auto& coef : codebook) {
+            coef = static_cast<int16_t>(next(-range, range));
+        }
+
+        const auto book = VADPCMBook::FromCodebook(codebook, order, npredictors);
+        const auto table = reference::build_table(codebook, order, npredictors);
+
+        int32_t state[VADPCM_FRAME_SAMPLES] = {};
+        int32_t expectedState[VADPCM_FRAME_SAMPLES] = {};
+        for (size_t f = 0; f < Frames; f++) {
+            uint8_t frame[VADPCM_FRAME_SIZE];
+            frame[0] = static_cast<uint8_t>((next(0, 12) << 4) | next(0, npredictors - 1));
+            for (int32_t i = 1; i < VADPCM_FRAME_SIZE; i++) {
+                frame[i] = static_cast<uint8_t>(next(0, 0xFF));
+            }
+
+            vadpcm_decode_frame(book, frame, state);
+            reference::decode_frame(frame, expectedState, order, table);
+            if (std::memcmp(state, expectedState, sizeof(state)) != 0) {
+                printf("decode mismatch on round %zu frame %zu (order %d, %d predictors)\n", round, f, order, npredictors);
+                return false;
+            }
+        }
+
+        std::fill(std::begin(state), std::end(state), 0);
+        std::fill(std::begin(expectedState), std::end(expectedState), 0);
+        for (size_t f = 0; f < Frames; f++) {
+            int16_t samples[VADPCM_FRAME_SAMPLES];
+            for (auto& sample : samples) {
+                sample = static_cast<int16_t>(next(-0x8000, 0x7FFF) >> next(0, 8));
+            }
+
+            uint8_t encoded[VADPCM_FRAME_SIZE];
+            uint8_t expected[VADPCM_FRAME_SIZE];
+            vadpcm_encode_frame(book, encoded, samples, state);
+            reference::encode_frame(expected, samples, expectedState, table, order, npredictors);
+            if (std::memcmp(encoded, expected, sizeof(encoded)) != 0 || std::memcmp(state, expectedState, sizeof(state)) != 0) {
+                printf("encode mismatch on round %zu frame %zu (order %d, %d predictors)\n", round, f, order, npredictors);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+int main() {
+    const bool passed = CheckRandomBooks(0, 1000);
+    printf("%s\n", passed ? "VADPCM: passed" : "VADPCM: failed");
+    return passed ? 0 : 1;
+}